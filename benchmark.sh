@@ -1,26 +1,51 @@
 #!/bin/bash
 # HHOA-FSSP Benchmark Script
+#
+# Usage: ./benchmark.sh [build_dir] [Google Benchmark flags...]
+#   build_dir defaults to ./build next to this script, e.g.
+#   ./benchmark.sh build --benchmark_filter=BM_Solution --benchmark_out=bench.json
+
+set -e
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+BUILD_DIR="${1:-$SCRIPT_DIR/build}"
+shift || true
+
+if [ ! -x "$BUILD_DIR/bin/hhoa_fssp" ]; then
+    echo "hhoa_fssp not found in $BUILD_DIR/bin (build the project first)" >&2
+    exit 1
+fi
 
 echo "============================================"
 echo "    HHOA-FSSP Benchmark Results"
 echo "============================================"
 echo ""
 
-cd /home/securdrgorp/Documents/MST/S2/MetHeuristique/HHOA-FSSP/build
-
-echo "Testing Default Instance (10x10):"
-echo "--------------------------------"
-./bin/hhoa_fssp --iterations 100
-echo ""
+cd "$BUILD_DIR"
 
 echo "Running Unit Tests:"
 echo "------------------"
 ./bin/hhoa_fssp_tests
 echo ""
 
-echo "Testing with smaller iteration count:"
-echo "------------------------------------"
-./bin/hhoa_fssp --iterations 50
+if [ -x ./bin/hhoa_fssp_bench ]; then
+    echo "Microbenchmarks:"
+    echo "---------------"
+    ./bin/hhoa_fssp_bench "$@"
+    echo ""
+else
+    echo "hhoa_fssp_bench not built (Google Benchmark not found), skipping microbenchmarks"
+    echo ""
+fi
+
+echo "Testing Instance test_20x5 (seeded, 100 iterations):"
+echo "---------------------------------------------------"
+./bin/hhoa_fssp -f "$SCRIPT_DIR/data/instances/test_20x5.txt" -i 100 -s 42
+echo ""
+
+echo "Testing Random Instance 50x10 (seeded, 50 iterations):"
+echo "-----------------------------------------------------"
+./bin/hhoa_fssp -j 50 -m 10 -i 50 -s 42
 echo ""
 
 echo "Project Summary:"
@@ -0,0 +1,40 @@
+#include "core/ProblemInstance.h"
+#include "utils/Random.h"
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <string>
+
+// Instance loading: text parsing against the memory-mapped binary format.
+// Arguments: {jobs, machines, binary (1) or text (0)}.
+
+namespace {
+std::string instanceFile(const benchmark::State& state) {
+    std::string name = "hhoa_bench_" + std::to_string(state.range(0)) + "x" + std::to_string(state.range(1)) +
+                       (state.range(2) ? ".bin" : ".txt");
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+
+void loadArguments(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"n", "m", "binary"});
+    for (auto size : {std::pair<int, int>{500, 20}, std::pair<int, int>{5000, 50}}) {
+        for (int binary : {0, 1}) {
+            bench->Args({size.first, size.second, binary});
+        }
+    }
+}
+}
+
+static void BM_ProblemInstanceLoad(benchmark::State& state) {
+    Random::getInstance().setSeed(42);
+    auto instance = ProblemInstance::generateRandom(state.range(0), state.range(1), 1, 100);
+    std::string filename = instanceFile(state);
+    instance->saveToFile(filename, state.range(2) ? InstanceFormat::BINARY : InstanceFormat::TEXT);
+    
+    for (auto _ : state) {
+        auto loaded = ProblemInstance::loadFromFile(filename);
+        benchmark::DoNotOptimize(loaded->getJobTimes(0));
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0) * state.range(1));
+    std::filesystem::remove(filename);
+}
+BENCHMARK(BM_ProblemInstanceLoad)->Apply(loadArguments)->Unit(benchmark::kMicrosecond);
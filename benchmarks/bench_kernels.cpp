@@ -0,0 +1,91 @@
+#include "core/MakespanKernels.h"
+#include "core/InsertionEvaluator.h"
+#include "core/ProblemInstance.h"
+#include "utils/Random.h"
+#include <benchmark/benchmark.h>
+#include <numeric>
+#include <vector>
+
+// Machine-count specialized kernels against the generic runtime-m kernels.
+// Arguments: {jobs, machines, specialized (1) or generic (0)}.
+
+namespace {
+const MakespanKernels& kernelsFor(const benchmark::State& state) {
+    int num_machines = state.range(1);
+    return state.range(2) ? MakespanKernels::select(num_machines) : MakespanKernels::generic();
+}
+
+std::vector<int> randomSequence(int num_jobs) {
+    std::vector<int> sequence(num_jobs);
+    std::iota(sequence.begin(), sequence.end(), 0);
+    Random::getInstance().shuffle(sequence);
+    return sequence;
+}
+
+void kernelArguments(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"n", "m", "specialized"});
+    for (int num_machines : {5, 10, 20}) {
+        for (int specialized : {0, 1}) {
+            bench->Args({100, num_machines, specialized});
+        }
+    }
+}
+}
+
+static void BM_KernelMakespan(benchmark::State& state) {
+    Random::getInstance().setSeed(42);
+    auto instance = ProblemInstance::generateRandom(state.range(0), state.range(1), 1, 100);
+    const MakespanKernels& kernels = kernelsFor(state);
+    std::vector<int> sequence = randomSequence(instance->getNumJobs());
+    
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(kernels.makespan(*instance, sequence.data(), sequence.size()));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_KernelMakespan)->Apply(kernelArguments);
+
+static void BM_KernelInsertionSweep(benchmark::State& state) {
+    Random::getInstance().setSeed(42);
+    auto instance = ProblemInstance::generateRandom(state.range(0), state.range(1), 1, 100);
+    const MakespanKernels& kernels = kernelsFor(state);
+    std::vector<int> sequence = randomSequence(instance->getNumJobs());
+    int job = sequence.back();
+    sequence.pop_back();
+    
+    int count = sequence.size();
+    int num_machines = instance->getNumMachines();
+    std::vector<int> heads((count + 1) * num_machines);
+    std::vector<int> tails((count + 1) * num_machines);
+    std::vector<int> makespans(count + 1);
+    
+    // One full Taillard sweep: heads, tails and every insertion position
+    for (auto _ : state) {
+        kernels.build_heads(*instance, sequence.data(), count, heads.data());
+        kernels.build_tails(*instance, sequence.data(), count, tails.data());
+        benchmark::DoNotOptimize(kernels.insertion_sweep(*instance, heads.data(), tails.data(),
+                                                         job, count, makespans.data()));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_KernelInsertionSweep)->Apply(kernelArguments);
+
+// One insertion sweep per objective (the makespan kernels, flowtime, SDST, no-wait).
+// Arguments: {jobs, machines, ObjectiveType}.
+static void BM_ObjectiveInsertionSweep(benchmark::State& state) {
+    Random::getInstance().setSeed(42);
+    auto instance = ProblemInstance::generateRandom(state.range(0), state.range(1), 1, 100);
+    instance->generateRandomSetupTimes(1, 99);
+    instance->setObjective(static_cast<ObjectiveType>(state.range(2)));
+    InsertionEvaluator evaluator(instance);
+    std::vector<int> sequence = randomSequence(instance->getNumJobs());
+    int job = sequence.back();
+    sequence.pop_back();
+    std::vector<int> values;
+    
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(evaluator.evaluateInsertions(sequence, job, values));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ObjectiveInsertionSweep)->ArgNames({"n", "m", "objective"})->ArgsProduct({{100}, {10}, {0, 1, 2, 3}});
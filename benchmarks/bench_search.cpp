@@ -0,0 +1,198 @@
+#include "algorithm/HHOA.h"
+#include "algorithm/HorseHerd.h"
+#include "algorithm/Horse.h"
+#include "core/ProblemInstance.h"
+#include "core/Solution.h"
+#include "utils/Logger.h"
+#include "utils/Random.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+
+// Microbenchmarks of the hot paths over instance sizes from 20x5 to 500x20.
+// Arguments: {jobs, machines}. Every benchmark reseeds the generator, so runs
+// of the same binary measure the same instances and starting solutions.
+
+/**
+ * @brief Access to single HHOA iterations for the microbenchmarks
+ */
+struct HHOABenchmark {
+    static void initialize(HHOA& hhoa) { hhoa.initialize(); }
+    static bool executeIteration(HHOA& hhoa, int iteration) { return hhoa.executeIteration(iteration); }
+};
+
+/**
+ * @brief Access to the crossover operators for the microbenchmarks
+ */
+struct HorseBenchmark {
+    static void orderCrossover(const Horse& horse, const Solution& parent1, const Solution& parent2, Solution& result) {
+        horse.orderCrossover(parent1, parent2, result);
+    }
+    static void partiallyMappedCrossover(const Horse& horse, const Solution& parent1, const Solution& parent2,
+                                         Solution& result) {
+        horse.partiallyMappedCrossover(parent1, parent2, result);
+    }
+};
+
+namespace {
+std::shared_ptr<ProblemInstance> benchmarkInstance(const benchmark::State& state) {
+    Logger::getInstance().setMinLevel(LogLevel::ERROR);
+    Random::getInstance().setSeed(42);
+    return ProblemInstance::generateRandom(state.range(0), state.range(1), 1, 99);
+}
+
+Solution randomSolution(std::shared_ptr<ProblemInstance> instance) {
+    Solution solution(instance);
+    solution.initializeRandom();
+    return solution;
+}
+
+void instanceSizes(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"n", "m"});
+    bench->Args({20, 5})->Args({50, 10})->Args({100, 10})->Args({100, 20})->Args({200, 20})->Args({500, 20});
+}
+
+// Sizes plus the starting point: random (0) or a local optimum of the search (1)
+void localSearchArguments(benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"n", "m", "local_optimum"});
+    for (int local_optimum : {0, 1}) {
+        bench->Args({20, 5, local_optimum})->Args({50, 10, local_optimum})->Args({100, 10, local_optimum})
+             ->Args({100, 20, local_optimum})->Args({200, 20, local_optimum})->Args({500, 20, local_optimum});
+    }
+}
+}
+
+static void BM_SolutionGetMakespan(benchmark::State& state) {
+    auto instance = benchmarkInstance(state);
+    Solution solution = randomSolution(instance);
+    int last = instance->getNumJobs() - 1;
+    
+    // Swapping the first position discards every cached row: full evaluation
+    for (auto _ : state) {
+        solution.swapJobs(0, last);
+        benchmark::DoNotOptimize(solution.getMakespan());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_SolutionGetMakespan)->Apply(instanceSizes);
+
+static void BM_SolutionApply2Opt(benchmark::State& state) {
+    auto instance = benchmarkInstance(state);
+    Solution start = randomSolution(instance);
+    if (state.range(2)) {
+        while (start.apply2Opt()) {}
+    }
+    
+    // First-improvement sweep as in grazing; from a local optimum every move is rejected
+    for (auto _ : state) {
+        Solution solution(start);
+        benchmark::DoNotOptimize(solution.apply2Opt(true));
+    }
+}
+BENCHMARK(BM_SolutionApply2Opt)->Apply(localSearchArguments)->Unit(benchmark::kMicrosecond);
+
+static void BM_SolutionApplyInsertionSearch(benchmark::State& state) {
+    auto instance = benchmarkInstance(state);
+    Solution start = randomSolution(instance);
+    if (state.range(2)) {
+        while (start.applyInsertionSearch()) {}
+    }
+    
+    for (auto _ : state) {
+        Solution solution(start);
+        benchmark::DoNotOptimize(solution.applyInsertionSearch(true));
+    }
+}
+BENCHMARK(BM_SolutionApplyInsertionSearch)->Apply(localSearchArguments)->Unit(benchmark::kMicrosecond);
+
+static void BM_SolutionApplyIteratedGreedy(benchmark::State& state) {
+    auto instance = benchmarkInstance(state);
+    Solution start = randomSolution(instance);
+    if (state.range(2)) {
+        while (start.applyInsertionSearch()) {}
+    }
+    
+    // One destruction-reconstruction step of d = 4 jobs: O(d n m)
+    for (auto _ : state) {
+        Solution solution(start);
+        benchmark::DoNotOptimize(solution.applyIteratedGreedy(4));
+    }
+}
+BENCHMARK(BM_SolutionApplyIteratedGreedy)->Apply(localSearchArguments)->Unit(benchmark::kMicrosecond);
+
+static void BM_SolutionInitializeNEH(benchmark::State& state) {
+    auto instance = benchmarkInstance(state);
+    Solution solution(instance);
+    
+    // n accelerated insertion sweeps: O(n^2 m)
+    for (auto _ : state) {
+        solution.initializeNEH();
+        benchmark::DoNotOptimize(solution.getMakespan());
+    }
+}
+BENCHMARK(BM_SolutionInitializeNEH)->Apply(instanceSizes)->Unit(benchmark::kMicrosecond);
+
+static void BM_HorseOrderCrossover(benchmark::State& state) {
+    auto instance = benchmarkInstance(state);
+    Horse horse(instance);
+    Solution parent1 = randomSolution(instance);
+    Solution parent2 = randomSolution(instance);
+    Solution offspring(instance);
+    
+    for (auto _ : state) {
+        HorseBenchmark::orderCrossover(horse, parent1, parent2, offspring);
+        benchmark::DoNotOptimize(offspring.getJobSequence().data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HorseOrderCrossover)->Apply(instanceSizes);
+
+static void BM_HorsePartiallyMappedCrossover(benchmark::State& state) {
+    auto instance = benchmarkInstance(state);
+    Horse horse(instance);
+    Solution parent1 = randomSolution(instance);
+    Solution parent2 = randomSolution(instance);
+    Solution offspring(instance);
+    
+    for (auto _ : state) {
+        HorseBenchmark::partiallyMappedCrossover(horse, parent1, parent2, offspring);
+        benchmark::DoNotOptimize(offspring.getJobSequence().data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_HorsePartiallyMappedCrossover)->Apply(instanceSizes);
+
+static void BM_HorseHerdCalculateDiversity(benchmark::State& state) {
+    auto instance = benchmarkInstance(state);
+    HorseHerd herd(instance, 30);
+    herd.setDiversityMetric(static_cast<DiversityMetric>(state.range(2)));
+    herd.initialize();
+    
+    // Mutating every horse first makes each call refresh the whole population
+    for (auto _ : state) {
+        state.PauseTiming();
+        herd.performMutation(1.0);
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(herd.calculateDiversity());
+    }
+}
+BENCHMARK(BM_HorseHerdCalculateDiversity)->Apply([](benchmark::internal::Benchmark* bench) {
+    bench->ArgNames({"n", "m", "hamming"});
+    for (int metric : {static_cast<int>(DiversityMetric::ENTROPY), static_cast<int>(DiversityMetric::HAMMING)}) {
+        bench->Args({20, 5, metric})->Args({100, 10, metric})->Args({500, 20, metric});
+    }
+});
+
+static void BM_HHOAExecuteIteration(benchmark::State& state) {
+    auto instance = benchmarkInstance(state);
+    HHOAParameters params;
+    params.population_size = 30;
+    HHOA hhoa(instance, params);
+    HHOABenchmark::initialize(hhoa);
+    
+    // Skip the first iterations, which print phase banners
+    int iteration = 5;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(HHOABenchmark::executeIteration(hhoa, iteration++));
+    }
+}
+BENCHMARK(BM_HHOAExecuteIteration)->Apply(instanceSizes)->Unit(benchmark::kMillisecond);
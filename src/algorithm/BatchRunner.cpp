@@ -0,0 +1,326 @@
+#include "BatchRunner.h"
+#include "../utils/Random.h"
+#include "../utils/ThreadPool.h"
+#include "../utils/Timer.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+// Per-instance aggregate of the finished runs
+struct InstanceSummary {
+    int runs = 0;
+    int best = 0;
+    double mean = 0.0;
+    double arpd = 0.0;
+    double mean_time_ms = 0.0;
+};
+
+InstanceSummary summarize(const std::vector<BatchRun>& runs, int instance_index) {
+    InstanceSummary summary;
+    for (const auto& run : runs) {
+        if (run.instance_index != instance_index || !run.completed) {
+            continue;
+        }
+        summary.best = summary.runs == 0 ? run.makespan : std::min(summary.best, run.makespan);
+        summary.mean += run.makespan;
+        summary.arpd += run.rpd;
+        summary.mean_time_ms += run.time_ms;
+        summary.runs++;
+    }
+    if (summary.runs > 0) {
+        summary.mean /= summary.runs;
+        summary.arpd /= summary.runs;
+        summary.mean_time_ms /= summary.runs;
+    }
+    return summary;
+}
+
+std::string jsonString(const std::string& value) {
+    std::string escaped = "\"";
+    for (char c : value) {
+        if (c == '"' || c == '\\') {
+            escaped += '\\';
+        }
+        escaped += c;
+    }
+    return escaped + "\"";
+}
+}
+
+void BatchParameters::print() const {
+    std::cout << "Batch Parameters:" << std::endl;
+    std::cout << "  Workers: " << num_workers << std::endl;
+    std::cout << "  Seeds: " << first_seed << " - " << (first_seed + num_seeds - 1) << std::endl;
+    if (time_factor > 0.0) {
+        std::cout << "  Time Limit: n*m/2*" << time_factor << " ms" << std::endl;
+    }
+}
+
+bool BatchParameters::isValid() const {
+    return num_workers > 0 && num_seeds > 0 && time_factor >= 0.0;
+}
+
+BatchRunner::BatchRunner(const HHOAParameters& parameters, const BatchParameters& batch_parameters)
+    : parameters_(parameters), batch_parameters_(batch_parameters) {
+    if (!parameters_.isValid()) {
+        throw std::invalid_argument("Invalid HHOA parameters");
+    }
+    if (!batch_parameters_.isValid()) {
+        throw std::invalid_argument("Invalid batch parameters");
+    }
+}
+
+void BatchRunner::setProgressCallback(std::function<void(const BatchRun&, int, int)> callback) {
+    progress_callback_ = callback;
+}
+
+void BatchRunner::addInstance(const std::string& name, std::shared_ptr<ProblemInstance> instance, int upper_bound) {
+    if (!instance || !instance->isValid()) {
+        throw std::invalid_argument("Invalid problem instance: " + name);
+    }
+    instances_.push_back(BatchInstance{name, instance, upper_bound});
+}
+
+int BatchRunner::loadInstanceList(const std::string& filename) {
+    std::ifstream file(filename);
+    if (!file.is_open()) {
+        throw std::invalid_argument("Cannot open instance list " + filename);
+    }
+
+    std::filesystem::path directory = std::filesystem::path(filename).parent_path();
+    std::map<std::string, std::shared_ptr<ProblemInstance>> loaded;
+    int added = 0;
+
+    std::string line;
+    while (std::getline(file, line)) {
+        std::istringstream fields(line);
+        std::string path;
+        if (!(fields >> path) || path[0] == '#') {
+            continue;
+        }
+        int upper_bound = -1;
+        fields >> upper_bound;
+
+        std::filesystem::path resolved(path);
+        if (resolved.is_relative()) {
+            resolved = directory / resolved;
+        }
+
+        std::shared_ptr<ProblemInstance>& instance = loaded[resolved.lexically_normal().string()];
+        if (!instance) {
+            instance = ProblemInstance::loadFromFile(resolved.string());
+            if (!instance) {
+                throw std::invalid_argument("Cannot load instance " + resolved.string());
+            }
+        }
+
+        // Binary instance files can carry their best-known makespan
+        if (upper_bound <= 0) {
+            upper_bound = instance->getKnownUpperBound();
+        }
+        addInstance(resolved.stem().string(), instance, upper_bound);
+        added++;
+    }
+
+    return added;
+}
+
+const std::vector<BatchRun>& BatchRunner::run() {
+    int num_seeds = batch_parameters_.num_seeds;
+    int total = instances_.size() * num_seeds;
+
+    runs_.assign(total, BatchRun{});
+    for (int i = 0; i < total; ++i) {
+        runs_[i].instance_index = i / num_seeds;
+        runs_[i].seed = batch_parameters_.first_seed + i % num_seeds;
+    }
+
+    // Largest instances first, so no long run is left alone at the end
+    std::vector<int> order(total);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) {
+        const ProblemInstance& first = *instances_[runs_[a].instance_index].instance;
+        const ProblemInstance& second = *instances_[runs_[b].instance_index].instance;
+        return first.getNumJobs() * first.getNumMachines() > second.getNumJobs() * second.getNumMachines();
+    });
+
+    std::mutex progress_mutex;
+    int completed = 0;
+
+    // Inside a worker, the thread pools of the herds run their phases inline
+    ThreadPool pool(std::max(1, std::min(batch_parameters_.num_workers, total)));
+    pool.parallelFor(total, [&](int task) {
+        BatchRun& run = runs_[order[task]];
+        executeRun(run);
+
+        std::lock_guard<std::mutex> lock(progress_mutex);
+        completed++;
+        if (progress_callback_) {
+            progress_callback_(run, completed, total);
+        }
+    });
+
+    return runs_;
+}
+
+void BatchRunner::executeRun(BatchRun& run) const {
+    const BatchInstance& batch_instance = instances_[run.instance_index];
+
+    // Same stream as a standalone run with this seed
+    Random run_rng(run.seed);
+    Random::Binding binding(run_rng);
+
+    // Time limits scale with the instance size
+    HHOAParameters parameters = parameters_;
+    if (batch_parameters_.time_factor > 0.0) {
+        parameters.time_limit_ms = HHOAParameters::scaledTimeLimitMs(batch_instance.instance->getNumJobs(),
+                                                                     batch_instance.instance->getNumMachines(),
+                                                                     batch_parameters_.time_factor);
+    }
+    
+    Timer timer;
+    timer.start();
+    HHOA hhoa(batch_instance.instance, parameters);
+    Solution best_solution = hhoa.optimize();
+
+    run.time_ms = timer.getElapsedMs();
+    run.makespan = best_solution.getMakespan();
+    run.iterations = hhoa.getStatistics().iterations_executed;
+    run.rpd = batch_instance.upper_bound > 0
+        ? relativePercentDeviation(run.makespan, batch_instance.upper_bound) : 0.0;
+    run.completed = true;
+}
+
+double BatchRunner::relativePercentDeviation(int makespan, int upper_bound) {
+    if (upper_bound <= 0) {
+        throw std::invalid_argument("Upper bound must be positive");
+    }
+    return 100.0 * (makespan - upper_bound) / upper_bound;
+}
+
+bool BatchRunner::saveCsv(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << "instance,jobs,machines,seed,makespan,upper_bound,rpd,time_ms,iterations\n";
+    file << std::fixed;
+    for (const auto& run : runs_) {
+        if (!run.completed) {
+            continue;
+        }
+        const BatchInstance& batch_instance = instances_[run.instance_index];
+        bool known = batch_instance.upper_bound > 0;
+
+        file << batch_instance.name << ','
+             << batch_instance.instance->getNumJobs() << ','
+             << batch_instance.instance->getNumMachines() << ','
+             << run.seed << ',' << run.makespan << ',';
+        if (known) {
+            file << batch_instance.upper_bound << ',' << std::setprecision(4) << run.rpd;
+        } else {
+            file << ',';
+        }
+        file << ',' << std::setprecision(3) << run.time_ms << ',' << run.iterations << '\n';
+    }
+
+    return static_cast<bool>(file);
+}
+
+bool BatchRunner::saveJson(const std::string& filename) const {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    file << std::fixed;
+    file << "{\n";
+    file << "  \"parameters\": {\"population_size\": " << parameters_.population_size
+         << ", \"max_iterations\": " << parameters_.max_iterations
+         << ", \"first_seed\": " << batch_parameters_.first_seed
+         << ", \"num_seeds\": " << batch_parameters_.num_seeds << "},\n";
+
+    file << "  \"instances\": [\n";
+    for (size_t i = 0; i < instances_.size(); ++i) {
+        const BatchInstance& batch_instance = instances_[i];
+        InstanceSummary summary = summarize(runs_, i);
+        bool known = batch_instance.upper_bound > 0;
+
+        file << "    {\"name\": " << jsonString(batch_instance.name)
+             << ", \"jobs\": " << batch_instance.instance->getNumJobs()
+             << ", \"machines\": " << batch_instance.instance->getNumMachines()
+             << ", \"upper_bound\": ";
+        if (known) file << batch_instance.upper_bound; else file << "null";
+        file << ", \"runs\": " << summary.runs
+             << ", \"best\": " << summary.best
+             << ", \"mean\": " << std::setprecision(2) << summary.mean
+             << ", \"arpd\": ";
+        if (known) file << std::setprecision(4) << summary.arpd; else file << "null";
+        file << ", \"mean_time_ms\": " << std::setprecision(3) << summary.mean_time_ms << "}"
+             << (i + 1 < instances_.size() ? "," : "") << "\n";
+    }
+    file << "  ],\n";
+
+    file << "  \"runs\": [\n";
+    bool first = true;
+    for (const auto& run : runs_) {
+        if (!run.completed) {
+            continue;
+        }
+        bool known = instances_[run.instance_index].upper_bound > 0;
+
+        file << (first ? "" : ",\n")
+             << "    {\"instance\": " << jsonString(instances_[run.instance_index].name)
+             << ", \"seed\": " << run.seed
+             << ", \"makespan\": " << run.makespan
+             << ", \"rpd\": ";
+        if (known) file << std::setprecision(4) << run.rpd; else file << "null";
+        file << ", \"time_ms\": " << std::setprecision(3) << run.time_ms
+             << ", \"iterations\": " << run.iterations << "}";
+        first = false;
+    }
+    file << "\n  ]\n";
+    file << "}\n";
+
+    return static_cast<bool>(file);
+}
+
+void BatchRunner::printSummary() const {
+    std::streamsize precision = std::cout.precision();
+    std::cout << std::left << std::setw(20) << "Instance" << std::right
+              << std::setw(10) << "Size" << std::setw(8) << "UB"
+              << std::setw(8) << "Best" << std::setw(10) << "Mean"
+              << std::setw(9) << "ARPD" << std::setw(12) << "Time(ms)" << std::endl;
+
+    std::cout << std::fixed;
+    for (size_t i = 0; i < instances_.size(); ++i) {
+        const BatchInstance& batch_instance = instances_[i];
+        InstanceSummary summary = summarize(runs_, i);
+        std::string size = std::to_string(batch_instance.instance->getNumJobs()) + "x" +
+                           std::to_string(batch_instance.instance->getNumMachines());
+        bool known = batch_instance.upper_bound > 0;
+
+        std::cout << std::left << std::setw(20) << batch_instance.name << std::right
+                  << std::setw(10) << size
+                  << std::setw(8) << (known ? std::to_string(batch_instance.upper_bound) : "-")
+                  << std::setw(8) << summary.best
+                  << std::setw(10) << std::setprecision(1) << summary.mean;
+        if (known) {
+            std::cout << std::setw(9) << std::setprecision(2) << summary.arpd;
+        } else {
+            std::cout << std::setw(9) << "-";
+        }
+        std::cout << std::setw(12) << std::setprecision(1) << summary.mean_time_ms << std::endl;
+    }
+    std::cout.unsetf(std::ios::fixed);
+    std::cout.precision(precision);
+}
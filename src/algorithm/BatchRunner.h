@@ -0,0 +1,154 @@
+#ifndef BATCH_RUNNER_H
+#define BATCH_RUNNER_H
+
+#include "HHOA.h"
+#include "../core/ProblemInstance.h"
+#include <vector>
+#include <string>
+#include <memory>
+#include <functional>
+
+/**
+ * @brief Parameters of a batch experiment
+ */
+struct BatchParameters {
+    int num_workers = 1;          // Concurrent runs
+    unsigned int first_seed = 1;  // Seed of the first run of every instance
+    int num_seeds = 10;           // Runs per instance (seeds first_seed, first_seed + 1, ...)
+    double time_factor = 0.0;     // Time limit of every run: n * m / 2 * time_factor ms (0: from the HHOA parameters)
+
+    /**
+     * @brief Print parameters
+     */
+    void print() const;
+
+    /**
+     * @brief Validate parameters
+     * @return True if valid, false otherwise
+     */
+    bool isValid() const;
+};
+
+/**
+ * @brief Instance of a batch, loaded once and shared read-only by its runs
+ */
+struct BatchInstance {
+    std::string name;                             // Name used in the reports
+    std::shared_ptr<ProblemInstance> instance;    // Problem instance
+    int upper_bound = -1;                         // Best-known makespan (-1: unknown)
+};
+
+/**
+ * @brief Outcome of one (instance, seed) run
+ */
+struct BatchRun {
+    int instance_index = 0;    // Index into the batch instances
+    unsigned int seed = 0;     // Seed of the run
+    int makespan = 0;          // Best makespan found
+    double rpd = 0.0;          // Relative percent deviation from the upper bound (if known)
+    double time_ms = 0.0;      // Wall-clock time of the run
+    int iterations = 0;        // Iterations executed
+    bool completed = false;    // Whether the run has finished
+};
+
+/**
+ * @brief Multi-instance, multi-seed experiment driver
+ *
+ * Every (instance, seed) pair is an independent HHOA run. The runs are
+ * scheduled over a pool of workers, largest instances first, and each one
+ * draws from a generator seeded exactly like `hhoa_fssp -s <seed>`, so any
+ * row of a batch can be reproduced with a single run. Results are reported
+ * as relative percent deviation (RPD) from the best-known upper bounds:
+ * RPD = 100 * (makespan - UB) / UB.
+ */
+class BatchRunner {
+private:
+    HHOAParameters parameters_;            // Algorithm parameters of every run
+    BatchParameters batch_parameters_;     // Scheduling parameters
+    std::vector<BatchInstance> instances_; // Instances of the batch
+    std::vector<BatchRun> runs_;           // Results [instance * num_seeds + seed offset]
+    std::function<void(const BatchRun&, int, int)> progress_callback_;  // (run, completed, total)
+
+public:
+    /**
+     * @brief Constructor
+     * @param parameters Algorithm parameters of every run
+     * @param batch_parameters Scheduling parameters
+     */
+    BatchRunner(const HHOAParameters& parameters, const BatchParameters& batch_parameters);
+
+    // Getters
+    const std::vector<BatchInstance>& getInstances() const { return instances_; }
+    const std::vector<BatchRun>& getRuns() const { return runs_; }
+    const BatchParameters& getBatchParameters() const { return batch_parameters_; }
+
+    /**
+     * @brief Set a callback invoked (serialized) after every finished run
+     * @param callback Receives the run, the number of finished runs and the total
+     */
+    void setProgressCallback(std::function<void(const BatchRun&, int, int)> callback);
+
+    /**
+     * @brief Add an instance to the batch
+     * @param name Name used in the reports
+     * @param instance Problem instance
+     * @param upper_bound Best-known makespan (-1: unknown)
+     */
+    void addInstance(const std::string& name, std::shared_ptr<ProblemInstance> instance, int upper_bound = -1);
+
+    /**
+     * @brief Add the instances of a list file
+     *
+     * One instance per line: `<path> [upper_bound]`. Relative paths are
+     * resolved against the directory of the list; empty lines and lines
+     * starting with '#' are ignored. A file listed twice is loaded once.
+     * Without an upper bound on the line, the instance's known upper bound
+     * (binary files) is used.
+     *
+     * @param filename List file
+     * @return Number of instances added
+     */
+    int loadInstanceList(const std::string& filename);
+
+    /**
+     * @brief Run every (instance, seed) pair
+     * @return Results, grouped by instance in seed order
+     */
+    const std::vector<BatchRun>& run();
+
+    /**
+     * @brief Relative percent deviation of a makespan from an upper bound
+     * @param makespan Makespan found
+     * @param upper_bound Best-known makespan (must be positive)
+     * @return 100 * (makespan - upper_bound) / upper_bound
+     */
+    static double relativePercentDeviation(int makespan, int upper_bound);
+
+    /**
+     * @brief Save one row per run as CSV
+     * @param filename Output file
+     * @return True if successful
+     */
+    bool saveCsv(const std::string& filename) const;
+
+    /**
+     * @brief Save the runs and a per-instance summary as JSON
+     * @param filename Output file
+     * @return True if successful
+     */
+    bool saveJson(const std::string& filename) const;
+
+    /**
+     * @brief Print a per-instance summary (best, mean and ARPD)
+     */
+    void printSummary() const;
+
+private:
+    /**
+     * @brief Execute one run
+     * @param run Run to execute (instance and seed set)
+     */
+    void executeRun(BatchRun& run) const;
+};
+
+#endif // BATCH_RUNNER_H
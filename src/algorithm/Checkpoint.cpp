@@ -0,0 +1,422 @@
+#include "Checkpoint.h"
+#include <iostream>
+#include <fstream>
+#include <iterator>
+#include <cstdio>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+// Checkpoint file: this header followed by a payload of fixed-size values
+// and length-prefixed arrays, in the order of HHOACheckpoint::save. Values are
+// stored in the byte order of the writing machine.
+struct CheckpointHeader {
+    char magic[8];                 // kCheckpointMagic
+    std::uint32_t version;         // kCheckpointVersion
+    std::int32_t num_jobs;
+    std::int32_t num_machines;
+    std::int32_t herd_size;
+    std::uint64_t instance_checksum;  // ProblemInstance::getChecksum
+    std::uint64_t payload_size;       // Bytes following the header
+    std::uint64_t payload_checksum;   // FNV-1a over the payload bytes
+};
+
+const char kCheckpointMagic[8] = {'H', 'H', 'O', 'A', 'C', 'K', 'P', '\0'};
+constexpr std::uint32_t kCheckpointVersion = 4;
+
+std::uint64_t checksumOf(const std::string& bytes) {
+    std::uint64_t hash = 0xcbf29ce484222325ULL;
+    for (unsigned char byte : bytes) {
+        hash ^= byte;
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// Appends values to a payload
+class PayloadWriter {
+private:
+    std::string& bytes_;
+
+public:
+    explicit PayloadWriter(std::string& bytes) : bytes_(bytes) {}
+
+    template<typename T>
+    void put(const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "Only plain values are written directly");
+        bytes_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void putBool(bool value) { put<std::uint8_t>(value ? 1 : 0); }
+
+    template<typename T>
+    void putVector(const std::vector<T>& values) {
+        put<std::uint64_t>(values.size());
+        bytes_.append(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+    }
+};
+
+// Reads values back from a payload; any read past the end fails the reader
+class PayloadReader {
+private:
+    const std::string& bytes_;
+    size_t offset_ = 0;
+    bool ok_ = true;
+
+public:
+    explicit PayloadReader(const std::string& bytes) : bytes_(bytes) {}
+
+    bool ok() const { return ok_; }
+    bool atEnd() const { return offset_ == bytes_.size(); }
+
+    template<typename T>
+    T get() {
+        T value{};
+        if (ok_ && bytes_.size() - offset_ >= sizeof(T)) {
+            std::memcpy(&value, bytes_.data() + offset_, sizeof(T));
+            offset_ += sizeof(T);
+        } else {
+            ok_ = false;
+        }
+        return value;
+    }
+
+    bool getBool() { return get<std::uint8_t>() != 0; }
+
+    template<typename T>
+    std::vector<T> getVector() {
+        std::uint64_t count = get<std::uint64_t>();
+        std::vector<T> values;
+        if (!ok_ || count > (bytes_.size() - offset_) / sizeof(T)) {
+            ok_ = false;
+            return values;
+        }
+        values.resize(count);
+        std::memcpy(values.data(), bytes_.data() + offset_, count * sizeof(T));
+        offset_ += count * sizeof(T);
+        return values;
+    }
+};
+
+// Only the algorithmic parameters: threads, tracing, budgets, the history
+// and the checkpoint settings belong to the process that resumes
+void writeParameters(PayloadWriter& out, const HHOAParameters& parameters) {
+    out.put<std::int32_t>(parameters.population_size);
+    out.put<std::int32_t>(parameters.max_iterations);
+    out.put<double>(parameters.grazing_intensity);
+    out.put<double>(parameters.roaming_rate);
+    out.put<double>(parameters.exploration_rate);
+    out.put<double>(parameters.following_rate);
+    out.put<double>(parameters.mating_rate);
+    out.put<double>(parameters.crossover_rate);
+    out.put<double>(parameters.mutation_rate);
+    out.put<double>(parameters.replacement_rate);
+    out.put<std::int32_t>(parameters.max_stagnation);
+    out.put<std::int32_t>(parameters.elite_improvement_freq);
+    out.put<std::int32_t>(parameters.elite_count);
+    out.put<double>(parameters.diversity_threshold);
+    out.putBool(parameters.adaptive_parameters);
+    out.put<std::int32_t>(parameters.termination_patience);
+    out.put<std::int32_t>(static_cast<int>(parameters.diversity_metric));
+    out.put<std::int32_t>(parameters.evaluation_cache_size);
+    out.put<double>(parameters.random_ratio);
+    out.put<std::int32_t>(static_cast<int>(parameters.initial_heuristic));
+    out.putBool(parameters.stop_at_lower_bound);
+    out.putBool(parameters.operator_selection);
+    out.put<double>(parameters.selection_decay);
+    out.put<double>(parameters.min_operator_share);
+    out.put<std::int32_t>(static_cast<int>(parameters.grazing_mode));
+    out.put<std::int32_t>(parameters.destruction_size);
+}
+
+void readParameters(PayloadReader& in, HHOAParameters& parameters) {
+    parameters.population_size = in.get<std::int32_t>();
+    parameters.max_iterations = in.get<std::int32_t>();
+    parameters.grazing_intensity = in.get<double>();
+    parameters.roaming_rate = in.get<double>();
+    parameters.exploration_rate = in.get<double>();
+    parameters.following_rate = in.get<double>();
+    parameters.mating_rate = in.get<double>();
+    parameters.crossover_rate = in.get<double>();
+    parameters.mutation_rate = in.get<double>();
+    parameters.replacement_rate = in.get<double>();
+    parameters.max_stagnation = in.get<std::int32_t>();
+    parameters.elite_improvement_freq = in.get<std::int32_t>();
+    parameters.elite_count = in.get<std::int32_t>();
+    parameters.diversity_threshold = in.get<double>();
+    parameters.adaptive_parameters = in.getBool();
+    parameters.termination_patience = in.get<std::int32_t>();
+    parameters.diversity_metric = static_cast<DiversityMetric>(in.get<std::int32_t>());
+    parameters.evaluation_cache_size = in.get<std::int32_t>();
+    parameters.random_ratio = in.get<double>();
+    parameters.initial_heuristic = static_cast<InitialHeuristic>(in.get<std::int32_t>());
+    parameters.stop_at_lower_bound = in.getBool();
+    parameters.operator_selection = in.getBool();
+    parameters.selection_decay = in.get<double>();
+    parameters.min_operator_share = in.get<double>();
+    parameters.grazing_mode = static_cast<GrazingMode>(in.get<std::int32_t>());
+    parameters.destruction_size = in.get<std::int32_t>();
+}
+
+// Cache counters are not stored: the restored herd starts with an empty cache
+void writeStatistics(PayloadWriter& out, const HHOAStatistics& statistics) {
+    out.put<std::int32_t>(statistics.iterations_executed);
+    out.put<std::int32_t>(statistics.total_improvements);
+    out.put<std::int32_t>(statistics.leader_changes);
+    out.put<std::int32_t>(statistics.rejuvenations);
+    out.put<std::int32_t>(statistics.replacements);
+    out.put<double>(statistics.execution_time_ms);
+    out.put<std::int64_t>(statistics.evaluations);
+    out.put<std::int32_t>(statistics.lower_bound);
+    for (const PhaseProfile& phase : statistics.phases) {
+        out.put<PhaseProfile>(phase);
+    }
+    for (const OperatorCredit& credit : statistics.operators) {
+        out.put<OperatorCredit>(credit);
+    }
+    out.putVector(statistics.history.toVector());
+}
+
+void readStatistics(PayloadReader& in, HHOAStatistics& statistics) {
+    statistics.iterations_executed = in.get<std::int32_t>();
+    statistics.total_improvements = in.get<std::int32_t>();
+    statistics.leader_changes = in.get<std::int32_t>();
+    statistics.rejuvenations = in.get<std::int32_t>();
+    statistics.replacements = in.get<std::int32_t>();
+    statistics.execution_time_ms = in.get<double>();
+    statistics.evaluations = in.get<std::int64_t>();
+    statistics.lower_bound = in.get<std::int32_t>();
+    for (PhaseProfile& phase : statistics.phases) {
+        phase = in.get<PhaseProfile>();
+    }
+    for (OperatorCredit& credit : statistics.operators) {
+        credit = in.get<OperatorCredit>();
+    }
+    statistics.history = IterationHistory(0);
+    for (const IterationRecord& record : in.getVector<IterationRecord>()) {
+        statistics.history.push(record);
+    }
+}
+
+void writeHorse(PayloadWriter& out, const HorseState& horse) {
+    out.putVector(horse.sequence);
+    out.putVector(horse.best_sequence);
+    out.put<double>(horse.fitness);
+    out.put<double>(horse.best_fitness);
+    out.put<double>(horse.age);
+    out.put<double>(horse.grazing_ability);
+    out.put<double>(horse.stamina);
+    out.putBool(horse.is_leader);
+    out.put<std::int32_t>(horse.stagnation_counter);
+}
+
+void readHorse(PayloadReader& in, HorseState& horse) {
+    horse.sequence = in.getVector<int>();
+    horse.best_sequence = in.getVector<int>();
+    horse.fitness = in.get<double>();
+    horse.best_fitness = in.get<double>();
+    horse.age = in.get<double>();
+    horse.grazing_ability = in.get<double>();
+    horse.stamina = in.get<double>();
+    horse.is_leader = in.getBool();
+    horse.stagnation_counter = in.get<std::int32_t>();
+}
+
+bool isPermutation(const std::vector<int>& sequence, int num_jobs) {
+    if (sequence.size() != static_cast<size_t>(num_jobs)) {
+        return false;
+    }
+    std::vector<char> seen(num_jobs, 0);
+    for (int job : sequence) {
+        if (job < 0 || job >= num_jobs || seen[job]) {
+            return false;
+        }
+        seen[job] = 1;
+    }
+    return true;
+}
+
+bool hasValidSequences(const HorseState& horse, int num_jobs) {
+    return isPermutation(horse.sequence, num_jobs) && isPermutation(horse.best_sequence, num_jobs);
+}
+}
+
+bool HHOACheckpoint::save(const std::string& filename) const {
+    std::string payload;
+    PayloadWriter out(payload);
+    writeParameters(out, parameters);
+    writeStatistics(out, statistics);
+    for (std::uint64_t word : rng_state) {
+        out.put<std::uint64_t>(word);
+    }
+    out.put<std::int32_t>(next_iteration);
+    out.put<std::int32_t>(end_iteration);
+    out.put<std::int32_t>(stagnation_count);
+    out.put<std::int32_t>(best_makespan);
+    out.put<std::int32_t>(herd.generation);
+    out.put<double>(herd.diversity);
+    for (const HorseState& horse : herd.horses) {
+        writeHorse(out, horse);
+    }
+    writeHorse(out, herd.leader);
+
+    CheckpointHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kCheckpointMagic, sizeof(kCheckpointMagic));
+    header.version = kCheckpointVersion;
+    header.num_jobs = num_jobs;
+    header.num_machines = num_machines;
+    header.herd_size = herd.horses.size();
+    header.instance_checksum = instance_checksum;
+    header.payload_size = payload.size();
+    header.payload_checksum = checksumOf(payload);
+
+    const std::string temporary = filename + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Error: Cannot create checkpoint file " << temporary << std::endl;
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(payload.data(), payload.size());
+        file.close();
+        if (!file) {
+            std::cerr << "Error: Cannot write checkpoint file " << temporary << std::endl;
+            std::remove(temporary.c_str());
+            return false;
+        }
+    }
+
+    if (std::rename(temporary.c_str(), filename.c_str()) != 0) {
+        std::cerr << "Error: Cannot replace checkpoint file " << filename << std::endl;
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::unique_ptr<HHOACheckpoint> HHOACheckpoint::load(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot open checkpoint file " << filename << std::endl;
+        return nullptr;
+    }
+
+    CheckpointHeader header;
+    if (!file.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+        std::cerr << "Error: Truncated checkpoint " << filename << std::endl;
+        return nullptr;
+    }
+    if (std::memcmp(header.magic, kCheckpointMagic, sizeof(kCheckpointMagic)) != 0 ||
+        header.version != kCheckpointVersion) {
+        std::cerr << "Error: Unsupported checkpoint format in " << filename << std::endl;
+        return nullptr;
+    }
+    if (header.num_jobs <= 0 || header.num_machines <= 0 || header.herd_size <= 0) {
+        std::cerr << "Error: Invalid checkpoint dimensions in " << filename << std::endl;
+        return nullptr;
+    }
+
+    std::string payload((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    if (payload.size() != header.payload_size || checksumOf(payload) != header.payload_checksum) {
+        std::cerr << "Error: Corrupted checkpoint " << filename << std::endl;
+        return nullptr;
+    }
+
+    auto checkpoint = std::make_unique<HHOACheckpoint>();
+    checkpoint->num_jobs = header.num_jobs;
+    checkpoint->num_machines = header.num_machines;
+    checkpoint->instance_checksum = header.instance_checksum;
+
+    PayloadReader in(payload);
+    readParameters(in, checkpoint->parameters);
+    readStatistics(in, checkpoint->statistics);
+    for (std::uint64_t& word : checkpoint->rng_state) {
+        word = in.get<std::uint64_t>();
+    }
+    checkpoint->next_iteration = in.get<std::int32_t>();
+    checkpoint->end_iteration = in.get<std::int32_t>();
+    checkpoint->stagnation_count = in.get<std::int32_t>();
+    checkpoint->best_makespan = in.get<std::int32_t>();
+    checkpoint->herd.generation = in.get<std::int32_t>();
+    checkpoint->herd.diversity = in.get<double>();
+    checkpoint->herd.horses.resize(header.herd_size);
+    for (HorseState& horse : checkpoint->herd.horses) {
+        readHorse(in, horse);
+    }
+    readHorse(in, checkpoint->herd.leader);
+
+    if (!in.ok() || !in.atEnd()) {
+        std::cerr << "Error: Malformed checkpoint " << filename << std::endl;
+        return nullptr;
+    }
+
+    bool valid = checkpoint->parameters.isValid() &&
+                 checkpoint->parameters.population_size == header.herd_size &&
+                 hasValidSequences(checkpoint->herd.leader, header.num_jobs);
+    for (const HorseState& horse : checkpoint->herd.horses) {
+        valid = valid && hasValidSequences(horse, header.num_jobs);
+    }
+    if (!valid) {
+        std::cerr << "Error: Inconsistent checkpoint " << filename << std::endl;
+        return nullptr;
+    }
+
+    return checkpoint;
+}
+
+CheckpointWriter::CheckpointWriter(const std::string& filename)
+    : filename_(filename), thread_(&CheckpointWriter::run, this) {
+}
+
+CheckpointWriter::~CheckpointWriter() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    changed_.notify_all();
+    thread_.join();
+}
+
+void CheckpointWriter::submit(HHOACheckpoint&& checkpoint) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_ = std::make_unique<HHOACheckpoint>(std::move(checkpoint));
+    }
+    changed_.notify_all();
+}
+
+void CheckpointWriter::flush() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [this] { return !pending_ && !writing_; });
+}
+
+int CheckpointWriter::getWritten() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return written_;
+}
+
+int CheckpointWriter::getFailed() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_;
+}
+
+void CheckpointWriter::run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        changed_.wait(lock, [this] { return pending_ || stopping_; });
+        if (!pending_) {
+            return;  // Stopping with nothing left to write
+        }
+
+        std::unique_ptr<HHOACheckpoint> checkpoint = std::move(pending_);
+        writing_ = true;
+        lock.unlock();
+        bool saved = checkpoint->save(filename_);
+        lock.lock();
+        writing_ = false;
+        (saved ? written_ : failed_)++;
+        changed_.notify_all();
+    }
+}
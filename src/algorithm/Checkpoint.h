@@ -0,0 +1,120 @@
+#ifndef CHECKPOINT_H
+#define CHECKPOINT_H
+
+#include "HHOA.h"
+#include <array>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/**
+ * @brief Everything needed to continue an HHOA run (see HHOA::resume)
+ *
+ * Captured between two iterations: the herd, the run's random generator,
+ * the adaptive parameters, the statistics and the loop counters. The
+ * instance itself is not stored, only its dimensions and checksum.
+ */
+struct HHOACheckpoint {
+    int num_jobs = 0;                         // Instance dimensions
+    int num_machines = 0;
+    std::uint64_t instance_checksum = 0;      // ProblemInstance::getChecksum of the instance
+    HHOAParameters parameters;                // Parameters, adaptive rates as of the checkpoint
+    HHOAStatistics statistics;                // Statistics and histories so far
+    HerdState herd;                           // Horses, leader and generation
+    std::array<std::uint64_t, 4> rng_state{}; // State of the run's random generator
+    int next_iteration = 0;                   // First iteration still to run
+    int end_iteration = 0;                    // Iteration bound of the run
+    int stagnation_count = 0;                 // Iterations without improvement
+    int best_makespan = 0;                    // Best makespan seen by the loop
+
+    /**
+     * @brief Save the checkpoint in the binary checkpoint format
+     *
+     * Written to `<filename>.tmp` first and renamed over the file, so an
+     * interrupted write leaves the previous checkpoint intact.
+     *
+     * @param filename Output file
+     * @return True if successful
+     */
+    bool save(const std::string& filename) const;
+
+    /**
+     * @brief Load a checkpoint saved with save()
+     *
+     * Rejects files with a wrong magic, version or payload checksum, and
+     * sequences that are not permutations of the stored dimensions.
+     *
+     * @param filename Checkpoint file
+     * @return Loaded checkpoint, or null on error
+     */
+    static std::unique_ptr<HHOACheckpoint> load(const std::string& filename);
+};
+
+/**
+ * @brief Background thread writing the checkpoints of a run
+ *
+ * submit() only hands the checkpoint over: serialization and the file
+ * write happen on the writer thread. If a checkpoint is still waiting when
+ * the next one arrives it is replaced, since only the newest one matters.
+ */
+class CheckpointWriter {
+private:
+    std::string filename_;                       // Destination of every checkpoint
+    std::mutex mutex_;                           // Guards the members below
+    std::condition_variable changed_;            // Signals new work and finished writes
+    std::unique_ptr<HHOACheckpoint> pending_;    // Newest checkpoint not written yet
+    bool writing_ = false;                       // A checkpoint is being written
+    bool stopping_ = false;                      // Destructor called
+    int written_ = 0;                            // Checkpoints written
+    int failed_ = 0;                             // Checkpoints that could not be written
+    std::thread thread_;                         // Writer thread
+
+public:
+    /**
+     * @brief Constructor: starts the writer thread
+     * @param filename Destination of every checkpoint
+     */
+    explicit CheckpointWriter(const std::string& filename);
+
+    /**
+     * @brief Destructor: writes the pending checkpoint and joins the thread
+     */
+    ~CheckpointWriter();
+
+    CheckpointWriter(const CheckpointWriter&) = delete;
+    CheckpointWriter& operator=(const CheckpointWriter&) = delete;
+
+    /**
+     * @brief Queue a checkpoint, replacing one still waiting
+     * @param checkpoint Checkpoint to write
+     */
+    void submit(HHOACheckpoint&& checkpoint);
+
+    /**
+     * @brief Wait until every submitted checkpoint has been written
+     */
+    void flush();
+
+    /**
+     * @brief Checkpoints written so far
+     * @return Written count
+     */
+    int getWritten();
+
+    /**
+     * @brief Checkpoints that could not be written
+     * @return Failure count
+     */
+    int getFailed();
+
+private:
+    /**
+     * @brief Writer thread body
+     */
+    void run();
+};
+
+#endif // CHECKPOINT_H
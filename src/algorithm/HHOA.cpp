@@ -1,15 +1,37 @@
 #include "HHOA.h"
+#include "Checkpoint.h"
+#include "../utils/Random.h"
 #include <iostream>
 #include <fstream>
 #include <iomanip>
 #include <algorithm>
 #include <sstream>
+#include <climits>
+
+const char* phaseName(HHOAPhase phase) {
+    switch (phase) {
+        case HHOAPhase::GRAZING: return "Grazing";
+        case HHOAPhase::ROAMING: return "Roaming";
+        case HHOAPhase::FOLLOWING: return "Following";
+        case HHOAPhase::MATING: return "Mating";
+        case HHOAPhase::MUTATION: return "Mutation";
+        case HHOAPhase::AGING: return "Aging";
+        case HHOAPhase::REPLACEMENT: return "Replacement";
+        case HHOAPhase::REJUVENATION: return "Rejuvenation";
+        case HHOAPhase::ELITE_IMPROVEMENT: return "EliteImprovement";
+        case HHOAPhase::DIVERSITY: return "Diversity";
+        default: return "Unknown";
+    }
+}
 
 void HHOAParameters::print() const {
     std::cout << "HHOA Parameters:" << std::endl;
     std::cout << "  Population Size: " << population_size << std::endl;
     std::cout << "  Max Iterations: " << max_iterations << std::endl;
     std::cout << "  Grazing Intensity: " << grazing_intensity << std::endl;
+    std::cout << "  Grazing Mode: " << (grazing_mode == GrazingMode::ITERATED_GREEDY
+                                            ? "Iterated greedy (d = " + std::to_string(destruction_size) + ")"
+                                            : std::string("Local search")) << std::endl;
     std::cout << "  Roaming Rate: " << roaming_rate << std::endl;
     std::cout << "  Exploration Rate: " << exploration_rate << std::endl;
     std::cout << "  Following Rate: " << following_rate << std::endl;
@@ -20,7 +42,26 @@ void HHOAParameters::print() const {
     std::cout << "  Max Stagnation: " << max_stagnation << std::endl;
     std::cout << "  Elite Count: " << elite_count << std::endl;
     std::cout << "  Adaptive Parameters: " << (adaptive_parameters ? "Yes" : "No") << std::endl;
+    std::cout << "  Operator Selection: " << (operator_selection ? "Bandit (decay " + std::to_string(selection_decay) +
+                                                                      ", min share " + std::to_string(min_operator_share) + ")"
+                                                                  : std::string("Fixed")) << std::endl;
     std::cout << "  Termination Patience: " << termination_patience << std::endl;
+    std::cout << "  Threads: " << num_threads << std::endl;
+    std::cout << "  Evaluation Cache: " << evaluation_cache_size << " slots" << std::endl;
+    std::cout << "  Diversity Metric: " << (diversity_metric == DiversityMetric::ENTROPY ? "Entropy" : "Hamming") << std::endl;
+    std::cout << "  Record Trace: " << (record_trace ? "Yes" : "No") << std::endl;
+    std::cout << "  Random Ratio: " << random_ratio << std::endl;
+    std::cout << "  Initial Heuristic: " << (initial_heuristic == InitialHeuristic::NEH ? "NEH" : "SPT") << std::endl;
+    std::cout << "  Stop at Lower Bound: " << (stop_at_lower_bound ? "Yes" : "No") << std::endl;
+    std::cout << "  Time Limit: " << (time_limit_ms > 0.0 ? std::to_string(time_limit_ms) + " ms" : "None") << std::endl;
+    std::cout << "  Max Evaluations: " << (max_evaluations > 0 ? std::to_string(max_evaluations) : "None") << std::endl;
+    std::cout << "  Checkpoints: " << (checkpoint_interval > 0 && !checkpoint_file.empty()
+                                           ? checkpoint_file + " every " + std::to_string(checkpoint_interval) + " iterations"
+                                           : "None") << std::endl;
+    std::cout << "  History: " << (history_interval > 0 ? "every " + std::to_string(history_interval) + " iterations"
+                                                       : std::string("improvements only"))
+              << ", " << (history_capacity > 0 ? std::to_string(history_capacity) + " kept" : std::string("all kept"))
+              << (history_file.empty() ? "" : ", streamed to " + history_file) << std::endl;
 }
 
 bool HHOAParameters::isValid() const {
@@ -34,7 +75,24 @@ bool HHOAParameters::isValid() const {
            mutation_rate >= 0.0 && mutation_rate <= 1.0 &&
            replacement_rate >= 0.0 && replacement_rate <= 1.0 &&
            max_stagnation > 0 && elite_count >= 0 &&
-           termination_patience > 0;
+           termination_patience > 0 && num_threads > 0 && evaluation_cache_size >= 0 &&
+           random_ratio >= 0.0 && random_ratio <= 1.0 &&
+           time_limit_ms >= 0.0 && max_evaluations >= 0 && checkpoint_interval >= 0 &&
+           history_interval >= 0 && history_capacity >= 0 &&
+           destruction_size >= 1 && parallel_reinsertion_jobs >= 0 &&
+           selection_decay >= 0.0 && selection_decay < 1.0 &&
+           min_operator_share >= 0.0 && min_operator_share * OperatorSelector::kNumOperators <= 1.0;
+}
+
+double HHOAParameters::scaledTimeLimitMs(int num_jobs, int num_machines, double factor) {
+    if (num_jobs <= 0 || num_machines <= 0 || factor < 0.0) {
+        throw std::invalid_argument("Invalid time limit scaling");
+    }
+    return num_jobs * num_machines / 2.0 * factor;
+}
+
+double HHOAStatistics::getOptimalityGap() const {
+    return lower_bound > 0 ? 100.0 * (best_makespan - lower_bound) / lower_bound : 0.0;
 }
 
 void HHOAStatistics::print() const {
@@ -47,10 +105,65 @@ void HHOAStatistics::print() const {
     std::cout << "  Execution Time: " << std::fixed << std::setprecision(2) 
               << execution_time_ms << " ms" << std::endl;
     
-    if (!best_makespan_history.empty()) {
-        std::cout << "  Best Makespan: " << *std::min_element(best_makespan_history.begin(), 
-                                                             best_makespan_history.end()) << std::endl;
-        std::cout << "  Final Makespan: " << best_makespan_history.back() << std::endl;
+    if (cache_hits + cache_misses > 0) {
+        std::cout << "  Cache Hit Rate: " << std::fixed << std::setprecision(2)
+                  << 100.0 * cache_hits / (cache_hits + cache_misses) << "% ("
+                  << cache_hits << " hits, " << cache_misses << " misses)" << std::endl;
+    }
+    
+    long long profiled_ns = 0;
+    for (const auto& phase : phases) {
+        profiled_ns += phase.nanoseconds;
+    }
+    if (profiled_ns > 0) {
+        std::cout << "  Evaluations: " << evaluations << std::endl;
+        std::cout << "  Phase Profile:" << std::endl;
+        std::cout << "    " << std::left << std::setw(18) << "Phase" << std::right
+                  << std::setw(10) << "Time(ms)" << std::setw(8) << "Share"
+                  << std::setw(14) << "Evaluations" << std::setw(10) << "Accept" << std::endl;
+        for (size_t i = 0; i < phases.size(); ++i) {
+            const PhaseProfile& phase = phases[i];
+            std::cout << "    " << std::left << std::setw(18) << phaseName(static_cast<HHOAPhase>(i)) << std::right
+                      << std::setw(10) << std::setprecision(2) << phase.nanoseconds / 1e6
+                      << std::setw(7) << std::setprecision(1) << 100.0 * phase.nanoseconds / profiled_ns << "%"
+                      << std::setw(14) << phase.evaluations
+                      << std::setw(9) << std::setprecision(1) << 100.0 * phase.getAcceptRate() << "%" << std::endl;
+        }
+        std::cout << std::setprecision(2);
+    }
+    
+    if (std::any_of(operators.begin(), operators.end(), [](const OperatorCredit& op) { return op.runs > 0; })) {
+        std::cout << "  Operator Credit:" << std::endl;
+        std::cout << "    " << std::left << std::setw(18) << "Operator" << std::right
+                  << std::setw(10) << "Credit" << std::setw(8) << "Share"
+                  << std::setw(8) << "Runs" << std::setw(8) << "Skips" << std::setw(10) << "Accepted" << std::endl;
+        for (size_t i = 0; i < operators.size(); ++i) {
+            const OperatorCredit& op = operators[i];
+            std::cout << "    " << std::left << std::setw(18) << phaseName(static_cast<HHOAPhase>(i)) << std::right
+                      << std::setw(10) << std::setprecision(4) << op.credit
+                      << std::setw(7) << std::setprecision(1) << 100.0 * op.share << "%"
+                      << std::setw(8) << op.runs << std::setw(8) << op.skips
+                      << std::setw(10) << op.accepted << std::endl;
+        }
+        std::cout << std::setprecision(2);
+    }
+    
+    if (!history.empty()) {
+        std::cout << "  Best Makespan: " << (best_makespan > 0 ? best_makespan : history.back().best_makespan) << std::endl;
+        std::cout << "  Final Makespan: " << history.back().best_makespan << std::endl;
+    }
+    
+    if (lower_bound > 0) {
+        std::cout << "  Lower Bound: " << lower_bound << " (gap " << std::fixed << std::setprecision(2)
+                  << getOptimalityGap() << "%" << (optimal ? ", optimal" : "") << ")" << std::endl;
+    }
+    
+    if (budget_exhausted) {
+        std::cout << "  Budget Exhausted: Yes" << std::endl;
+    }
+    
+    if (checkpoints_written > 0) {
+        std::cout << "  Checkpoints Written: " << checkpoints_written << std::endl;
     }
 }
 
@@ -61,24 +174,35 @@ bool HHOAStatistics::saveToFile(const std::string& filename) const {
         return false;
     }
 
-    file << "Iteration,BestMakespan,Diversity,AverageFitness" << std::endl;
-    
-    for (size_t i = 0; i < best_makespan_history.size(); ++i) {
-        file << i << "," << best_makespan_history[i];
-        
-        if (i < diversity_history.size()) {
-            file << "," << diversity_history[i];
-        } else {
-            file << ",0";
+    // One buffered write instead of a flush per row
+    std::string rows = IterationHistory::csvHeader();
+    rows += '\n';
+    for (size_t i = 0; i < history.size(); ++i) {
+        IterationHistory::appendCsvRow(history[i], rows);
+    }
+    file << rows;
+    
+    bool profiled = std::any_of(phases.begin(), phases.end(),
+                                [](const PhaseProfile& phase) { return phase.calls > 0; });
+    if (profiled) {
+        file << "\nPhase,Calls,TimeNs,Evaluations,Attempts,Accepted,AcceptRate\n";
+        for (size_t i = 0; i < phases.size(); ++i) {
+            const PhaseProfile& phase = phases[i];
+            file << phaseName(static_cast<HHOAPhase>(i)) << "," << phase.calls << ","
+                 << phase.nanoseconds << "," << phase.evaluations << "," << phase.attempts << ","
+                 << phase.accepted << "," << phase.getAcceptRate() << "\n";
         }
-        
-        if (i < average_fitness_history.size()) {
-            file << "," << average_fitness_history[i];
-        } else {
-            file << ",0";
+    }
+    
+    bool selected = std::any_of(operators.begin(), operators.end(),
+                                [](const OperatorCredit& op) { return op.runs > 0; });
+    if (selected) {
+        file << "\nOperator,Credit,Share,Runs,Skips,Attempts,Accepted\n";
+        for (size_t i = 0; i < operators.size(); ++i) {
+            const OperatorCredit& op = operators[i];
+            file << phaseName(static_cast<HHOAPhase>(i)) << "," << op.credit << "," << op.share << ","
+                 << op.runs << "," << op.skips << "," << op.attempts << "," << op.accepted << "\n";
         }
-        
-        file << std::endl;
     }
 
     file.close();
@@ -97,8 +221,11 @@ HHOA::HHOA(std::shared_ptr<ProblemInstance> instance, const HHOAParameters& para
     }
     
     herd_ = std::make_unique<HorseHerd>(instance_, parameters_.population_size);
+    configureHerd();
 }
 
+HHOA::~HHOA() = default;
+
 void HHOA::setParameters(const HHOAParameters& parameters) {
     if (!parameters.isValid()) {
         throw std::invalid_argument("Invalid HHOA parameters");
@@ -109,6 +236,15 @@ void HHOA::setParameters(const HHOAParameters& parameters) {
     if (!herd_ || herd_->getHerdSize() != parameters_.population_size) {
         herd_ = std::make_unique<HorseHerd>(instance_, parameters_.population_size);
     }
+    configureHerd();
+}
+
+void HHOA::setInstance(std::shared_ptr<ProblemInstance> instance) {
+    if (!instance || !instance->isValid()) {
+        throw std::invalid_argument("Invalid problem instance");
+    }
+    instance_ = instance;
+    herd_->setInstance(instance_);
 }
 
 void HHOA::setIterationCallback(std::function<void(int, const Solution&, const HHOAStatistics&)> callback) {
@@ -119,6 +255,15 @@ void HHOA::setTerminationCallback(std::function<bool(int, const Solution&)> call
     termination_callback_ = callback;
 }
 
+void HHOA::setImprovementCallback(std::function<void(int, const Solution&)> callback) {
+    improvement_callback_ = callback;
+}
+
+SolveHandle HHOA::solveAsync(size_t queue_capacity) {
+    stop_requested_.store(false, std::memory_order_relaxed);
+    return SolveHandle(*this, Random::getInstance().nextSeed(), queue_capacity);
+}
+
 Solution HHOA::optimize() {
     return optimize(parameters_.max_iterations);
 }
@@ -126,16 +271,45 @@ Solution HHOA::optimize() {
 Solution HHOA::optimize(int iterations) {
     LOG_INFO("Starting HHOA optimization for " + std::to_string(iterations) + " iterations");
     
+    // Evaluations on this thread (and the herd's workers) are charged to the run's budget
+    SearchBudget::Binding budget_binding(&budget_);
     initialize();
     
-    int stagnation_count = 0;
-    int best_makespan = herd_->getBestSolution().getMakespan();
+    next_iteration_ = 0;
+    end_iteration_ = iterations;
+    stagnation_count_ = 0;
+    loop_best_makespan_ = herd_->getBestSolution().getMakespan();
+    reportImprovement(-1);
+    
+    return runIterations();
+}
+
+Solution HHOA::resume(const std::string& filename) {
+    std::unique_ptr<HHOACheckpoint> checkpoint = HHOACheckpoint::load(filename);
+    if (!checkpoint) {
+        throw std::runtime_error("Cannot load checkpoint " + filename);
+    }
+    
+    LOG_INFO("Resuming HHOA optimization from " + filename + " at iteration " +
+             std::to_string(checkpoint->next_iteration));
+    
+    SearchBudget::Binding budget_binding(&budget_);
+    restoreCheckpoint(*checkpoint);
+    
+    return runIterations();
+}
+
+Solution HHOA::runIterations() {
+    if (parameters_.checkpoint_interval > 0 && !parameters_.checkpoint_file.empty()) {
+        checkpoint_writer_ = std::make_unique<CheckpointWriter>(parameters_.checkpoint_file);
+    }
     
-    for (int iteration = 0; iteration < iterations; ++iteration) {
-        // Print progress every 10 iterations
+    // An initial herd already at the lower bound needs no iteration
+    for (int iteration = next_iteration_; iteration < end_iteration_ && !reachedLowerBound(); ++iteration) {
+        // Report progress every 10 iterations
         if (iteration % 10 == 0) {
-            std::cout << "Iteration " << iteration << "/" << iterations << 
-                         " - Best makespan: " << best_makespan << std::endl;
+            LOG_DEBUG("Iteration " + std::to_string(iteration) + "/" + std::to_string(end_iteration_) +
+                      " - Best makespan: " + std::to_string(loop_best_makespan_));
         }
         
         bool improved = executeIteration(iteration);
@@ -143,19 +317,20 @@ Solution HHOA::optimize(int iterations) {
         
         // Check for improvement
         int current_makespan = herd_->getBestSolution().getMakespan();
-        if (current_makespan < best_makespan) {
-            best_makespan = current_makespan;
-            stagnation_count = 0;
+        if (current_makespan < loop_best_makespan_) {
+            loop_best_makespan_ = current_makespan;
+            stagnation_count_ = 0;
             statistics_.total_improvements++;
-            std::cout << "Improvement found at iteration " << iteration << 
-                         ": " << current_makespan << std::endl;
+            LOG_INFO("Improvement found at iteration " + std::to_string(iteration) +
+                     ": " + std::to_string(current_makespan));
+            reportImprovement(iteration);
         } else {
-            stagnation_count++;
+            stagnation_count_++;
         }
         
         // Update adaptive parameters
         if (parameters_.adaptive_parameters) {
-            updateAdaptiveParameters(iteration, herd_->getDiversity(), stagnation_count);
+            updateAdaptiveParameters(iteration, herd_->getDiversity(), stagnation_count_);
         }
         
         // Call iteration callback
@@ -164,13 +339,27 @@ Solution HHOA::optimize(int iterations) {
         }
         
         // Check termination conditions
-        if (shouldTerminate(iteration, stagnation_count)) {
+        if (shouldTerminate(iteration, stagnation_count_)) {
             LOG_INFO("Early termination at iteration " + std::to_string(iteration));
+            
+            // An interrupted run leaves a checkpoint to continue from
+            if (checkpoint_writer_ && (isStopRequested() || budget_.wasExhausted())) {
+                next_iteration_ = iteration + 1;
+                statistics_sink_.flush();
+                checkpoint_writer_->submit(captureCheckpoint());
+            }
             break;
         }
         
         herd_->nextGeneration();
         statistics_.iterations_executed = iteration + 1;
+        next_iteration_ = iteration + 1;
+        
+        // Periodic checkpoint: captured here, serialized and written by the writer thread
+        if (checkpoint_writer_ && next_iteration_ % parameters_.checkpoint_interval == 0) {
+            statistics_sink_.flush();  // The streamed history covers the checkpoint
+            checkpoint_writer_->submit(captureCheckpoint());
+        }
     }
     
     finalize();
@@ -188,9 +377,10 @@ Solution HHOA::optimizeToTarget(int target_makespan, int max_iterations) {
     
     LOG_INFO("Starting HHOA optimization to target makespan: " + std::to_string(target_makespan));
     
+    SearchBudget::Binding budget_binding(&budget_);
     initialize();
     
-    for (int iteration = 0; iteration < max_iterations; ++iteration) {
+    for (int iteration = 0; iteration < max_iterations && !reachedLowerBound(); ++iteration) {
         bool improved = executeIteration(iteration);
         recordStatistics(iteration, improved);
         
@@ -200,6 +390,16 @@ Solution HHOA::optimizeToTarget(int target_makespan, int max_iterations) {
             break;
         }
         
+        // A target below the lower bound is unreachable
+        if (reachedLowerBound()) {
+            LOG_INFO("Lower bound reached at iteration " + std::to_string(iteration));
+            break;
+        }
+        
+        if (isStopRequested() || budget_.isExhausted()) {
+            break;
+        }
+        
         // Call iteration callback
         if (iteration_callback_) {
             iteration_callback_(iteration, herd_->getBestSolution(), statistics_);
@@ -216,11 +416,22 @@ Solution HHOA::optimizeToTarget(int target_makespan, int max_iterations) {
 
 void HHOA::reset() {
     statistics_ = HHOAStatistics{};
+    trace_.clear();
+    stop_requested_.store(false, std::memory_order_relaxed);
     if (herd_) {
         herd_ = std::make_unique<HorseHerd>(instance_, parameters_.population_size);
+        configureHerd();
     }
 }
 
+void HHOA::configureHerd() {
+    herd_->setNumThreads(parameters_.num_threads);
+    herd_->setDiversityMetric(parameters_.diversity_metric);
+    herd_->setInitialHeuristic(parameters_.initial_heuristic);
+    herd_->setGrazingMode(parameters_.grazing_mode, parameters_.destruction_size, parameters_.parallel_reinsertion_jobs);
+    herd_->setEvaluationCacheSize(parameters_.evaluation_cache_size);
+}
+
 Solution HHOA::getBestSolution() const {
     if (!herd_) {
         throw std::runtime_error("Algorithm not initialized");
@@ -235,6 +446,20 @@ int HHOA::getBestMakespan() const {
     return herd_->getBestSolution().getMakespan();
 }
 
+std::vector<Solution> HHOA::getEliteSolutions(int count) const {
+    if (!herd_) {
+        throw std::runtime_error("Algorithm not initialized");
+    }
+    return herd_->getEliteSolutions(count);
+}
+
+int HHOA::injectSolutions(const std::vector<Solution>& solutions) {
+    if (!herd_) {
+        throw std::runtime_error("Algorithm not initialized");
+    }
+    return herd_->acceptMigrants(solutions);
+}
+
 void HHOA::print() const {
     std::cout << "=== HHOA Algorithm ===" << std::endl;
     parameters_.print();
@@ -284,79 +509,176 @@ bool HHOA::saveResults(const std::string& filename) const {
     return true;
 }
 
+bool HHOA::saveTrace(const std::string& filename) const {
+    if (!Profiler::saveChromeTrace(filename, trace_, "HHOA " + instance_->getInstanceName())) {
+        std::cerr << "Error: Cannot create trace file " << filename << std::endl;
+        return false;
+    }
+    return true;
+}
+
+template<typename Body>
+int HHOA::runPhase(HHOAPhase phase, int iteration, const Body& body) {
+    // Out of budget: skip the remaining phases, except the leader update
+    if (phase != HHOAPhase::DIVERSITY && budget_.isExhausted()) {
+        return 0;
+    }
+    
+#ifdef HHOA_ENABLE_PROFILING
+    long long start_ns = timer_.getElapsedNanoseconds();
+    long long evaluations = herd_->getEvaluationCount();
+    long long attempts = herd_->getAttemptCount();
+    
+    int accepted = body();
+    
+    TraceEvent event{phaseName(phase), iteration, start_ns, timer_.getElapsedNanoseconds() - start_ns,
+                     herd_->getEvaluationCount() - evaluations, herd_->getAttemptCount() - attempts, accepted};
+    
+    PhaseProfile& profile = statistics_.phases[static_cast<int>(phase)];
+    profile.calls++;
+    profile.nanoseconds += event.duration_ns;
+    profile.evaluations += event.evaluations;
+    profile.attempts += event.attempts;
+    profile.accepted += event.accepted;
+    
+    if (parameters_.record_trace) {
+        trace_.push_back(event);
+    }
+    return accepted;
+#else
+    (void)phase;
+    (void)iteration;
+    return body();
+#endif
+}
+
+template<typename Body>
+int HHOA::runOperator(HHOAPhase phase, int iteration, const Body& body) {
+    if (!parameters_.operator_selection) {
+        return runPhase(phase, iteration, body);
+    }
+    
+    int arm = static_cast<int>(phase);
+    if (budget_.isExhausted() || !operator_selector_.select(arm)) {
+        return 0;
+    }
+    
+    long long attempts = herd_->getAttemptCount();
+    int accepted = runPhase(phase, iteration, body);
+    operator_selector_.update(arm, accepted, herd_->getAttemptCount() - attempts);
+    return accepted;
+}
+
 bool HHOA::executeIteration(int iteration) {
     bool improved = false;
     
-    // Debug output for first few iterations
+    // Trace the first few iterations
     if (iteration < 5) {
-        std::cout << "Starting iteration " << iteration << std::endl;
+        LOG_DEBUG("Starting iteration " + std::to_string(iteration));
+    }
+    
+    // Shares for this iteration, from the credits of the previous ones
+    if (parameters_.operator_selection) {
+        operator_selector_.beginIteration();
     }
     
     // Phase 1: Grazing (local search)
-    if (iteration < 5) std::cout << "  Phase 1: Grazing..." << std::endl;
-    int grazing_improvements = herd_->performGrazing(parameters_.grazing_intensity);
+    int grazing_improvements = runOperator(HHOAPhase::GRAZING, iteration, [&] {
+        return herd_->performGrazing(parameters_.grazing_intensity);
+    });
     if (grazing_improvements > 0) improved = true;
     
     // Phase 2: Roaming (exploration)
-    if (iteration < 5) std::cout << "  Phase 2: Roaming..." << std::endl;
-    int roaming_improvements = herd_->performRoaming(parameters_.roaming_rate, 
-                                                    parameters_.exploration_rate);
+    int roaming_improvements = runOperator(HHOAPhase::ROAMING, iteration, [&] {
+        return herd_->performRoaming(parameters_.roaming_rate, parameters_.exploration_rate);
+    });
     if (roaming_improvements > 0) improved = true;
     
     // Phase 3: Following the leader
-    if (iteration < 5) std::cout << "  Phase 3: Following..." << std::endl;
-    int following_improvements = herd_->performFollowing(parameters_.following_rate);
+    int following_improvements = runOperator(HHOAPhase::FOLLOWING, iteration, [&] {
+        return herd_->performFollowing(parameters_.following_rate);
+    });
     if (following_improvements > 0) improved = true;
     
     // Phase 4: Mating
-    if (iteration < 5) std::cout << "  Phase 4: Mating..." << std::endl;
-    int mating_improvements = herd_->performMating(parameters_.mating_rate, 
-                                                  parameters_.crossover_rate);
+    int mating_improvements = runOperator(HHOAPhase::MATING, iteration, [&] {
+        return herd_->performMating(parameters_.mating_rate, parameters_.crossover_rate);
+    });
     if (mating_improvements > 0) improved = true;
     
     // Phase 5: Mutation
-    if (iteration < 5) std::cout << "  Phase 5: Mutation..." << std::endl;
-    int mutation_improvements = herd_->performMutation(parameters_.mutation_rate);
+    int mutation_improvements = runOperator(HHOAPhase::MUTATION, iteration, [&] {
+        return herd_->performMutation(parameters_.mutation_rate);
+    });
     if (mutation_improvements > 0) improved = true;
     
     // Phase 6: Age horses
-    if (iteration < 5) std::cout << "  Phase 6: Aging..." << std::endl;
-    herd_->ageHorses();
+    runPhase(HHOAPhase::AGING, iteration, [&] {
+        herd_->ageHorses();
+        return 0;
+    });
     
     // Phase 7: Replace weak horses
     if (iteration % 10 == 0) {
-        int replacements = herd_->replaceWeakHorses(parameters_.replacement_rate);
+        int replacements = runPhase(HHOAPhase::REPLACEMENT, iteration, [&] {
+            return herd_->replaceWeakHorses(parameters_.replacement_rate);
+        });
         statistics_.replacements += replacements;
     }
     
     // Phase 8: Rejuvenate stagnant horses
     if (iteration % parameters_.max_stagnation == 0) {
-        int rejuvenations = herd_->rejuvenateStagnantHorses(parameters_.max_stagnation);
+        int rejuvenations = runPhase(HHOAPhase::REJUVENATION, iteration, [&] {
+            return herd_->rejuvenateStagnantHorses(parameters_.max_stagnation);
+        });
         statistics_.rejuvenations += rejuvenations;
     }
     
     // Phase 9: Elite improvement
     if (iteration % parameters_.elite_improvement_freq == 0) {
-        int elite_improvements = herd_->improveElite(parameters_.elite_count);
+        int elite_improvements = runPhase(HHOAPhase::ELITE_IMPROVEMENT, iteration, [&] {
+            return herd_->improveElite(parameters_.elite_count);
+        });
         if (elite_improvements > 0) improved = true;
     }
     
     // Phase 10: Update leader and diversity
-    if (herd_->updateLeader()) {
-        statistics_.leader_changes++;
-    }
-    
-    herd_->calculateDiversity();
-    
-    // Apply diversity preservation if needed
-    if (herd_->getDiversity() < parameters_.diversity_threshold) {
-        applyDiversityPreservation(herd_->getDiversity());
-    }
+    runPhase(HHOAPhase::DIVERSITY, iteration, [&] {
+        if (herd_->updateLeader()) {
+            statistics_.leader_changes++;
+        }
+        
+        herd_->calculateDiversity();
+        
+        // Apply diversity preservation if needed: every replaced horse counts as accepted
+        long long attempts = herd_->getAttemptCount();
+        if (herd_->getDiversity() < parameters_.diversity_threshold) {
+            applyDiversityPreservation(herd_->getDiversity());
+        }
+        return static_cast<int>(herd_->getAttemptCount() - attempts);
+    });
     
     return improved;
 }
 
 bool HHOA::shouldTerminate(int iteration, int stagnation_count) const {
+    // Check external stop requests
+    if (isStopRequested()) {
+        return true;
+    }
+    
+    // Check the time and evaluation budgets
+    if (budget_.isExhausted()) {
+        LOG_INFO("Search budget exhausted");
+        return true;
+    }
+    
+    // Check optimality: nothing below the lower bound exists
+    if (reachedLowerBound()) {
+        LOG_INFO("Lower bound " + std::to_string(statistics_.lower_bound) + " reached");
+        return true;
+    }
+    
     // Check custom termination callback
     if (termination_callback_) {
         return termination_callback_(iteration, herd_->getBestSolution());
@@ -375,6 +697,11 @@ bool HHOA::shouldTerminate(int iteration, int stagnation_count) const {
     return false;
 }
 
+bool HHOA::reachedLowerBound() const {
+    return parameters_.stop_at_lower_bound &&
+           herd_->getBestSolution().getMakespan() <= statistics_.lower_bound;
+}
+
 void HHOA::updateAdaptiveParameters(int iteration, double diversity, int stagnation_count) {
     double progress = static_cast<double>(iteration) / parameters_.max_iterations;
     
@@ -422,26 +749,153 @@ bool HHOA::applyDiversityPreservation(double diversity) {
 }
 
 void HHOA::recordStatistics(int iteration, bool improved) {
-    statistics_.best_makespan_history.push_back(herd_->getBestSolution().getMakespan());
-    statistics_.diversity_history.push_back(herd_->getDiversity());
-    statistics_.average_fitness_history.push_back(herd_->getAverageFitness());
+    IterationRecord record{iteration, herd_->getBestSolution().getMakespan(), herd_->getDiversity(),
+                           herd_->getAverageFitness()};
+    bool improved_best = record.best_makespan < history_best_makespan_;
+    history_best_makespan_ = std::min(history_best_makespan_, record.best_makespan);
+    
+    // Downsampling: every k-th iteration, or only the improvements of the best makespan
+    int interval = parameters_.history_interval;
+    if (interval > 0 ? iteration % interval == 0 : improved_best) {
+        statistics_.history.push(record);
+        statistics_sink_.write(record);
+    }
+    
+    if (parameters_.operator_selection) {
+        statistics_.operators = operator_selector_.getCredits();
+    }
+    
+    if (const EvaluationCache* cache = herd_->getEvaluationCache()) {
+        statistics_.cache_hits = cache->getHits();
+        statistics_.cache_misses = cache->getMisses();
+    }
+    
+    statistics_.evaluations = herd_->getEvaluationCount() - start_evaluations_;
+}
+
+void HHOA::startRun() {
+    timer_.start();
+    budget_.start(parameters_.time_limit_ms, parameters_.max_evaluations);
+    if (isStopRequested()) {
+        budget_.cancel();  // Stop requested before the run started
+    }
+    trace_.clear();
+    start_evaluations_ = herd_->getEvaluationCount();
+    resumed_time_ms_ = 0.0;
+}
+
+void HHOA::reportImprovement(int iteration) {
+    if (improvement_callback_) {
+        improvement_callback_(iteration, herd_->getBestSolution());
+    }
+    if (solve_callback_) {
+        solve_callback_(iteration, herd_->getBestSolution());
+    }
+}
+
+HHOACheckpoint HHOA::captureCheckpoint() const {
+    HHOACheckpoint checkpoint;
+    checkpoint.num_jobs = instance_->getNumJobs();
+    checkpoint.num_machines = instance_->getNumMachines();
+    checkpoint.instance_checksum = instance_->getChecksum();
+    checkpoint.parameters = parameters_;
+    checkpoint.statistics = statistics_;
+    checkpoint.statistics.execution_time_ms = resumed_time_ms_ + timer_.getElapsedMs();
+    checkpoint.herd = herd_->getState();
+    
+    const std::uint64_t* rng_state = Random::getInstance().getEngine().state();
+    std::copy(rng_state, rng_state + checkpoint.rng_state.size(), checkpoint.rng_state.begin());
+    
+    checkpoint.next_iteration = next_iteration_;
+    checkpoint.end_iteration = end_iteration_;
+    checkpoint.stagnation_count = stagnation_count_;
+    checkpoint.best_makespan = loop_best_makespan_;
+    return checkpoint;
+}
+
+void HHOA::restoreCheckpoint(const HHOACheckpoint& checkpoint) {
+    if (checkpoint.num_jobs != instance_->getNumJobs() || checkpoint.num_machines != instance_->getNumMachines() ||
+        checkpoint.instance_checksum != instance_->getChecksum()) {
+        throw std::invalid_argument("Checkpoint belongs to a different problem instance");
+    }
+    
+    // Algorithmic parameters from the checkpoint, process settings from this object
+    HHOAParameters parameters = checkpoint.parameters;
+    parameters.num_threads = parameters_.num_threads;
+    parameters.parallel_reinsertion_jobs = parameters_.parallel_reinsertion_jobs;
+    parameters.record_trace = parameters_.record_trace;
+    parameters.time_limit_ms = parameters_.time_limit_ms;
+    parameters.max_evaluations = parameters_.max_evaluations;
+    parameters.checkpoint_file = parameters_.checkpoint_file;
+    parameters.checkpoint_interval = parameters_.checkpoint_interval;
+    parameters.history_interval = parameters_.history_interval;
+    parameters.history_capacity = parameters_.history_capacity;
+    parameters.history_file = parameters_.history_file;
+    setParameters(parameters);
+    
+    herd_->restoreState(checkpoint.herd);
+    Random::getInstance().getEngine().setState(checkpoint.rng_state.data());
+    
+    startRun();
+    statistics_ = checkpoint.statistics;
+    statistics_.history = IterationHistory(parameters_.history_capacity);
+    for (size_t i = 0; i < checkpoint.statistics.history.size(); ++i) {
+        statistics_.history.push(checkpoint.statistics.history[i]);
+    }
+    resumed_time_ms_ = checkpoint.statistics.execution_time_ms;
+    start_evaluations_ -= checkpoint.statistics.evaluations;
+    statistics_.lower_bound = instance_->getLowerBound();
+    
+    next_iteration_ = checkpoint.next_iteration;
+    end_iteration_ = checkpoint.end_iteration;
+    stagnation_count_ = checkpoint.stagnation_count;
+    loop_best_makespan_ = checkpoint.best_makespan;
+    history_best_makespan_ = checkpoint.next_iteration > 0 ? checkpoint.best_makespan : INT_MAX;
+    operator_selector_.reset(parameters_.selection_decay, parameters_.min_operator_share);
+    operator_selector_.setCredits(checkpoint.statistics.operators);
+    
+    // Rows past the checkpoint may already be in the file: readers keep the last row per iteration
+    if (!parameters_.history_file.empty()) {
+        statistics_sink_.open(parameters_.history_file, true);
+    }
 }
 
 void HHOA::initialize() {
     LOG_INFO("Initializing HHOA algorithm");
     
-    timer_.start();
+    startRun();
     statistics_ = HHOAStatistics{};
+    statistics_.history = IterationHistory(parameters_.history_capacity);
+    statistics_.lower_bound = instance_->getLowerBound();
+    history_best_makespan_ = INT_MAX;
+    operator_selector_.reset(parameters_.selection_decay, parameters_.min_operator_share);
+    if (!parameters_.history_file.empty()) {
+        statistics_sink_.open(parameters_.history_file);
+    }
     
     // Initialize the herd
-    herd_->initialize();
+    herd_->initialize(parameters_.random_ratio);
+    statistics_.evaluations = herd_->getEvaluationCount() - start_evaluations_;
     
     LOG_INFO("Initial best makespan: " + std::to_string(herd_->getBestSolution().getMakespan()));
 }
 
 void HHOA::finalize() {
     timer_.stop();
-    statistics_.execution_time_ms = timer_.getElapsedMs();
+    statistics_.execution_time_ms = resumed_time_ms_ + timer_.getElapsedMs();
+    statistics_.evaluations = herd_->getEvaluationCount() - start_evaluations_;
+    statistics_.best_makespan = herd_->getBestSolution().getMakespan();
+    statistics_.optimal = statistics_.best_makespan <= statistics_.lower_bound;
+    statistics_.budget_exhausted = budget_.wasExhausted() && !isStopRequested();
+    
+    statistics_sink_.close();
+    
+    // Waits for the last checkpoint to reach the disk
+    if (checkpoint_writer_) {
+        checkpoint_writer_->flush();
+        statistics_.checkpoints_written = checkpoint_writer_->getWritten();
+        checkpoint_writer_.reset();
+    }
     
     LOG_INFO("HHOA algorithm completed in " + timer_.getFormattedTime());
 }
@@ -2,11 +2,22 @@
 #define HHOA_H
 
 #include "HorseHerd.h"
+#include "OperatorSelector.h"
+#include "SolveHandle.h"
+#include "StatisticsSink.h"
 #include "../utils/Timer.h"
 #include "../utils/Logger.h"
+#include "../utils/Profiler.h"
+#include "../utils/SearchBudget.h"
 #include <string>
 #include <vector>
 #include <functional>
+#include <atomic>
+#include <array>
+#include <memory>
+
+struct HHOACheckpoint;
+class CheckpointWriter;
 
 /**
  * @brief Parameters for the Horse Herd Optimization Algorithm
@@ -15,6 +26,9 @@ struct HHOAParameters {
     int population_size = 30;           // Size of the horse herd
     int max_iterations = 1000;          // Maximum number of iterations
     double grazing_intensity = 0.5;     // Intensity of grazing behavior
+    GrazingMode grazing_mode = GrazingMode::LOCAL_SEARCH;  // Local search of the grazing phase
+    int destruction_size = 4;           // Jobs removed per iterated-greedy grazing step
+    int parallel_reinsertion_jobs = 0;  // Iterated greedy: jobs from which sweeps are split across threads (0: never)
     double roaming_rate = 0.3;          // Rate of roaming behavior
     double exploration_rate = 0.3;      // Exploration rate for roaming
     double following_rate = 0.7;        // Rate of following the leader
@@ -27,7 +41,24 @@ struct HHOAParameters {
     int elite_count = 3;                // Number of elite horses to improve
     double diversity_threshold = 0.01;  // Minimum diversity threshold
     bool adaptive_parameters = true;    // Use adaptive parameter control
+    bool operator_selection = false;    // Bandit over grazing..mutation: skip operators that stopped improving
+    double selection_decay = 0.8;       // Weight of an operator's previous credit (operator_selection)
+    double min_operator_share = 0.05;   // Share of the iteration budget every operator keeps (operator_selection)
     int termination_patience = 100;     // Iterations without improvement for early termination
+    int num_threads = 1;                // Threads for the per-horse phase loops
+    DiversityMetric diversity_metric = DiversityMetric::ENTROPY;  // Herd diversity measure
+    int evaluation_cache_size = 0;      // Slots of the herd's fingerprint cache (0: disabled)
+    bool record_trace = false;          // Keep one trace event per phase execution (needs HHOA_ENABLE_PROFILING)
+    double random_ratio = 0.8;          // Fraction of the initial herd built randomly (rest: constructive)
+    InitialHeuristic initial_heuristic = InitialHeuristic::NEH;  // Constructive heuristic of the initial herd
+    bool stop_at_lower_bound = true;    // End the run once the best makespan equals the instance's lower bound
+    double time_limit_ms = 0.0;         // Wall-clock budget of a run, initialization included (0: unlimited)
+    long long max_evaluations = 0;      // Makespan evaluation budget of a run (0: unlimited)
+    std::string checkpoint_file;        // Destination of the periodic checkpoints (empty: none)
+    int checkpoint_interval = 0;        // Iterations between two checkpoints (0: disabled)
+    int history_interval = 1;           // Record every k-th iteration in the history (0: only improvements of the best makespan)
+    int history_capacity = static_cast<int>(IterationHistory::kDefaultCapacity);  // Newest records kept in memory (0: unbounded)
+    std::string history_file;           // Stream the recorded iterations to this CSV file while running (empty: none)
     
     /**
      * @brief Print parameters
@@ -39,8 +70,41 @@ struct HHOAParameters {
      * @return True if valid, false otherwise
      */
     bool isValid() const;
+    
+    /**
+     * @brief Time limit scaled with the instance size, as in the flow shop literature
+     * @param num_jobs Number of jobs (n)
+     * @param num_machines Number of machines (m)
+     * @param factor Milliseconds per half job-machine pair (t)
+     * @return n * m / 2 * t milliseconds
+     */
+    static double scaledTimeLimitMs(int num_jobs, int num_machines, double factor);
+};
+
+/**
+ * @brief Phases of an HHOA iteration, in execution order
+ */
+enum class HHOAPhase {
+    GRAZING = 0,
+    ROAMING,
+    FOLLOWING,
+    MATING,
+    MUTATION,
+    AGING,
+    REPLACEMENT,
+    REJUVENATION,
+    ELITE_IMPROVEMENT,
+    DIVERSITY,          // Leader update, diversity measure and preservation
+    COUNT
 };
 
+/**
+ * @brief Display name of a phase
+ * @param phase Phase
+ * @return Static name string
+ */
+const char* phaseName(HHOAPhase phase);
+
 /**
  * @brief Statistics for algorithm execution
  */
@@ -51,9 +115,23 @@ struct HHOAStatistics {
     int rejuvenations = 0;
     int replacements = 0;
     double execution_time_ms = 0.0;
-    std::vector<int> best_makespan_history;
-    std::vector<double> diversity_history;
-    std::vector<double> average_fitness_history;
+    long long cache_hits = 0;           // Batch evaluations answered by the fingerprint cache
+    long long cache_misses = 0;         // Batch evaluations that had to be computed
+    long long evaluations = 0;          // Makespan evaluations of the run (needs HHOA_ENABLE_PROFILING)
+    int lower_bound = 0;                // Lower bound on the makespan (ProblemInstance::getLowerBound)
+    int best_makespan = 0;              // Best makespan of the run
+    bool optimal = false;               // Best makespan equals the lower bound (proven optimal)
+    bool budget_exhausted = false;      // Run ended on its time or evaluation budget
+    int checkpoints_written = 0;        // Checkpoints saved during the run
+    std::array<PhaseProfile, static_cast<int>(HHOAPhase::COUNT)> phases;  // Cost per phase (needs HHOA_ENABLE_PROFILING)
+    std::array<OperatorCredit, OperatorSelector::kNumOperators> operators;  // Per-operator credit (operator_selection only)
+    IterationHistory history;           // Newest recorded iterations (see history_interval and history_capacity)
+    
+    /**
+     * @brief Relative gap between the best makespan and the lower bound
+     * @return 100 * (best_makespan - lower_bound) / lower_bound (0 without a positive bound)
+     */
+    double getOptimalityGap() const;
     
     /**
      * @brief Print statistics
@@ -62,6 +140,11 @@ struct HHOAStatistics {
     
     /**
      * @brief Save statistics to file
+     *
+     * Writes the recorded iterations kept in memory as CSV, followed by the
+     * phase profile as a second CSV block when the run was profiled. Use
+     * history_file to keep every recorded iteration of a long run.
+     *
      * @param filename File to save statistics
      * @return True if successful
      */
@@ -72,16 +155,35 @@ struct HHOAStatistics {
  * @brief Main Horse Herd Optimization Algorithm class
  */
 class HHOA {
+    friend struct HHOABenchmark;  // Microbenchmarks drive single iterations
+    friend class SolveHandle;     // Installs and removes solve_callback_
+
 private:
     std::shared_ptr<ProblemInstance> instance_;
     HHOAParameters parameters_;
     HHOAStatistics statistics_;
     std::unique_ptr<HorseHerd> herd_;
     Timer timer_;
+    long long start_evaluations_ = 0;  // Herd evaluation count when the run started
+    std::vector<TraceEvent> trace_;    // Phase executions (record_trace only)
+    SearchBudget budget_;              // Time and evaluation budget of the current run
+    int next_iteration_ = 0;           // First iteration of optimize() not run yet
+    int end_iteration_ = 0;            // Iteration bound of the current optimize() run
+    int stagnation_count_ = 0;         // Iterations without improvement
+    int loop_best_makespan_ = 0;       // Best makespan seen by the optimize() loop
+    double resumed_time_ms_ = 0.0;     // Execution time before the run was resumed
+    std::unique_ptr<CheckpointWriter> checkpoint_writer_;  // Writes the checkpoints of the current run
+    StatisticsSink statistics_sink_;   // Streams the recorded iterations (history_file only)
+    int history_best_makespan_ = 0;    // Best makespan of the iterations recorded so far
+    OperatorSelector operator_selector_;  // Credit assignment over the operators (operator_selection only)
     
     // Callback functions
     std::function<void(int, const Solution&, const HHOAStatistics&)> iteration_callback_;
     std::function<bool(int, const Solution&)> termination_callback_;
+    std::function<void(int, const Solution&)> improvement_callback_;
+    std::function<void(int, const Solution&)> solve_callback_;  // Hook of the running solveAsync() handle
+    
+    std::atomic<bool> stop_requested_{false};  // Set from other threads to end the current run
 
 public:
     /**
@@ -94,20 +196,50 @@ public:
     /**
      * @brief Destructor
      */
-    ~HHOA() = default;
+    ~HHOA();
 
     // Getters
     const HHOAParameters& getParameters() const { return parameters_; }
+    std::shared_ptr<ProblemInstance> getInstance() const { return instance_; }
     const HHOAStatistics& getStatistics() const { return statistics_; }
     const HorseHerd* getHerd() const { return herd_.get(); }
+    const std::vector<TraceEvent>& getTrace() const { return trace_; }
 
     // Setters
     void setParameters(const HHOAParameters& parameters);
+
+    /**
+     * @brief Solve another instance with the same herd
+     *
+     * The herd keeps its buffers, thread pool and cache slots, so switching
+     * instances between runs avoids the setup cost of a new HHOA.
+     *
+     * @param instance Problem instance of the next runs
+     */
+    void setInstance(std::shared_ptr<ProblemInstance> instance);
     void setIterationCallback(std::function<void(int, const Solution&, const HHOAStatistics&)> callback);
     void setTerminationCallback(std::function<bool(int, const Solution&)> callback);
 
+    /**
+     * @brief Set a callback invoked by optimize() on every new best solution
+     * @param callback Receives the iteration (-1: initial herd) and the new best solution
+     */
+    void setImprovementCallback(std::function<void(int, const Solution&)> callback);
+
     /**
      * @brief Run the optimization algorithm
+     *
+     * The run ends on whichever comes first: max_iterations, the stagnation
+     * patience, the lower bound, or the time and evaluation budgets. The
+     * budgets are also checked between phases and inside the local
+     * searches, so a deadline is missed by at most about one makespan
+     * sweep.
+     *
+     * With checkpoint_file and checkpoint_interval set, the state of the run
+     * is saved every checkpoint_interval iterations by a background thread,
+     * and once more when the run is stopped or runs out of budget, so that
+     * it can be continued with resume().
+     *
      * @return Best solution found
      */
     Solution optimize();
@@ -119,6 +251,21 @@ public:
      */
     Solution optimize(int iterations);
 
+    /**
+     * @brief Continue an optimize() run from a checkpoint
+     *
+     * Restores the herd, the random generator of the calling thread, the
+     * adaptive parameters, the statistics and the loop counters saved in
+     * the checkpoint, then runs the remaining iterations. With the same
+     * number of threads the result is the one the uninterrupted run would
+     * have produced. The threads, trace, budget and checkpoint settings are
+     * kept from this object; the budgets apply to the resumed part only.
+     *
+     * @param filename Checkpoint written during an optimize() run on this instance
+     * @return Best solution found
+     */
+    Solution resume(const std::string& filename);
+
     /**
      * @brief Run the algorithm until a target makespan is reached
      * @param target_makespan Target makespan to achieve
@@ -127,6 +274,40 @@ public:
      */
     Solution optimizeToTarget(int target_makespan, int max_iterations = -1);
 
+    /**
+     * @brief Run optimize() on a new thread
+     *
+     * The returned handle offers the future of the final solution, a
+     * snapshot of the best solution so far, the stream of improvements and
+     * cancellation (see SolveHandle). The solve draws from its own generator,
+     * seeded from the caller's; the improvement callback keeps being called.
+     * A stop requested earlier is cleared, so only cancellations issued from
+     * now on end the solve. This object must outlive the handle and must not
+     * be used while it runs.
+     *
+     * @param queue_capacity Improvements kept before the oldest is dropped
+     * @return Handle of the running solve
+     */
+    SolveHandle solveAsync(size_t queue_capacity = 1024);
+
+    /**
+     * @brief Ask a running optimization to stop as soon as possible
+     *
+     * Thread-safe. The local searches stop at their next move and the
+     * remaining phases of the iteration are skipped. The request stays
+     * active until reset() or solveAsync() is called.
+     */
+    void requestStop() {
+        stop_requested_.store(true, std::memory_order_relaxed);
+        budget_.cancel();
+    }
+
+    /**
+     * @brief Check whether a stop has been requested
+     * @return True if requestStop() was called since the last reset or solveAsync()
+     */
+    bool isStopRequested() const { return stop_requested_.load(std::memory_order_relaxed); }
+
     /**
      * @brief Reset the algorithm state
      */
@@ -144,6 +325,23 @@ public:
      */
     int getBestMakespan() const;
 
+    /**
+     * @brief Get the best solutions of the best horses
+     * @param count Number of solutions
+     * @return Best solutions, best first
+     */
+    std::vector<Solution> getEliteSolutions(int count) const;
+
+    /**
+     * @brief Inject external solutions (e.g. migrants) into the herd
+     *
+     * Safe to call from the iteration callback while optimizing.
+     *
+     * @param solutions Solutions of the same instance
+     * @return Number of horses replaced
+     */
+    int injectSolutions(const std::vector<Solution>& solutions);
+
     /**
      * @brief Print algorithm information
      */
@@ -161,7 +359,47 @@ public:
      */
     bool saveResults(const std::string& filename) const;
 
+    /**
+     * @brief Save the recorded phase executions as a Chrome trace
+     *
+     * Needs record_trace and a build with HHOA_ENABLE_PROFILING; otherwise
+     * the trace holds no events.
+     *
+     * @param filename Output JSON file (chrome://tracing, ui.perfetto.dev)
+     * @return True if successful
+     */
+    bool saveTrace(const std::string& filename) const;
+
 private:
+    /**
+     * @brief Run the optimize() loop from next_iteration_ to end_iteration_
+     * @return Best solution found
+     */
+    Solution runIterations();
+
+    /**
+     * @brief Capture the state between two optimize() iterations
+     * @return Checkpoint of the run
+     */
+    HHOACheckpoint captureCheckpoint() const;
+
+    /**
+     * @brief Restore the state saved by captureCheckpoint
+     * @param checkpoint Checkpoint of a run on this instance
+     */
+    void restoreCheckpoint(const HHOACheckpoint& checkpoint);
+
+    /**
+     * @brief Start the timer, the budget and the evaluation count of a run
+     */
+    void startRun();
+
+    /**
+     * @brief Pass a new best solution to the improvement callback and the solve hook
+     * @param iteration Iteration that found it (-1: initial herd)
+     */
+    void reportImprovement(int iteration);
+
     /**
      * @brief Execute a single iteration of the algorithm
      * @param iteration Current iteration number
@@ -169,6 +407,35 @@ private:
      */
     bool executeIteration(int iteration);
 
+    /**
+     * @brief Run one phase of an iteration, profiling it when compiled in
+     *
+     * Adds the phase's time, evaluations and candidates to the statistics and
+     * records a trace event if requested. Defined in HHOA.cpp.
+     *
+     * @param phase Phase
+     * @param iteration Current iteration
+     * @param body Callable running the phase, returns the accepted candidates
+     * @return Result of the body
+     */
+    template<typename Body>
+    int runPhase(HHOAPhase phase, int iteration, const Body& body);
+
+    /**
+     * @brief Run a search operator phase, subject to operator selection
+     *
+     * Without operator_selection this is runPhase. With it, the selector may
+     * skip the phase, and a run credits the phase with its accepted share of
+     * the candidates it tried.
+     *
+     * @param phase Operator phase (GRAZING to MUTATION)
+     * @param iteration Current iteration
+     * @param body Callable running the phase, returns the accepted candidates
+     * @return Result of the body (0 if skipped)
+     */
+    template<typename Body>
+    int runOperator(HHOAPhase phase, int iteration, const Body& body);
+
     /**
      * @brief Check termination conditions
      * @param iteration Current iteration
@@ -177,6 +444,12 @@ private:
      */
     bool shouldTerminate(int iteration, int stagnation_count) const;
 
+    /**
+     * @brief Check whether the best makespan has reached the lower bound (stop_at_lower_bound only)
+     * @return True if no better solution can exist
+     */
+    bool reachedLowerBound() const;
+
     /**
      * @brief Update adaptive parameters based on current state
      * @param iteration Current iteration
@@ -199,6 +472,11 @@ private:
      */
     void recordStatistics(int iteration, bool improved);
 
+    /**
+     * @brief Apply the herd settings of the parameters to herd_
+     */
+    void configureHerd();
+
     /**
      * @brief Initialize algorithm state
      */
@@ -4,40 +4,47 @@
 #include <algorithm>
 #include <iostream>
 #include <climits>
+#include <atomic>
+
+namespace {
+// Source of revision stamps; shared by all herds and threads
+std::atomic<std::uint64_t> next_revision{1};
+}
 
 Horse::Horse(std::shared_ptr<ProblemInstance> instance)
     : solution_(instance), best_solution_(instance), fitness_(0.0), best_fitness_(0.0),
-      age_(0.0), grazing_ability_(0.8), stamina_(1.0), is_leader_(false), stagnation_counter_(0) {
+      age_(0.0), grazing_ability_(0.8), stamina_(1.0), is_leader_(false), stagnation_counter_(0),
+      revision_(0) {
     initializeRandom();
 }
 
 Horse::Horse(const Solution& solution)
     : solution_(solution), best_solution_(solution), age_(0.0), grazing_ability_(0.8),
-      stamina_(1.0), is_leader_(false), stagnation_counter_(0) {
+      stamina_(1.0), is_leader_(false), stagnation_counter_(0), revision_(0) {
     updateFitness();
     best_fitness_ = fitness_;
 }
 
-Horse::Horse(const Horse& other)
-    : solution_(other.solution_), best_solution_(other.best_solution_),
-      fitness_(other.fitness_), best_fitness_(other.best_fitness_),
-      age_(other.age_), grazing_ability_(other.grazing_ability_),
-      stamina_(other.stamina_), is_leader_(other.is_leader_),
-      stagnation_counter_(other.stagnation_counter_) {}
-
-Horse& Horse::operator=(const Horse& other) {
-    if (this != &other) {
-        solution_ = other.solution_;
-        best_solution_ = other.best_solution_;
-        fitness_ = other.fitness_;
-        best_fitness_ = other.best_fitness_;
-        age_ = other.age_;
-        grazing_ability_ = other.grazing_ability_;
-        stamina_ = other.stamina_;
-        is_leader_ = other.is_leader_;
-        stagnation_counter_ = other.stagnation_counter_;
-    }
-    return *this;
+Horse::Horse(const HorseState& state, std::shared_ptr<ProblemInstance> instance)
+    : solution_(state.sequence, instance), best_solution_(state.best_sequence, instance),
+      fitness_(state.fitness), best_fitness_(state.best_fitness), age_(state.age),
+      grazing_ability_(state.grazing_ability), stamina_(state.stamina), is_leader_(state.is_leader),
+      stagnation_counter_(state.stagnation_counter),
+      revision_(next_revision.fetch_add(1, std::memory_order_relaxed)) {
+}
+
+HorseState Horse::getState() const {
+    HorseState state;
+    state.sequence = solution_.getJobSequence();
+    state.best_sequence = best_solution_.getJobSequence();
+    state.fitness = fitness_;
+    state.best_fitness = best_fitness_;
+    state.age = age_;
+    state.grazing_ability = grazing_ability_;
+    state.stamina = stamina_;
+    state.is_leader = is_leader_;
+    state.stagnation_counter = stagnation_counter_;
+    return state;
 }
 
 void Horse::setSolution(const Solution& solution) {
@@ -50,6 +57,16 @@ void Horse::setSolution(const Solution& solution) {
     }
 }
 
+void Horse::setSolution(Solution&& solution) {
+    solution_ = std::move(solution);
+    updateFitness();
+    if (updateBest()) {
+        resetStagnation();
+    } else {
+        stagnation_counter_++;
+    }
+}
+
 void Horse::initializeRandom() {
     solution_.initializeRandom();
     updateFitness();
@@ -57,6 +74,15 @@ void Horse::initializeRandom() {
     best_fitness_ = fitness_;
 }
 
+void Horse::reinitializeRandom() {
+    age_ = 0.0;
+    grazing_ability_ = 0.8;
+    stamina_ = 1.0;
+    is_leader_ = false;
+    stagnation_counter_ = 0;
+    initializeRandom();
+}
+
 void Horse::initializeGreedy() {
     solution_.initializeGreedy();
     updateFitness();
@@ -66,6 +92,7 @@ void Horse::initializeGreedy() {
 
 void Horse::updateFitness() {
     fitness_ = calculateFitness(solution_.getMakespan());
+    revision_ = next_revision.fetch_add(1, std::memory_order_relaxed);
 }
 
 bool Horse::updateBest() {
@@ -112,13 +139,44 @@ bool Horse::graze(double intensity) {
     return improved;
 }
 
+bool Horse::grazeIteratedGreedy(double intensity, int destruction_size, ThreadPool* pool) {
+    if (intensity <= 0.0 || intensity > 1.0) {
+        throw std::invalid_argument("Intensity must be between 0.0 and 1.0");
+    }
+    
+    double effective_intensity = intensity * grazing_ability_ * stamina_;
+    if (Random::getInstance().randDouble() >= effective_intensity) {
+        return false;
+    }
+    
+    // Descend while the steps improve; equal-makespan reconstructions are kept
+    // too, so the last step can still move the horse across a plateau
+    bool improved = false;
+    while (solution_.applyIteratedGreedy(destruction_size, pool)) {
+        improved = true;
+    }
+    updateFitness();
+    if (improved) {
+        updateBest();
+        LOG_DEBUG("Horse improved through iterated-greedy grazing");
+    }
+    
+    return improved;
+}
+
 Solution Horse::roam(double exploration_rate) {
+    Solution new_solution = solution_;
+    roam(exploration_rate, new_solution);
+    return new_solution;
+}
+
+void Horse::roam(double exploration_rate, Solution& result) {
     if (exploration_rate < 0.0 || exploration_rate > 1.0) {
         throw std::invalid_argument("Exploration rate must be between 0.0 and 1.0");
     }
     
     Random& rng = Random::getInstance();
-    Solution new_solution = solution_;
+    result = solution_;
     
     // Number of moves based on exploration rate
     int num_moves = static_cast<int>(exploration_rate * solution_.getNumJobs() * 0.5);
@@ -127,17 +185,21 @@ Solution Horse::roam(double exploration_rate) {
     for (int i = 0; i < num_moves; ++i) {
         if (rng.randBool(0.5)) {
             // Swap move
-            new_solution = new_solution.createSwapNeighbor();
+            result.applyRandomSwap();
         } else {
             // Insert move
-            new_solution = new_solution.createInsertNeighbor();
+            result.applyRandomInsertion();
         }
     }
-    
-    return new_solution;
 }
 
 Solution Horse::followLeader(const Horse& leader, double following_rate) {
+    Solution new_solution = solution_;
+    followLeader(leader, following_rate, new_solution);
+    return new_solution;
+}
+
+void Horse::followLeader(const Horse& leader, double following_rate, Solution& result) {
     if (following_rate < 0.0 || following_rate > 1.0) {
         throw std::invalid_argument("Following rate must be between 0.0 and 1.0");
     }
@@ -146,13 +208,19 @@ Solution Horse::followLeader(const Horse& leader, double following_rate) {
     
     // Blend current solution with leader's solution
     if (rng.randDouble() < following_rate) {
-        return orderCrossover(solution_, leader.getBestSolution());
+        orderCrossover(solution_, leader.getBestSolution(), result);
     } else {
-        return partiallyMappedCrossover(solution_, leader.getBestSolution());
+        partiallyMappedCrossover(solution_, leader.getBestSolution(), result);
     }
 }
 
 Solution Horse::mateWith(const Horse& mate, double crossover_rate) {
+    Solution offspring = best_solution_;
+    mateWith(mate, crossover_rate, offspring);
+    return offspring;
+}
+
+void Horse::mateWith(const Horse& mate, double crossover_rate, Solution& result) {
     if (crossover_rate < 0.0 || crossover_rate > 1.0) {
         throw std::invalid_argument("Crossover rate must be between 0.0 and 1.0");
     }
@@ -161,13 +229,13 @@ Solution Horse::mateWith(const Horse& mate, double crossover_rate) {
     
     if (rng.randDouble() < crossover_rate) {
         if (rng.randBool()) {
-            return orderCrossover(best_solution_, mate.getBestSolution());
+            orderCrossover(best_solution_, mate.getBestSolution(), result);
         } else {
-            return partiallyMappedCrossover(best_solution_, mate.getBestSolution());
+            partiallyMappedCrossover(best_solution_, mate.getBestSolution(), result);
         }
     } else {
         // Return one of the parents
-        return rng.randBool() ? best_solution_ : mate.getBestSolution();
+        result = rng.randBool() ? best_solution_ : mate.getBestSolution();
     }
 }
 
@@ -181,10 +249,10 @@ void Horse::mutate(double mutation_rate) {
     if (rng.randDouble() < mutation_rate) {
         if (rng.randBool()) {
             // Swap mutation
-            solution_ = solution_.createSwapNeighbor();
+            solution_.applyRandomSwap();
         } else {
             // Insert mutation
-            solution_ = solution_.createInsertNeighbor();
+            solution_.applyRandomInsertion();
         }
         
         updateFitness();
@@ -234,11 +302,11 @@ void Horse::print() const {
 }
 
 double Horse::calculateFitness(int makespan) const {
-    // Use negative makespan as fitness (higher fitness = better solution)
+    // Negative objective value (makespan by default) as fitness (higher fitness = better solution)
     return makespan > 0 ? -static_cast<double>(makespan) : -1000000.0;
 }
 
-Solution Horse::orderCrossover(const Solution& parent1, const Solution& parent2) const {
+void Horse::orderCrossover(const Solution& parent1, const Solution& parent2, Solution& result) const {
     Random& rng = Random::getInstance();
     int size = parent1.getNumJobs();
     
@@ -247,8 +315,11 @@ Solution Horse::orderCrossover(const Solution& parent1, const Solution& parent2)
     int point2 = rng.randInt(0, size - 1);
     if (point1 > point2) std::swap(point1, point2);
     
-    std::vector<int> offspring(size, -1);
-    std::vector<bool> used(size, false);
+    // Per-thread scratch, reused across calls
+    static thread_local std::vector<int> offspring;
+    static thread_local std::vector<char> used;
+    offspring.assign(size, -1);
+    used.assign(size, 0);
     
     // Copy segment from parent1
     for (int i = point1; i <= point2; ++i) {
@@ -295,16 +366,17 @@ Solution Horse::orderCrossover(const Solution& parent1, const Solution& parent2)
         }
     }
     
-    return Solution(offspring, parent1.getInstance());
+    storeOffspring(offspring, parent1, result);
 }
 
-Solution Horse::partiallyMappedCrossover(const Solution& parent1, const Solution& parent2) const {
+void Horse::partiallyMappedCrossover(const Solution& parent1, const Solution& parent2, Solution& result) const {
     Random& rng = Random::getInstance();
     int size = parent1.getNumJobs();
     
     // Simply return a copy of parent1 for now to avoid complexity
     // This is a safer approach until we can implement PMX properly
-    std::vector<int> offspring = parent1.getJobSequence();
+    static thread_local std::vector<int> offspring;
+    offspring.assign(parent1.getJobSequence().begin(), parent1.getJobSequence().end());
     
     // Apply a simple modification: swap a few random positions with parent2
     int num_swaps = rng.randInt(1, std::min(3, size/2));
@@ -324,59 +396,23 @@ Solution Horse::partiallyMappedCrossover(const Solution& parent1, const Solution
         }
     }
     
-    return Solution(offspring, parent1.getInstance());
+    storeOffspring(offspring, parent1, result);
 }
 
-bool Horse::apply2OptSearch() {
-    bool improved = false;
-    int current_makespan = solution_.getMakespan();
-    
-    for (int i = 0; i < solution_.getNumJobs() - 1; ++i) {
-        for (int j = i + 1; j < solution_.getNumJobs(); ++j) {
-            solution_.swapJobs(i, j);
-            
-            int new_makespan = solution_.getMakespan();
-            if (new_makespan < current_makespan) {
-                current_makespan = new_makespan;
-                improved = true;
-                break;  // Take first improvement
-            } else {
-                solution_.swapJobs(i, j);  // Revert
-            }
-        }
-        if (improved) break;
+void Horse::storeOffspring(const std::vector<int>& sequence, const Solution& parent, Solution& offspring) {
+    if (offspring.getInstance() != parent.getInstance()) {
+        offspring = parent;
     }
-    
-    return improved;
+    // Copies into the existing buffer and keeps the cached rows of the common prefix
+    offspring.setJobSequence(sequence);
+}
+
+bool Horse::apply2OptSearch() {
+    // First-improvement sweep over all swap pairs
+    return solution_.apply2Opt(true);
 }
 
 bool Horse::applyInsertionSearch() {
-    bool improved = false;
-    int current_makespan = solution_.getMakespan();
-    
-    auto job_sequence = solution_.getJobSequence();
-    
-    for (int i = 0; i < static_cast<int>(job_sequence.size()); ++i) {
-        for (int j = 0; j < static_cast<int>(job_sequence.size()); ++j) {
-            if (i == j) continue;
-            
-            // Remove job from position i and insert at position j
-            int job = job_sequence[i];
-            auto temp_sequence = job_sequence;
-            temp_sequence.erase(temp_sequence.begin() + i);
-            temp_sequence.insert(temp_sequence.begin() + (j > i ? j - 1 : j), job);
-            
-            Solution temp_solution(temp_sequence, solution_.getInstance());
-            int new_makespan = temp_solution.getMakespan();
-            
-            if (new_makespan < current_makespan) {
-                solution_ = temp_solution;
-                current_makespan = new_makespan;
-                improved = true;
-                return true;  // Take first improvement
-            }
-        }
-    }
-    
-    return improved;
+    // First-improvement sweep over all (remove, reinsert) pairs
+    return solution_.applyInsertionSearch(true);
 }
@@ -3,6 +3,23 @@
 
 #include "../core/Solution.h"
 #include <memory>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief Complete state of a horse, as stored in checkpoints
+ */
+struct HorseState {
+    std::vector<int> sequence;        // Current job sequence
+    std::vector<int> best_sequence;   // Best job sequence found by the horse
+    double fitness = 0.0;             // Current fitness
+    double best_fitness = 0.0;        // Best fitness achieved
+    double age = 0.0;                 // Age of the horse
+    double grazing_ability = 0.0;     // Grazing ability parameter
+    double stamina = 0.0;             // Stamina parameter
+    bool is_leader = false;           // Whether this horse is the leader
+    int stagnation_counter = 0;       // Counter for stagnation
+};
 
 /**
  * @brief Represents an individual horse in the Horse Herd Optimization Algorithm
@@ -10,6 +27,8 @@
  * Each horse represents a solution to the FSSP and has associated behavior parameters.
  */
 class Horse {
+    friend struct HorseBenchmark;  // Microbenchmarks call the crossover operators directly
+
 private:
     Solution solution_;              // Current solution (job sequence)
     Solution best_solution_;         // Best solution found by this horse
@@ -20,6 +39,7 @@ private:
     double stamina_;                 // Stamina parameter
     bool is_leader_;                 // Whether this horse is the leader
     int stagnation_counter_;         // Counter for stagnation
+    std::uint64_t revision_;         // Stamp of the current solution, unique across all horses
 
 public:
     /**
@@ -35,17 +55,15 @@ public:
     explicit Horse(const Solution& solution);
 
     /**
-     * @brief Copy constructor
-     * @param other Horse to copy
+     * @brief Constructor restoring a saved state
+     *
+     * Makespans are recomputed from the sequences; the horse gets a fresh
+     * revision stamp.
+     *
+     * @param state Saved state (see getState)
+     * @param instance Problem instance of the sequences
      */
-    Horse(const Horse& other);
-
-    /**
-     * @brief Assignment operator
-     * @param other Horse to assign
-     * @return Reference to this horse
-     */
-    Horse& operator=(const Horse& other);
+    Horse(const HorseState& state, std::shared_ptr<ProblemInstance> instance);
 
     // Getters
     const Solution& getSolution() const { return solution_; }
@@ -59,9 +77,17 @@ public:
     int getStagnationCounter() const { return stagnation_counter_; }
     int getMakespan() const { return solution_.getMakespan(); }
     int getBestMakespan() const { return best_solution_.getMakespan(); }
+    std::uint64_t getRevision() const { return revision_; }
+
+    /**
+     * @brief Capture the complete state of the horse (for checkpointing)
+     * @return Saved state
+     */
+    HorseState getState() const;
 
     // Setters
     void setSolution(const Solution& solution);
+    void setSolution(Solution&& solution);
     void setLeader(bool is_leader) { is_leader_ = is_leader; }
     void setGrazingAbility(double ability) { grazing_ability_ = ability; }
     void setStamina(double stamina) { stamina_ = stamina; }
@@ -71,6 +97,11 @@ public:
      */
     void initializeRandom();
 
+    /**
+     * @brief Restart the horse in place from a random solution with fresh abilities
+     */
+    void reinitializeRandom();
+
     /**
      * @brief Initialize horse with greedy solution
      */
@@ -78,6 +109,10 @@ public:
 
     /**
      * @brief Update fitness based on current solution
+     *
+     * Also issues a new revision stamp, which lets population statistics
+     * (see PopulationArena) detect which horses changed since they were
+     * last gathered.
      */
     void updateFitness();
 
@@ -94,6 +129,19 @@ public:
      */
     bool graze(double intensity = 0.5);
 
+    /**
+     * @brief Perform iterated-greedy grazing (one destruction-reconstruction step)
+     *
+     * Runs with the same probability as the 2-opt step of graze() and costs
+     * O(d * n * m) (see Solution::applyIteratedGreedy).
+     *
+     * @param intensity Intensity of grazing (0.0 to 1.0)
+     * @param destruction_size Jobs removed and greedily reinserted
+     * @param pool Threads scoring the reinsertion sweeps in chunks (null: calling thread only)
+     * @return True if improvement was found
+     */
+    bool grazeIteratedGreedy(double intensity, int destruction_size, ThreadPool* pool = nullptr);
+
     /**
      * @brief Perform roaming behavior (exploration)
      * @param exploration_rate Rate of exploration (0.0 to 1.0)
@@ -101,6 +149,13 @@ public:
      */
     Solution roam(double exploration_rate = 0.3);
 
+    /**
+     * @brief Perform roaming behavior into caller-provided storage
+     * @param exploration_rate Rate of exploration (0.0 to 1.0)
+     * @param result Output: new solution from roaming (its buffers are reused)
+     */
+    void roam(double exploration_rate, Solution& result);
+
     /**
      * @brief Follow the leader horse
      * @param leader Reference to the leader horse
@@ -109,6 +164,14 @@ public:
      */
     Solution followLeader(const Horse& leader, double following_rate = 0.7);
 
+    /**
+     * @brief Follow the leader horse into caller-provided storage
+     * @param leader Reference to the leader horse
+     * @param following_rate Rate of following (0.0 to 1.0)
+     * @param result Output: new solution following the leader (its buffers are reused)
+     */
+    void followLeader(const Horse& leader, double following_rate, Solution& result);
+
     /**
      * @brief Mate with another horse to produce offspring
      * @param mate Partner horse for mating
@@ -117,6 +180,14 @@ public:
      */
     Solution mateWith(const Horse& mate, double crossover_rate = 0.8);
 
+    /**
+     * @brief Mate with another horse into caller-provided storage
+     * @param mate Partner horse for mating
+     * @param crossover_rate Crossover rate (0.0 to 1.0)
+     * @param result Output: offspring solution (its buffers are reused)
+     */
+    void mateWith(const Horse& mate, double crossover_rate, Solution& result);
+
     /**
      * @brief Apply mutation to the current solution
      * @param mutation_rate Mutation rate (0.0 to 1.0)
@@ -159,8 +230,8 @@ public:
 
 private:
     /**
-     * @brief Calculate fitness from makespan
-     * @param makespan Makespan value
+     * @brief Calculate fitness from the objective value
+     * @param makespan Objective value of the solution (the makespan by default)
      * @return Fitness value
      */
     double calculateFitness(int makespan) const;
@@ -169,17 +240,25 @@ private:
      * @brief Order crossover (OX) operator
      * @param parent1 First parent solution
      * @param parent2 Second parent solution
-     * @return Offspring solution
+     * @param result Output: offspring solution (may alias a parent)
      */
-    Solution orderCrossover(const Solution& parent1, const Solution& parent2) const;
+    void orderCrossover(const Solution& parent1, const Solution& parent2, Solution& result) const;
 
     /**
      * @brief Partially mapped crossover (PMX) operator
      * @param parent1 First parent solution
      * @param parent2 Second parent solution
-     * @return Offspring solution
+     * @param result Output: offspring solution (may alias a parent)
+     */
+    void partiallyMappedCrossover(const Solution& parent1, const Solution& parent2, Solution& result) const;
+
+    /**
+     * @brief Store a job sequence of the parents' instance in an output solution
+     * @param sequence Complete job sequence
+     * @param parent Solution providing the instance
+     * @param offspring Output solution
      */
-    Solution partiallyMappedCrossover(const Solution& parent1, const Solution& parent2) const;
+    static void storeOffspring(const std::vector<int>& sequence, const Solution& parent, Solution& offspring);
 
     /**
      * @brief Apply 2-opt local search
@@ -1,14 +1,20 @@
 #include "HorseHerd.h"
 #include "../utils/Random.h"
+#include "../utils/SearchBudget.h"
 #include "../utils/Logger.h"
 #include <algorithm>
 #include <numeric>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 
 HorseHerd::HorseHerd(std::shared_ptr<ProblemInstance> instance, int herd_size)
-    : instance_(instance), leader_(instance), herd_size_(herd_size), diversity_(0.0), generation_(0) {
+    : instance_(instance), leader_(instance), herd_size_(herd_size), diversity_(0.0), generation_(0),
+      evaluator_(instance), diversity_metric_(DiversityMetric::ENTROPY),
+      initial_heuristic_(InitialHeuristic::NEH), grazing_mode_(GrazingMode::LOCAL_SEARCH),
+      destruction_size_(4), parallel_reinsertion_jobs_(0), attempts_(0),
+      offloaded_evaluations_(0) {
     if (herd_size <= 0) {
         throw std::invalid_argument("Herd size must be positive");
     }
@@ -28,25 +34,49 @@ const Horse& HorseHerd::getBestHorse() const {
     return *best_it;
 }
 
+long long HorseHerd::getEvaluationCount() const {
+    return Profiler::getThreadEvaluations() + offloaded_evaluations_.load(std::memory_order_relaxed);
+}
+
 void HorseHerd::initialize(double random_ratio) {
     if (random_ratio < 0.0 || random_ratio > 1.0) {
         throw std::invalid_argument("Random ratio must be between 0.0 and 1.0");
     }
     
     horses_.clear();
+    if (evaluation_cache_) {
+        evaluation_cache_->clear();
+    }
     Random& rng = Random::getInstance();
     
     int num_random = static_cast<int>(herd_size_ * random_ratio);
     int num_greedy = herd_size_ - num_random;
     
-    LOG_INFO("Initializing herd with " + std::to_string(num_random) + 
-             " random and " + std::to_string(num_greedy) + " greedy horses");
+    LOG_INFO("Initializing herd with " + std::to_string(num_random) + " random and " +
+             std::to_string(num_greedy) + (initial_heuristic_ == InitialHeuristic::NEH ? " NEH" : " greedy") +
+             " horses");
     
     // Create random horses
     for (int i = 0; i < num_random; ++i) {
         Horse horse(instance_);
         horse.initializeRandom();
-        horses_.push_back(horse);
+        horses_.push_back(std::move(horse));
+    }
+    
+    // Constructive horses: plain NEH first, then randomized variants
+    if (initial_heuristic_ == InitialHeuristic::NEH) {
+        for (int i = 0; i < num_greedy; ++i) {
+            Solution solution(instance_);
+            if (i == 0) {
+                solution.initializeNEH();
+            } else if (i % 2 == 1) {
+                solution.initializeRandomizedNEH(0.0);
+            } else {
+                solution.initializeRandomizedNEH(std::min(0.5, 0.05 * i));
+            }
+            horses_.emplace_back(solution);
+        }
+        num_greedy = 0;
     }
     
     // Create greedy horses with some variation
@@ -59,16 +89,75 @@ void HorseHerd::initialize(double random_ratio) {
             horse.mutate(0.1 * i);  // Increasing mutation rate
         }
         
-        horses_.push_back(horse);
+        horses_.push_back(std::move(horse));
     }
     
-    // Update leader
+    // Update leader: only from this herd, never one left over from an earlier run
+    leader_ = horses_.front();
+    leader_.setLeader(true);
     updateLeader();
     calculateDiversity();
     
     LOG_INFO("Herd initialized. Best makespan: " + std::to_string(getBestHorse().getBestMakespan()));
 }
 
+void HorseHerd::setInstance(std::shared_ptr<ProblemInstance> instance) {
+    if (!instance || !instance->isValid()) {
+        throw std::invalid_argument("Invalid problem instance");
+    }
+    if (instance == instance_) {
+        return;
+    }
+    
+    // The buffers of the herd (pool, arena, candidates, cache slots) are kept
+    instance_ = instance;
+    evaluator_ = MakespanEvaluator(instance_);
+    evaluator_.setCache(evaluation_cache_.get());
+    if (evaluation_cache_) {
+        evaluation_cache_->clear();
+    }
+    horses_.clear();
+    leader_ = Horse(Solution(instance_));
+    diversity_ = 0.0;
+    generation_ = 0;
+}
+
+HerdState HorseHerd::getState() const {
+    HerdState state;
+    state.generation = generation_;
+    state.diversity = diversity_;
+    state.horses.reserve(horses_.size());
+    for (const auto& horse : horses_) {
+        state.horses.push_back(horse.getState());
+    }
+    state.leader = leader_.getState();
+    return state;
+}
+
+void HorseHerd::restoreState(const HerdState& state) {
+    if (state.horses.size() != static_cast<size_t>(herd_size_)) {
+        throw std::invalid_argument("Herd state size does not match herd size");
+    }
+    
+    horses_.clear();
+    if (evaluation_cache_) {
+        evaluation_cache_->clear();
+    }
+    for (const auto& horse_state : state.horses) {
+        horses_.emplace_back(horse_state, instance_);
+    }
+    leader_ = Horse(state.leader, instance_);
+    generation_ = state.generation;
+    diversity_ = state.diversity;
+    
+    // Score the restored sequences now rather than inside the first phase
+    for (const auto& horse : horses_) {
+        horse.getMakespan();
+        horse.getBestMakespan();
+    }
+    leader_.getBestMakespan();
+}
+
 bool HorseHerd::updateLeader() {
     if (horses_.empty()) {
         return false;
@@ -107,12 +196,22 @@ double HorseHerd::calculateDiversity() {
         return diversity_;
     }
     
+    // Only horses that changed since the last call are re-gathered
+    arena_.gatherSequences(horses_);
+    
+    if (diversity_metric_ == DiversityMetric::ENTROPY) {
+        diversity_ = arena_.positionEntropy();
+        return diversity_;
+    }
+    
+    // Pairwise distances over the contiguous permutation array
     double total_distance = 0.0;
     int comparisons = 0;
+    int num_horses = arena_.getNumHorses();
     
-    for (size_t i = 0; i < horses_.size(); ++i) {
-        for (size_t j = i + 1; j < horses_.size(); ++j) {
-            total_distance += calculateDistance(horses_[i].getSolution(), horses_[j].getSolution());
+    for (int i = 0; i < num_horses; ++i) {
+        for (int j = i + 1; j < num_horses; ++j) {
+            total_distance += static_cast<double>(arena_.hammingDistance(i, j)) / arena_.getNumJobs();
             comparisons++;
         }
     }
@@ -121,14 +220,115 @@ double HorseHerd::calculateDiversity() {
     return diversity_;
 }
 
-int HorseHerd::performGrazing(double intensity) {
-    int improved_count = 0;
+void HorseHerd::setNumThreads(int num_threads) {
+    if (num_threads < 1) {
+        throw std::invalid_argument("Number of threads must be positive");
+    }
     
-    for (auto& horse : horses_) {
-        if (horse.graze(intensity)) {
-            improved_count++;
+    if (num_threads == getNumThreads()) {
+        return;
+    }
+    
+    thread_pool_ = num_threads > 1 ? std::make_unique<ThreadPool>(num_threads) : nullptr;
+}
+
+void HorseHerd::setGrazingMode(GrazingMode mode, int destruction_size, int parallel_reinsertion_jobs) {
+    if (destruction_size < 1) {
+        throw std::invalid_argument("Destruction size must be positive");
+    }
+    if (parallel_reinsertion_jobs < 0) {
+        throw std::invalid_argument("Parallel reinsertion threshold must be non-negative");
+    }
+    
+    grazing_mode_ = mode;
+    destruction_size_ = destruction_size;
+    parallel_reinsertion_jobs_ = parallel_reinsertion_jobs;
+}
+
+template<typename Body>
+void HorseHerd::forEachHorse(const Body& body, bool parallel) {
+    int num_horses = horses_.size();
+    
+    // One stream per horse and phase: results do not depend on the thread count
+    std::uint64_t phase_seed = Random::getInstance().nextSeed();
+    SearchBudget* budget = SearchBudget::current();
+#ifdef HHOA_ENABLE_PROFILING
+    std::thread::id caller = std::this_thread::get_id();
+#endif
+    auto run_horse = [&](int i) {
+        Random horse_rng(phase_seed, i);
+        Random::Binding binding(horse_rng);
+        SearchBudget::Binding budget_binding(budget);  // Workers charge the caller's budget
+#ifdef HHOA_ENABLE_PROFILING
+        // The caller's counter already sees its own share of the horses
+        if (std::this_thread::get_id() != caller) {
+            long long evaluations = Profiler::getThreadEvaluations();
+            body(i);
+            offloaded_evaluations_.fetch_add(Profiler::getThreadEvaluations() - evaluations,
+                                             std::memory_order_relaxed);
+            return;
+        }
+#endif
+        body(i);
+    };
+    
+    if (thread_pool_ && parallel) {
+        thread_pool_->parallelFor(num_horses, run_horse);
+    } else {
+        for (int i = 0; i < num_horses; ++i) {
+            run_horse(i);
         }
     }
+}
+
+void HorseHerd::loadCandidates() {
+    if (candidates_.size() > horses_.size()) {
+        candidates_.erase(candidates_.begin() + horses_.size(), candidates_.end());
+    }
+    
+    for (size_t i = 0; i < horses_.size(); ++i) {
+        if (i < candidates_.size()) {
+            candidates_[i] = horses_[i].getSolution();  // Reuses the existing sequence buffer
+        } else {
+            candidates_.push_back(horses_[i].getSolution());
+        }
+    }
+}
+
+void HorseHerd::setEvaluationCacheSize(int capacity) {
+    if (capacity < 0) {
+        throw std::invalid_argument("Cache capacity must be non-negative");
+    }
+    
+    int current = evaluation_cache_ ? evaluation_cache_->getCapacity() : 0;
+    if (capacity == 0) {
+        evaluation_cache_.reset();
+    } else if (capacity > current || capacity <= current / 2) {
+        // Capacities are rounded up to a power of two
+        evaluation_cache_ = std::make_unique<EvaluationCache>(capacity);
+    }
+    evaluator_.setCache(evaluation_cache_.get());
+}
+
+int HorseHerd::performGrazing(double intensity) {
+    flags_.assign(horses_.size(), 0);
+    
+    if (grazing_mode_ == GrazingMode::ITERATED_GREEDY) {
+        // Large instances: one horse at a time, its sweeps split across the threads
+        bool chunked = thread_pool_ && parallel_reinsertion_jobs_ > 0 &&
+                       instance_->getNumJobs() >= parallel_reinsertion_jobs_;
+        ThreadPool* pool = chunked ? thread_pool_.get() : nullptr;
+        forEachHorse([&](int i) {
+            flags_[i] = horses_[i].grazeIteratedGreedy(intensity, destruction_size_, pool);
+        }, !chunked);
+    } else {
+        forEachHorse([&](int i) {
+            flags_[i] = horses_[i].graze(intensity);
+        });
+    }
+    
+    int improved_count = std::count(flags_.begin(), flags_.end(), 1);
+    attempts_ += horses_.size();
     
     if (improved_count > 0) {
         updateLeader();
@@ -139,17 +339,27 @@ int HorseHerd::performGrazing(double intensity) {
 }
 
 int HorseHerd::performRoaming(double roaming_rate, double exploration_rate) {
-    Random& rng = Random::getInstance();
     int roamed_count = 0;
     
-    for (auto& horse : horses_) {
-        if (rng.randDouble() < roaming_rate) {
-            Solution new_solution = horse.roam(exploration_rate);
-            
-            if (new_solution.getMakespan() < horse.getSolution().getMakespan()) {
-                horse.setSolution(new_solution);
-                roamed_count++;
-            }
+    // Collect all roaming candidates, then score them in one batch.
+    // Horses that do not roam keep a copy of their (already evaluated) solution.
+    flags_.assign(horses_.size(), 0);
+    loadCandidates();
+    
+    forEachHorse([&](int i) {
+        if (Random::getInstance().randDouble() < roaming_rate) {
+            horses_[i].roam(exploration_rate, candidates_[i]);
+            flags_[i] = 1;
+        }
+    });
+    
+    evaluator_.evaluate(candidates_);
+    attempts_ += std::count(flags_.begin(), flags_.end(), 1);
+    
+    for (size_t i = 0; i < horses_.size(); ++i) {
+        if (flags_[i] && candidates_[i].getMakespan() < horses_[i].getSolution().getMakespan()) {
+            horses_[i].setSolution(candidates_[i]);
+            roamed_count++;
         }
     }
     
@@ -164,14 +374,24 @@ int HorseHerd::performRoaming(double roaming_rate, double exploration_rate) {
 int HorseHerd::performFollowing(double following_rate) {
     int followed_count = 0;
     
-    for (auto& horse : horses_) {
-        if (!horse.isLeader()) {
-            Solution new_solution = horse.followLeader(leader_, following_rate);
-            
-            if (new_solution.getMakespan() < horse.getSolution().getMakespan()) {
-                horse.setSolution(new_solution);
-                followed_count++;
-            }
+    // Collect all followers' candidates, then score them in one batch
+    flags_.assign(horses_.size(), 0);
+    loadCandidates();
+    
+    forEachHorse([&](int i) {
+        if (!horses_[i].isLeader()) {
+            horses_[i].followLeader(leader_, following_rate, candidates_[i]);
+            flags_[i] = 1;
+        }
+    });
+    
+    evaluator_.evaluate(candidates_);
+    attempts_ += std::count(flags_.begin(), flags_.end(), 1);
+    
+    for (size_t i = 0; i < horses_.size(); ++i) {
+        if (flags_[i] && candidates_[i].getMakespan() < horses_[i].getSolution().getMakespan()) {
+            horses_[i].setSolution(candidates_[i]);
+            followed_count++;
         }
     }
     
@@ -184,11 +404,14 @@ int HorseHerd::performFollowing(double following_rate) {
 }
 
 int HorseHerd::performMating(double mating_rate, double crossover_rate) {
-    Random& rng = Random::getInstance();
     int offspring_count = 0;
     
     int num_matings = static_cast<int>(horses_.size() * mating_rate / 2);
     
+    // Breed all offspring from the current herd into the first candidate slots,
+    // then score them in one batch (untouched candidates keep their cached makespan)
+    loadCandidates();
+    
     for (int i = 0; i < num_matings; ++i) {
         // Select two parents using tournament selection
         int parent1_idx = tournamentSelection();
@@ -199,15 +422,21 @@ int HorseHerd::performMating(double mating_rate, double crossover_rate) {
             parent2_idx = tournamentSelection();
         }
         
-        // Create offspring
-        Solution offspring = horses_[parent1_idx].mateWith(horses_[parent2_idx], crossover_rate);
+        horses_[parent1_idx].mateWith(horses_[parent2_idx], crossover_rate, candidates_[i]);
+    }
+    
+    evaluator_.evaluate(candidates_);
+    attempts_ += num_matings;
+    
+    for (int i = 0; i < num_matings; ++i) {
+        const Solution& child = candidates_[i];
         
         // Replace a weak horse with offspring if offspring is better
-        auto weak_indices = selectForReplacement(1);
+        const auto& weak_indices = selectForReplacement(1);
         if (!weak_indices.empty()) {
             int weak_idx = weak_indices[0];
-            if (offspring.getMakespan() < horses_[weak_idx].getSolution().getMakespan()) {
-                horses_[weak_idx].setSolution(offspring);
+            if (child.getMakespan() < horses_[weak_idx].getSolution().getMakespan()) {
+                horses_[weak_idx].setSolution(child);
                 offspring_count++;
             }
         }
@@ -222,16 +451,16 @@ int HorseHerd::performMating(double mating_rate, double crossover_rate) {
 }
 
 int HorseHerd::performMutation(double mutation_rate) {
-    int mutated_count = 0;
+    flags_.assign(horses_.size(), 0);
     
-    for (auto& horse : horses_) {
-        int old_makespan = horse.getSolution().getMakespan();
-        horse.mutate(mutation_rate);
-        
-        if (horse.getSolution().getMakespan() < old_makespan) {
-            mutated_count++;
-        }
-    }
+    forEachHorse([&](int i) {
+        int old_makespan = horses_[i].getSolution().getMakespan();
+        horses_[i].mutate(mutation_rate);
+        flags_[i] = horses_[i].getSolution().getMakespan() < old_makespan;
+    });
+    
+    int mutated_count = std::count(flags_.begin(), flags_.end(), 1);
+    attempts_ += horses_.size();
     
     if (mutated_count > 0) {
         updateLeader();
@@ -251,11 +480,13 @@ int HorseHerd::replaceWeakHorses(double replacement_rate) {
     int num_replacements = static_cast<int>(horses_.size() * replacement_rate);
     if (num_replacements == 0) return 0;
     
-    auto weak_indices = selectForReplacement(num_replacements);
+    const auto& weak_indices = selectForReplacement(num_replacements);
     
+    // Restart in place: the horses keep their sequence buffers
     for (int idx : weak_indices) {
-        horses_[idx] = createRandomHorse();
+        horses_[idx].reinitializeRandom();
     }
+    attempts_ += num_replacements;
     
     updateLeader();
     LOG_DEBUG("Replaced " + std::to_string(num_replacements) + " weak horses");
@@ -273,6 +504,7 @@ int HorseHerd::rejuvenateStagnantHorses(int max_stagnation) {
             rejuvenated_count++;
         }
     }
+    attempts_ += horses_.size();
     
     if (rejuvenated_count > 0) {
         updateLeader();
@@ -283,21 +515,25 @@ int HorseHerd::rejuvenateStagnantHorses(int max_stagnation) {
 }
 
 int HorseHerd::improveElite(int num_horses) {
-    sortByFitness();
+    // Rank by index instead of reordering the herd
+    arena_.gatherScalars(horses_);
+    const std::vector<int>& order = arena_.rankByFitness();
     int improved_count = 0;
     
     int elite_count = std::min(num_horses, static_cast<int>(horses_.size()));
     
-    for (int i = 0; i < elite_count; ++i) {
-        int old_makespan = horses_[i].getBestMakespan();
+    for (int rank = 0; rank < elite_count; ++rank) {
+        Horse& horse = horses_[order[rank]];
+        int old_makespan = horse.getBestMakespan();
         
         // Apply intensive local search
-        horses_[i].graze(0.9);  // High intensity grazing
+        horse.graze(0.9);  // High intensity grazing
         
-        if (horses_[i].getBestMakespan() < old_makespan) {
+        if (horse.getBestMakespan() < old_makespan) {
             improved_count++;
         }
     }
+    attempts_ += elite_count;
     
     if (improved_count > 0) {
         updateLeader();
@@ -307,6 +543,50 @@ int HorseHerd::improveElite(int num_horses) {
     return improved_count;
 }
 
+std::vector<Solution> HorseHerd::getEliteSolutions(int count) const {
+    std::vector<int> order(horses_.size());
+    std::iota(order.begin(), order.end(), 0);
+    
+    count = std::min(count, static_cast<int>(horses_.size()));
+    std::partial_sort(order.begin(), order.begin() + count, order.end(),
+        [this](int a, int b) {
+            return horses_[a].getBestFitness() > horses_[b].getBestFitness();
+        });
+    
+    std::vector<Solution> elite;
+    elite.reserve(count);
+    for (int i = 0; i < count; ++i) {
+        elite.push_back(horses_[order[i]].getBestSolution());
+    }
+    
+    return elite;
+}
+
+int HorseHerd::acceptMigrants(const std::vector<Solution>& migrants) {
+    int accepted = 0;
+    
+    for (const Solution& migrant : migrants) {
+        const auto& weak_indices = selectForReplacement(1);
+        if (weak_indices.empty()) {
+            break;
+        }
+        
+        int weak_idx = weak_indices[0];
+        if (migrant.getMakespan() < horses_[weak_idx].getBestMakespan()) {
+            horses_[weak_idx] = Horse(migrant);
+            accepted++;
+        }
+        attempts_++;
+    }
+    
+    if (accepted > 0) {
+        updateLeader();
+        LOG_DEBUG("Accepted " + std::to_string(accepted) + " migrants");
+    }
+    
+    return accepted;
+}
+
 std::string HorseHerd::getStatistics() const {
     std::ostringstream oss;
     
@@ -345,7 +625,15 @@ void HorseHerd::printDetailed() const {
 }
 
 void HorseHerd::sortByFitness() {
-    std::sort(horses_.begin(), horses_.end(), std::greater<Horse>());
+    arena_.gatherScalars(horses_);
+    const std::vector<int>& order = arena_.rankByFitness();
+    
+    // Apply the ranking with moves (no solution is copied)
+    reordered_.clear();
+    for (int idx : order) {
+        reordered_.push_back(std::move(horses_[idx]));
+    }
+    horses_.swap(reordered_);
 }
 
 Solution HorseHerd::getBestSolution() const {
@@ -393,30 +681,7 @@ int HorseHerd::tournamentSelection(int tournament_size) {
     return best_idx;
 }
 
-std::vector<int> HorseHerd::selectForReplacement(int num_horses) {
-    std::vector<std::pair<double, int>> fitness_indices;
-    
-    for (size_t i = 0; i < horses_.size(); ++i) {
-        fitness_indices.emplace_back(horses_[i].getBestFitness(), i);
-    }
-    
-    // Sort by fitness (worst first)
-    std::sort(fitness_indices.begin(), fitness_indices.end());
-    
-    std::vector<int> indices;
-    for (int i = 0; i < std::min(num_horses, static_cast<int>(fitness_indices.size())); ++i) {
-        indices.push_back(fitness_indices[i].second);
-    }
-    
-    return indices;
-}
-
-Horse HorseHerd::createRandomHorse() {
-    Horse horse(instance_);
-    horse.initializeRandom();
-    return horse;
-}
-
-double HorseHerd::calculateDistance(const Solution& sol1, const Solution& sol2) const {
-    return static_cast<double>(sol1.distanceTo(sol2)) / sol1.getNumJobs();
+const std::vector<int>& HorseHerd::selectForReplacement(int num_horses) {
+    arena_.gatherScalars(horses_);
+    return arena_.selectWorst(num_horses);
 }
@@ -2,8 +2,49 @@
 #define HORSE_HERD_H
 
 #include "Horse.h"
+#include "PopulationArena.h"
+#include "../core/MakespanEvaluator.h"
+#include "../core/EvaluationCache.h"
+#include "../utils/ThreadPool.h"
+#include "../utils/Profiler.h"
 #include <vector>
 #include <memory>
+#include <functional>
+#include <atomic>
+
+/**
+ * @brief Herd diversity measures
+ */
+enum class DiversityMetric {
+    ENTROPY = 0,  // Position-frequency entropy, updated incrementally in O(changed * n)
+    HAMMING = 1   // Mean pairwise normalized Hamming distance, O(P^2 * n)
+};
+
+/**
+ * @brief Constructive heuristics for the non-random part of the initial herd
+ */
+enum class InitialHeuristic {
+    NEH = 0,  // NEH, then randomized NEH variants (random tie-breaking, perturbed job orders)
+    SPT = 1   // Shortest total processing time first, increasingly mutated copies
+};
+
+/**
+ * @brief Local search run by the grazing phase
+ */
+enum class GrazingMode {
+    LOCAL_SEARCH = 0,     // First-improvement 2-opt and insertion sweeps (Horse::graze)
+    ITERATED_GREEDY = 1   // Destruction-reconstruction of d jobs (Horse::grazeIteratedGreedy)
+};
+
+/**
+ * @brief Complete state of a herd, as stored in checkpoints
+ */
+struct HerdState {
+    int generation = 0;              // Current generation number
+    double diversity = 0.0;          // Current diversity measure
+    std::vector<HorseState> horses;  // Horses in herd order
+    HorseState leader;               // Leader horse
+};
 
 /**
  * @brief Manages a herd of horses in the Horse Herd Optimization Algorithm
@@ -16,6 +57,20 @@ private:
     int herd_size_;                               // Size of the herd
     double diversity_;                            // Current diversity measure
     int generation_;                              // Current generation number
+    MakespanEvaluator evaluator_;                 // Batch evaluator for phase offspring
+    std::unique_ptr<ThreadPool> thread_pool_;     // Workers for per-horse phase loops (null: sequential)
+    std::vector<Solution> candidates_;            // Scratch: phase candidates, one per horse
+    std::vector<char> flags_;                     // Scratch: per-horse phase flags
+    PopulationArena arena_;                       // Contiguous snapshot for ranking, replacement and diversity
+    std::vector<Horse> reordered_;                // Scratch: destination of sortByFitness
+    DiversityMetric diversity_metric_;            // Measure computed by calculateDiversity
+    InitialHeuristic initial_heuristic_;          // Constructive heuristic used by initialize
+    GrazingMode grazing_mode_;                    // Local search of performGrazing
+    int destruction_size_;                        // Jobs removed per iterated-greedy step
+    int parallel_reinsertion_jobs_;               // Jobs from which reinsertion sweeps are split across threads (0: never)
+    std::unique_ptr<EvaluationCache> evaluation_cache_;  // Fingerprint cache of the batch evaluations (null: disabled)
+    long long attempts_;                          // Candidates tried by the phases so far
+    std::atomic<long long> offloaded_evaluations_;  // Evaluations run by pool workers for this herd
 
 public:
     /**
@@ -38,13 +93,101 @@ public:
     double getDiversity() const { return diversity_; }
     int getGeneration() const { return generation_; }
     std::shared_ptr<ProblemInstance> getInstance() const { return instance_; }
+    int getNumThreads() const { return thread_pool_ ? thread_pool_->getNumThreads() : 1; }
+    DiversityMetric getDiversityMetric() const { return diversity_metric_; }
+    InitialHeuristic getInitialHeuristic() const { return initial_heuristic_; }
+    GrazingMode getGrazingMode() const { return grazing_mode_; }
+    int getDestructionSize() const { return destruction_size_; }
+    const EvaluationCache* getEvaluationCache() const { return evaluation_cache_.get(); }
+    long long getAttemptCount() const { return attempts_; }
+
+    /**
+     * @brief Makespan evaluations attributed to this herd, as seen from the calling thread
+     *
+     * The calling thread's own counter plus the evaluations that the thread
+     * pool ran on other threads. Only differences taken on the thread that
+     * drives the herd are meaningful; always 0 without HHOA_ENABLE_PROFILING.
+     *
+     * @return Evaluation count
+     */
+    long long getEvaluationCount() const;
+
+    // Setters
+    void setDiversityMetric(DiversityMetric metric) { diversity_metric_ = metric; }
+    void setInitialHeuristic(InitialHeuristic heuristic) { initial_heuristic_ = heuristic; }
+
+    /**
+     * @brief Select the local search of the grazing phase
+     *
+     * With ITERATED_GREEDY and a thread pool, instances of at least
+     * parallel_reinsertion_jobs jobs graze one horse at a time and split each
+     * reinsertion sweep across the threads instead; the results are the same
+     * either way. The head and tail build of a sweep stays serial (about 58%
+     * of a reinsertion at 500x20), so this only pays off when there are
+     * fewer horses than threads.
+     *
+     * @param mode Grazing mode
+     * @param destruction_size Jobs removed per iterated-greedy step (at least 1)
+     * @param parallel_reinsertion_jobs Job count from which sweeps are split (0: never)
+     */
+    void setGrazingMode(GrazingMode mode, int destruction_size = 4, int parallel_reinsertion_jobs = 0);
+
+    /**
+     * @brief Set the number of threads used by the per-horse phase loops
+     *
+     * Every horse draws from its own random stream during a phase, so results
+     * for a fixed seed are identical for any number of threads.
+     *
+     * @param num_threads Number of threads (1 runs the phases sequentially)
+     */
+    void setNumThreads(int num_threads);
+
+    /**
+     * @brief Enable the fingerprint cache of the batch evaluations
+     *
+     * All horses of the herd share the cache; candidates that regenerate an
+     * already scored permutation skip the makespan evaluation.
+     *
+     * @param capacity Number of cache slots (0 disables the cache)
+     */
+    void setEvaluationCacheSize(int capacity);
 
     /**
      * @brief Initialize the herd
-     * @param random_ratio Ratio of horses initialized randomly (vs greedy)
+     *
+     * The non-random horses come from the configured constructive heuristic.
+     * With NEH, the first one is plain NEH and the others alternate between
+     * NEH with random tie-breaking and NEH from increasingly perturbed job
+     * orders, so that they do not all start from the same permutation.
+     *
+     * @param random_ratio Ratio of horses initialized randomly (vs constructive)
      */
     void initialize(double random_ratio = 0.8);
 
+    /**
+     * @brief Move the herd to another instance, keeping its buffers and thread pool
+     *
+     * The horses are discarded; call initialize before the next run.
+     *
+     * @param instance New problem instance
+     */
+    void setInstance(std::shared_ptr<ProblemInstance> instance);
+
+    /**
+     * @brief Capture the horses, the leader and the generation (for checkpointing)
+     * @return Saved state
+     */
+    HerdState getState() const;
+
+    /**
+     * @brief Replace the herd with a saved state
+     *
+     * Clears the evaluation cache, like initialize.
+     *
+     * @param state Saved state with herd size horses of this instance
+     */
+    void restoreState(const HerdState& state);
+
     /**
      * @brief Update the leader based on fitness
      * @return True if leader changed
@@ -52,8 +195,8 @@ public:
     bool updateLeader();
 
     /**
-     * @brief Calculate diversity of the herd
-     * @return Diversity measure
+     * @brief Calculate diversity of the herd with the configured metric
+     * @return Diversity measure in [0, 1]
      */
     double calculateDiversity();
 
@@ -120,6 +263,24 @@ public:
      */
     int improveElite(int num_horses = 3);
 
+    /**
+     * @brief Get the best solutions of the best horses
+     * @param count Number of solutions
+     * @return Best solutions, best first
+     */
+    std::vector<Solution> getEliteSolutions(int count) const;
+
+    /**
+     * @brief Replace the weakest horses with immigrant solutions
+     *
+     * Each migrant replaces the currently weakest horse if it is better than
+     * that horse's best solution.
+     *
+     * @param migrants Immigrant solutions of the same instance
+     * @return Number of horses replaced
+     */
+    int acceptMigrants(const std::vector<Solution>& migrants);
+
     /**
      * @brief Get statistics of the herd
      * @return Statistics string
@@ -175,23 +336,33 @@ private:
     /**
      * @brief Select horses for replacement (worst first)
      * @param num_horses Number of horses to select
-     * @return Vector of horse indices
+     * @return Horse indices (valid until the next arena query)
      */
-    std::vector<int> selectForReplacement(int num_horses);
+    const std::vector<int>& selectForReplacement(int num_horses);
 
     /**
-     * @brief Create a new random horse
-     * @return New horse
+     * @brief Run a per-horse phase body for every horse
+     *
+     * Runs on the thread pool when one is configured, with the horse's own
+     * random stream bound to the executing thread; the leader and the
+     * statistics must only be updated after it returns.
+     *
+     * Templated on the body so that phase lambdas are not wrapped in a
+     * heap-allocated std::function; only used inside HorseHerd.cpp.
+     *
+     * @param body Callable invoked with each horse index
+     * @param parallel False runs the horses in order on the calling thread
+     *                 (same streams, so the same results)
      */
-    Horse createRandomHorse();
+    template<typename Body>
+    void forEachHorse(const Body& body, bool parallel = true);
 
     /**
-     * @brief Calculate distance between two solutions
-     * @param sol1 First solution
-     * @param sol2 Second solution
-     * @return Distance measure
+     * @brief Load a copy of every horse's current solution into candidates_
+     *
+     * Reuses the candidate buffers of earlier generations.
      */
-    double calculateDistance(const Solution& sol1, const Solution& sol2) const;
+    void loadCandidates();
 };
 
 #endif // HORSE_HERD_H
@@ -0,0 +1,241 @@
+#include "IslandHHOA.h"
+#include "../utils/Random.h"
+#include <iostream>
+#include <thread>
+#include <exception>
+#include <stdexcept>
+
+void IslandParameters::print() const {
+    std::cout << "Island Parameters:" << std::endl;
+    std::cout << "  Islands: " << num_islands << std::endl;
+    std::cout << "  Migration Interval: " << migration_interval << std::endl;
+    std::cout << "  Migration Size: " << migration_size << std::endl;
+    std::cout << "  Topology: " << (topology == MigrationTopology::RING ? "Ring" : "Random") << std::endl;
+}
+
+bool IslandParameters::isValid() const {
+    return num_islands > 0 && migration_interval > 0 &&
+           migration_size >= 0 && mailbox_capacity > 0;
+}
+
+IslandHHOA::IslandHHOA(std::shared_ptr<ProblemInstance> instance,
+                       const HHOAParameters& parameters,
+                       const IslandParameters& island_parameters)
+    : instance_(instance), island_parameters_(island_parameters) {
+    if (!island_parameters_.isValid()) {
+        throw std::invalid_argument("Invalid island parameters");
+    }
+    setup(std::vector<HHOAParameters>(island_parameters_.num_islands, parameters));
+}
+
+IslandHHOA::IslandHHOA(std::shared_ptr<ProblemInstance> instance,
+                       const std::vector<HHOAParameters>& parameters,
+                       const IslandParameters& island_parameters)
+    : instance_(instance), island_parameters_(island_parameters) {
+    if (!island_parameters_.isValid()) {
+        throw std::invalid_argument("Invalid island parameters");
+    }
+    if (parameters.size() != static_cast<size_t>(island_parameters_.num_islands)) {
+        throw std::invalid_argument("One parameter set per island is required");
+    }
+    setup(parameters);
+}
+
+const HHOA& IslandHHOA::getIsland(int island) const {
+    if (island < 0 || island >= getNumIslands()) {
+        throw std::out_of_range("Invalid island index");
+    }
+    return *islands_[island];
+}
+
+const HHOAStatistics& IslandHHOA::getIslandStatistics(int island) const {
+    return getIsland(island).getStatistics();
+}
+
+Solution IslandHHOA::optimize() {
+    int num_islands = getNumIslands();
+    std::uint64_t seed = island_parameters_.seed != 0 ? island_parameters_.seed
+                                                       : Random::getInstance().nextSeed();
+    
+    LOG_INFO("Starting island HHOA with " + std::to_string(num_islands) + " islands");
+    
+    std::fill(migrants_sent_.begin(), migrants_sent_.end(), 0);
+    std::fill(migrants_accepted_.begin(), migrants_accepted_.end(), 0);
+    {
+        std::lock_guard<std::mutex> lock(best_mutex_);
+        best_migrant_ = Migrant{};
+    }
+    for (auto& island : islands_) {
+        island->reset();
+    }
+    
+    std::vector<std::exception_ptr> errors(num_islands);
+    std::vector<std::thread> threads;
+    threads.reserve(num_islands);
+    
+    for (int island = 0; island < num_islands; ++island) {
+        threads.emplace_back([this, island, seed, &errors] {
+            try {
+                runIsland(island, seed);
+            } catch (...) {
+                errors[island] = std::current_exception();
+            }
+        });
+    }
+    
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    
+    LOG_INFO("Island HHOA completed. Best makespan: " + std::to_string(getBestMakespan()));
+    
+    return getBestSolution();
+}
+
+Solution IslandHHOA::getBestSolution() const {
+    int best_island = 0;
+    for (int island = 1; island < getNumIslands(); ++island) {
+        if (islands_[island]->getBestMakespan() < islands_[best_island]->getBestMakespan()) {
+            best_island = island;
+        }
+    }
+    return islands_[best_island]->getBestSolution();
+}
+
+int IslandHHOA::getBestMakespan() const {
+    return getBestSolution().getMakespan();
+}
+
+Migrant IslandHHOA::getBestMigrant() const {
+    std::lock_guard<std::mutex> lock(best_mutex_);
+    return best_migrant_;
+}
+
+bool IslandHHOA::postExternalMigrants(int island, std::vector<Migrant> migrants) {
+    if (island < 0 || island >= getNumIslands()) {
+        throw std::out_of_range("Invalid island index");
+    }
+    int num_islands = getNumIslands();
+    return mailboxes_[island * (num_islands + 1) + num_islands]->tryPush(std::move(migrants));
+}
+
+void IslandHHOA::requestStop() {
+    for (auto& island : islands_) {
+        island->requestStop();
+    }
+}
+
+void IslandHHOA::print() const {
+    std::cout << "=== Island HHOA ===" << std::endl;
+    island_parameters_.print();
+    
+    for (int island = 0; island < getNumIslands(); ++island) {
+        const HHOAStatistics& stats = islands_[island]->getStatistics();
+        std::cout << "  Island " << island
+                  << ": best makespan " << islands_[island]->getBestMakespan()
+                  << ", iterations " << stats.iterations_executed
+                  << ", migrants sent " << migrants_sent_[island]
+                  << ", accepted " << migrants_accepted_[island] << std::endl;
+    }
+}
+
+void IslandHHOA::setup(const std::vector<HHOAParameters>& parameters) {
+    int num_islands = island_parameters_.num_islands;
+    
+    for (int island = 0; island < num_islands; ++island) {
+        // Islands would overwrite each other's history streams: one file per island
+        HHOAParameters island_parameters = parameters[island];
+        if (!island_parameters.history_file.empty()) {
+            island_parameters.history_file += ".island" + std::to_string(island);
+        }
+        islands_.push_back(std::make_unique<HHOA>(instance_, island_parameters));
+        islands_.back()->setIterationCallback(
+            [this, island](int iteration, const Solution& best, const HHOAStatistics&) {
+                migrate(island, iteration, best);
+            });
+    }
+    
+    for (int i = 0; i < num_islands * (num_islands + 1); ++i) {
+        mailboxes_.push_back(std::make_unique<SpscQueue<std::vector<Migrant>>>(
+            island_parameters_.mailbox_capacity));
+    }
+    
+    migrants_sent_.assign(num_islands, 0);
+    migrants_accepted_.assign(num_islands, 0);
+}
+
+void IslandHHOA::runIsland(int island, std::uint64_t seed) {
+    // Each island draws from its own stream for the whole run
+    Random island_rng(seed, island);
+    Random::Binding binding(island_rng);
+    
+    islands_[island]->optimize();
+}
+
+void IslandHHOA::migrate(int island, int iteration, const Solution& best) {
+    int num_islands = getNumIslands();
+    
+    {
+        std::lock_guard<std::mutex> lock(best_mutex_);
+        if (best_migrant_.job_sequence.empty() || best.getMakespan() < best_migrant_.makespan) {
+            best_migrant_ = Migrant{best.getJobSequence(), best.getMakespan()};
+        }
+    }
+    
+    // An optimal solution on one island ends the others as well
+    if (islands_[island]->getParameters().stop_at_lower_bound &&
+        best.getMakespan() <= instance_->getLowerBound()) {
+        requestStop();
+        return;
+    }
+    
+    // Receive: drain every incoming mailbox, including the external one
+    std::vector<Solution> arrivals;
+    std::vector<Migrant> packet;
+    for (int source = 0; source <= num_islands; ++source) {
+        auto& mailbox = *mailboxes_[island * (num_islands + 1) + source];
+        while (mailbox.tryPop(packet)) {
+            for (auto& migrant : packet) {
+                arrivals.emplace_back(migrant.job_sequence, instance_);
+            }
+        }
+    }
+    
+    if (!arrivals.empty()) {
+        migrants_accepted_[island] += islands_[island]->injectSolutions(arrivals);
+    }
+    
+    // Send: copies of the best horses, every migration_interval generations
+    if (num_islands < 2 || (iteration + 1) % island_parameters_.migration_interval != 0 ||
+        island_parameters_.migration_size == 0) {
+        return;
+    }
+    
+    packet.clear();
+    for (const Solution& elite : islands_[island]->getEliteSolutions(island_parameters_.migration_size)) {
+        packet.push_back(Migrant{elite.getJobSequence(), elite.getMakespan()});
+    }
+    
+    int destination = selectDestination(island);
+    size_t packet_size = packet.size();
+    if (mailboxes_[destination * (num_islands + 1) + island]->tryPush(std::move(packet))) {
+        migrants_sent_[island] += packet_size;
+    }
+}
+
+int IslandHHOA::selectDestination(int island) const {
+    int num_islands = getNumIslands();
+    
+    if (island_parameters_.topology == MigrationTopology::RING) {
+        return (island + 1) % num_islands;
+    }
+    
+    int destination = Random::getInstance().randInt(0, num_islands - 2);
+    return destination >= island ? destination + 1 : destination;
+}
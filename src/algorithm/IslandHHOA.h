@@ -0,0 +1,178 @@
+#ifndef ISLAND_HHOA_H
+#define ISLAND_HHOA_H
+
+#include "HHOA.h"
+#include "../utils/SpscQueue.h"
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <mutex>
+
+/**
+ * @brief Migration topologies for the island model
+ */
+enum class MigrationTopology {
+    RING = 0,    // Island i sends to island i+1
+    RANDOM = 1   // Island i sends to a uniformly chosen other island
+};
+
+/**
+ * @brief Parameters of the island model
+ */
+struct IslandParameters {
+    int num_islands = 4;                                 // Number of concurrent herds
+    int migration_interval = 10;                         // Generations between migrations
+    int migration_size = 2;                              // Elite horses sent per migration
+    MigrationTopology topology = MigrationTopology::RING; // Migration topology
+    int mailbox_capacity = 8;                            // Pending migrations per island pair
+    std::uint64_t seed = 0;                              // Base seed (0: drawn from the global generator)
+
+    /**
+     * @brief Print parameters
+     */
+    void print() const;
+
+    /**
+     * @brief Validate parameters
+     * @return True if valid, false otherwise
+     */
+    bool isValid() const;
+};
+
+/**
+ * @brief Compact migrant representation: a permutation and its makespan
+ */
+struct Migrant {
+    std::vector<int> job_sequence;
+    int makespan = 0;
+};
+
+/**
+ * @brief Island-model HHOA: several herds optimize concurrently and exchange elites
+ *
+ * Each island is a complete HHOA run on its own thread with its own random
+ * stream and parameters. Every migration_interval generations an island
+ * sends copies of its best horses to its neighbour(s) through lock-free
+ * single-producer/single-consumer mailboxes; received migrants replace the
+ * weakest horses of the receiving herd.
+ */
+class IslandHHOA {
+private:
+    std::shared_ptr<ProblemInstance> instance_;
+    IslandParameters island_parameters_;
+    std::vector<std::unique_ptr<HHOA>> islands_;
+    std::vector<std::unique_ptr<SpscQueue<std::vector<Migrant>>>> mailboxes_;  // [destination * (N+1) + source], source N is external
+    std::vector<int> migrants_sent_;       // Per island
+    std::vector<int> migrants_accepted_;   // Per island
+    mutable std::mutex best_mutex_;        // Guards best_migrant_
+    Migrant best_migrant_;                 // Best solution reported by any island during the run
+
+public:
+    /**
+     * @brief Constructor with the same parameters on every island
+     * @param instance Problem instance to solve
+     * @param parameters Algorithm parameters for each island
+     * @param island_parameters Island model parameters
+     */
+    IslandHHOA(std::shared_ptr<ProblemInstance> instance,
+               const HHOAParameters& parameters = HHOAParameters{},
+               const IslandParameters& island_parameters = IslandParameters{});
+
+    /**
+     * @brief Constructor with individual parameters per island
+     * @param instance Problem instance to solve
+     * @param parameters Algorithm parameters, one entry per island
+     * @param island_parameters Island model parameters (num_islands must match)
+     */
+    IslandHHOA(std::shared_ptr<ProblemInstance> instance,
+               const std::vector<HHOAParameters>& parameters,
+               const IslandParameters& island_parameters);
+
+    // Getters
+    int getNumIslands() const { return islands_.size(); }
+    const IslandParameters& getIslandParameters() const { return island_parameters_; }
+    const HHOA& getIsland(int island) const;
+    const HHOAStatistics& getIslandStatistics(int island) const;
+    int getMigrantsSent(int island) const { return migrants_sent_.at(island); }
+    int getMigrantsAccepted(int island) const { return migrants_accepted_.at(island); }
+
+    /**
+     * @brief Run all islands concurrently until each one terminates
+     * @return Best solution over all islands
+     */
+    Solution optimize();
+
+    /**
+     * @brief Get the best solution over all islands
+     * @return Best solution
+     */
+    Solution getBestSolution() const;
+
+    /**
+     * @brief Get the best makespan over all islands
+     * @return Best makespan
+     */
+    int getBestMakespan() const;
+
+    /**
+     * @brief Get a snapshot of the best solution found so far by the running islands
+     *
+     * Thread-safe; may be called while optimize() runs on another thread.
+     *
+     * @return Best migrant (empty job sequence before the first generation)
+     */
+    Migrant getBestMigrant() const;
+
+    /**
+     * @brief Deliver migrants from outside the process to an island
+     *
+     * Thread-safe for a single external producer; the island injects them
+     * at its next generation.
+     *
+     * @param island Destination island
+     * @param migrants Migrants of the same instance
+     * @return True if queued, false if the island's external mailbox is full
+     */
+    bool postExternalMigrants(int island, std::vector<Migrant> migrants);
+
+    /**
+     * @brief Ask every island to stop after its current generation (thread-safe)
+     */
+    void requestStop();
+
+    /**
+     * @brief Print per-island results
+     */
+    void print() const;
+
+private:
+    /**
+     * @brief Create islands and mailboxes
+     * @param parameters Algorithm parameters, one entry per island
+     */
+    void setup(const std::vector<HHOAParameters>& parameters);
+
+    /**
+     * @brief Run one island to completion on the current thread
+     * @param island Island index
+     * @param seed Base seed of the run
+     */
+    void runIsland(int island, std::uint64_t seed);
+
+    /**
+     * @brief Send elites and receive migrants (called from the island's iteration callback)
+     * @param island Island index
+     * @param iteration Current iteration of the island
+     * @param best Current best solution of the island
+     */
+    void migrate(int island, int iteration, const Solution& best);
+
+    /**
+     * @brief Select the destination island of a migration
+     * @param island Source island
+     * @return Destination island
+     */
+    int selectDestination(int island) const;
+};
+
+#endif // ISLAND_HHOA_H
@@ -0,0 +1,58 @@
+#include "OperatorSelector.h"
+#include "../utils/Random.h"
+#include <algorithm>
+#include <stdexcept>
+
+OperatorSelector::OperatorSelector(double decay, double min_share) {
+    reset(decay, min_share);
+}
+
+void OperatorSelector::reset(double decay, double min_share) {
+    if (decay < 0.0 || decay >= 1.0) {
+        throw std::invalid_argument("Selection decay must be in [0, 1)");
+    }
+    if (min_share < 0.0 || min_share * kNumOperators > 1.0) {
+        throw std::invalid_argument("Minimum operator share must be in [0, 1 / operators]");
+    }
+
+    decay_ = decay;
+    min_share_ = min_share;
+    credits_.fill(OperatorCredit{});
+    for (OperatorCredit& credit : credits_) {
+        credit.share = 1.0 / kNumOperators;
+    }
+}
+
+void OperatorSelector::beginIteration() {
+    double total = 0.0;
+    for (const OperatorCredit& credit : credits_) {
+        total += credit.credit;
+    }
+
+    // Probability matching; no credit anywhere yet means an even split
+    for (OperatorCredit& credit : credits_) {
+        credit.share = total > 0.0 ? min_share_ + (1.0 - kNumOperators * min_share_) * credit.credit / total
+                                   : 1.0 / kNumOperators;
+    }
+}
+
+bool OperatorSelector::select(int arm) {
+    OperatorCredit& credit = credits_[arm];
+    double probability = credit.runs == 0 ? 1.0 : std::min(1.0, kNumOperators * credit.share);
+    if (probability < 1.0 && Random::getInstance().randDouble() >= probability) {
+        credit.skips++;
+        return false;
+    }
+    return true;
+}
+
+void OperatorSelector::update(int arm, int accepted, long long attempts) {
+    OperatorCredit& credit = credits_[arm];
+    if (attempts > 0) {
+        double reward = static_cast<double>(accepted) / attempts;
+        credit.credit = credit.runs == 0 ? reward : decay_ * credit.credit + (1.0 - decay_) * reward;
+    }
+    credit.runs++;
+    credit.attempts += attempts;
+    credit.accepted += accepted;
+}
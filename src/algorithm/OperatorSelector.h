@@ -0,0 +1,87 @@
+#ifndef OPERATOR_SELECTOR_H
+#define OPERATOR_SELECTOR_H
+
+#include <array>
+
+/**
+ * @brief Credit of one search operator under adaptive operator selection
+ */
+struct OperatorCredit {
+    double credit = 0.0;        // Smoothed improvements per candidate tried
+    double share = 0.0;         // Share of the iteration budget as of the last iteration
+    long long runs = 0;         // Iterations the operator ran
+    long long skips = 0;        // Iterations the selector skipped it
+    long long attempts = 0;     // Candidates tried
+    long long accepted = 0;     // Candidates accepted (improvements)
+};
+
+/**
+ * @brief Multi-armed bandit over the search operators of an iteration
+ *
+ * Arms are the first kNumOperators phases (grazing, roaming, following,
+ * mating, mutation). Each arm's credit is an exponentially smoothed
+ * improvement rate, and shares follow probability matching: every arm
+ * keeps min_share and the rest is split in proportion to the credits. An
+ * arm runs in an iteration with probability min(1, kNumOperators * share),
+ * so with equal credits every operator runs (the fixed schedule) and
+ * unproductive operators stop spending evaluations.
+ */
+class OperatorSelector {
+public:
+    static constexpr int kNumOperators = 5;   // Grazing, roaming, following, mating, mutation
+
+private:
+    std::array<OperatorCredit, kNumOperators> credits_;
+    double decay_;        // Weight of the previous credit in an update
+    double min_share_;    // Share every operator keeps
+
+public:
+    /**
+     * @brief Constructor
+     * @param decay Weight of the previous credit in [0, 1)
+     * @param min_share Share every operator keeps in [0, 1 / kNumOperators]
+     */
+    explicit OperatorSelector(double decay = 0.8, double min_share = 0.05);
+
+    /**
+     * @brief Forget every credit and counter
+     * @param decay Weight of the previous credit in [0, 1)
+     * @param min_share Share every operator keeps in [0, 1 / kNumOperators]
+     */
+    void reset(double decay, double min_share);
+
+    /**
+     * @brief Recompute the shares from the credits (once per iteration)
+     */
+    void beginIteration();
+
+    /**
+     * @brief Decide whether an operator runs in this iteration
+     *
+     * Operators never run before always run, so each starts with a measured
+     * credit. Draws from Random::getInstance() only when the run probability
+     * is below one.
+     *
+     * @param arm Operator index (HHOAPhase value)
+     * @return True if the operator should run
+     */
+    bool select(int arm);
+
+    /**
+     * @brief Credit an operator with the outcome of a run
+     * @param arm Operator index
+     * @param accepted Candidates accepted
+     * @param attempts Candidates tried (0: no information, the credit is kept)
+     */
+    void update(int arm, int accepted, long long attempts);
+
+    const std::array<OperatorCredit, kNumOperators>& getCredits() const { return credits_; }
+
+    /**
+     * @brief Continue from saved credits (checkpoint resume)
+     * @param credits Credits returned by getCredits()
+     */
+    void setCredits(const std::array<OperatorCredit, kNumOperators>& credits) { credits_ = credits; }
+};
+
+#endif // OPERATOR_SELECTOR_H
@@ -0,0 +1,158 @@
+#include "PopulationArena.h"
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+namespace {
+// Fixed-point scale of the c*log(c) sums: integer updates keep the entropy
+// independent of the order in which the histogram was built
+constexpr double kPlogpScale = 4294967296.0;
+}
+
+PopulationArena::PopulationArena() : num_horses_(0), num_jobs_(0), sequences_valid_(false) {}
+
+void PopulationArena::gatherScalars(const std::vector<Horse>& horses) {
+    int num_jobs = horses.empty() ? 0 : horses.front().getSolution().getNumJobs();
+    resize(horses.size(), num_jobs);
+
+    for (int i = 0; i < num_horses_; ++i) {
+        gatherScalars(i, horses[i]);
+    }
+}
+
+void PopulationArena::gatherScalars(int index, const Horse& horse) {
+    makespans_[index] = horse.getMakespan();
+    best_makespans_[index] = horse.getBestMakespan();
+    fitness_[index] = horse.getFitness();
+    best_fitness_[index] = horse.getBestFitness();
+    age_[index] = horse.getAge();
+    stamina_[index] = horse.getStamina();
+    stagnation_[index] = horse.getStagnationCounter();
+}
+
+int PopulationArena::gatherSequences(const std::vector<Horse>& horses) {
+    int num_jobs = horses.empty() ? 0 : horses.front().getSolution().getNumJobs();
+    resize(horses.size(), num_jobs);
+
+    if (!sequences_valid_) {
+        // Rebuild: empty histogram, every row refreshed below
+        std::fill(position_counts_.begin(), position_counts_.end(), 0);
+        std::fill(position_plogp_.begin(), position_plogp_.end(), 0);
+        std::fill(current_sequences_.begin(), current_sequences_.end(), -1);
+        plogp_table_.resize(num_horses_ + 1);
+        for (int c = 0; c <= num_horses_; ++c) {
+            plogp_table_[c] = c > 0 ? std::llround(c * std::log(static_cast<double>(c)) * kPlogpScale) : 0;
+        }
+    }
+
+    int refreshed = 0;
+    for (int i = 0; i < num_horses_; ++i) {
+        if (sequences_valid_ && revisions_[i] == horses[i].getRevision()) {
+            continue;
+        }
+
+        const std::vector<int>& current = horses[i].getSolution().getJobSequence();
+        const std::vector<int>& best = horses[i].getBestSolution().getJobSequence();
+        int* row = &current_sequences_[i * num_jobs_];
+        for (int position = 0; position < num_jobs_; ++position) {
+            if (row[position] != current[position]) {
+                replaceCount(position, row[position], current[position]);
+                row[position] = current[position];
+            }
+        }
+        std::copy(best.begin(), best.end(), best_sequences_.begin() + i * num_jobs_);
+
+        revisions_[i] = horses[i].getRevision();
+        refreshed++;
+    }
+
+    sequences_valid_ = true;
+    return refreshed;
+}
+
+double PopulationArena::positionEntropy() const {
+    int max_outcomes = std::min(num_horses_, num_jobs_);
+    if (!sequences_valid_ || max_outcomes < 2) {
+        return 0.0;
+    }
+
+    // H(position) = log P - (1/P) * sum(c * log c)
+    double log_horses = std::log(static_cast<double>(num_horses_));
+    double total = 0.0;
+    for (int position = 0; position < num_jobs_; ++position) {
+        total += log_horses - position_plogp_[position] / kPlogpScale / num_horses_;
+    }
+
+    double entropy = total / (num_jobs_ * std::log(static_cast<double>(max_outcomes)));
+    return std::max(0.0, std::min(1.0, entropy));
+}
+
+const std::vector<int>& PopulationArena::rankByFitness() {
+    order_.resize(num_horses_);
+    std::iota(order_.begin(), order_.end(), 0);
+
+    std::stable_sort(order_.begin(), order_.end(), [this](int a, int b) {
+        return fitness_[a] > fitness_[b];
+    });
+
+    return order_;
+}
+
+const std::vector<int>& PopulationArena::selectWorst(int count) {
+    count = std::max(0, std::min(count, num_horses_));
+    order_.resize(num_horses_);
+    std::iota(order_.begin(), order_.end(), 0);
+
+    std::partial_sort(order_.begin(), order_.begin() + count, order_.end(), [this](int a, int b) {
+        return best_fitness_[a] < best_fitness_[b] || (best_fitness_[a] == best_fitness_[b] && a < b);
+    });
+    order_.resize(count);
+
+    return order_;
+}
+
+int PopulationArena::hammingDistance(int a, int b) const {
+    const int* first = getCurrentSequence(a);
+    const int* second = getCurrentSequence(b);
+
+    int distance = 0;
+    for (int position = 0; position < num_jobs_; ++position) {
+        distance += first[position] != second[position];
+    }
+    return distance;
+}
+
+void PopulationArena::resize(int num_horses, int num_jobs) {
+    if (num_horses == num_horses_ && num_jobs == num_jobs_) {
+        return;
+    }
+
+    num_horses_ = num_horses;
+    num_jobs_ = num_jobs;
+
+    current_sequences_.resize(num_horses * num_jobs);
+    best_sequences_.resize(num_horses * num_jobs);
+    makespans_.resize(num_horses);
+    best_makespans_.resize(num_horses);
+    fitness_.resize(num_horses);
+    best_fitness_.resize(num_horses);
+    age_.resize(num_horses);
+    stamina_.resize(num_horses);
+    stagnation_.resize(num_horses);
+    revisions_.resize(num_horses);
+    position_counts_.resize(num_jobs * num_jobs);
+    position_plogp_.resize(num_jobs);
+    sequences_valid_ = false;
+}
+
+void PopulationArena::replaceCount(int position, int old_job, int new_job) {
+    int* counts = &position_counts_[position * num_jobs_];
+    long long& plogp = position_plogp_[position];
+
+    if (old_job >= 0) {
+        plogp += plogp_table_[counts[old_job] - 1] - plogp_table_[counts[old_job]];
+        counts[old_job]--;
+    }
+    plogp += plogp_table_[counts[new_job] + 1] - plogp_table_[counts[new_job]];
+    counts[new_job]++;
+}
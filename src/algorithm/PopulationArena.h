@@ -0,0 +1,145 @@
+#ifndef POPULATION_ARENA_H
+#define POPULATION_ARENA_H
+
+#include "Horse.h"
+#include "../core/ProblemInstance.h"
+#include <vector>
+#include <cstdint>
+
+/**
+ * @brief Structure-of-arrays view of a herd for population-wide operations
+ *
+ * The permutations of all horses are kept in two contiguous
+ * num_horses x num_jobs arrays (current and best), and the scalar state in
+ * parallel arrays, so ranking, replacement and diversity work on indices and
+ * flat memory instead of walking or moving Horse objects. Horses remain the
+ * owners of their solutions (the local searches rely on the incremental
+ * completion-time cache of Solution); the arena is refreshed from them with
+ * gatherScalars() and gatherSequences().
+ *
+ * Alongside the permutations the arena keeps a job x position histogram of
+ * the current solutions. gatherSequences() only rewrites the rows of horses
+ * whose revision changed, so the histogram and its entropy are maintained in
+ * O(changed * n) per refresh.
+ */
+class PopulationArena {
+private:
+    int num_horses_;                       // Horses in the arena
+    int num_jobs_;                         // Permutation length
+    AlignedIntVector current_sequences_;   // [horse * num_jobs + position]
+    AlignedIntVector best_sequences_;      // [horse * num_jobs + position]
+    std::vector<int> makespans_;           // Current makespan per horse
+    std::vector<int> best_makespans_;      // Best makespan per horse
+    std::vector<double> fitness_;          // Current fitness per horse
+    std::vector<double> best_fitness_;     // Best fitness per horse
+    std::vector<double> age_;              // Age per horse
+    std::vector<double> stamina_;          // Stamina per horse
+    std::vector<int> stagnation_;          // Stagnation counter per horse
+    std::vector<int> order_;               // Scratch: index ranking
+    std::vector<std::uint64_t> revisions_; // Horse revision of each gathered permutation row
+    std::vector<int> position_counts_;     // [position * num_jobs + job]: horses with job at position
+    std::vector<long long> position_plogp_;  // Per position: sum of c*log(c) over its counts, fixed point
+    std::vector<long long> plogp_table_;     // c*log(c) for c = 0..num_horses, fixed point
+    bool sequences_valid_;                 // False when the rows must be rebuilt from scratch
+
+public:
+    /**
+     * @brief Constructor (empty arena)
+     */
+    PopulationArena();
+
+    // Getters
+    int getNumHorses() const { return num_horses_; }
+    int getNumJobs() const { return num_jobs_; }
+    const int* getCurrentSequence(int horse) const { return &current_sequences_[horse * num_jobs_]; }
+    const int* getBestSequence(int horse) const { return &best_sequences_[horse * num_jobs_]; }
+    int getMakespan(int horse) const { return makespans_[horse]; }
+    int getBestMakespan(int horse) const { return best_makespans_[horse]; }
+    double getFitness(int horse) const { return fitness_[horse]; }
+    double getBestFitness(int horse) const { return best_fitness_[horse]; }
+    double getAge(int horse) const { return age_[horse]; }
+    double getStamina(int horse) const { return stamina_[horse]; }
+    int getStagnation(int horse) const { return stagnation_[horse]; }
+
+    /**
+     * @brief Refresh the scalar arrays of every horse (O(P))
+     * @param horses Horses of the herd
+     */
+    void gatherScalars(const std::vector<Horse>& horses);
+
+    /**
+     * @brief Refresh the scalar state of one horse
+     * @param index Horse index (must be within the last gathered herd)
+     * @param horse Horse at that index
+     */
+    void gatherScalars(int index, const Horse& horse);
+
+    /**
+     * @brief Refresh the permutation arrays and the position histogram
+     *
+     * Only horses whose revision differs from the gathered one are copied,
+     * unless the herd size or permutation length changed.
+     *
+     * @param horses Horses of the herd
+     * @return Number of horses whose rows were refreshed
+     */
+    int gatherSequences(const std::vector<Horse>& horses);
+
+    /**
+     * @brief Number of current solutions with a job at a position
+     * @param position Sequence position
+     * @param job Job index
+     * @return Count from the last gatherSequences()
+     */
+    int getPositionCount(int position, int job) const { return position_counts_[position * num_jobs_ + job]; }
+
+    /**
+     * @brief Normalized position-frequency entropy of the current solutions
+     *
+     * Mean over positions of the entropy of the job distribution at that
+     * position, divided by its maximum log(min(P, n)): 0 when all horses
+     * agree, 1 when every position is as mixed as the herd size allows.
+     *
+     * @return Diversity in [0, 1]
+     */
+    double positionEntropy() const;
+
+    /**
+     * @brief Rank horses by current fitness
+     * @return Horse indices, best first (ties by index)
+     */
+    const std::vector<int>& rankByFitness();
+
+    /**
+     * @brief Select the horses with the lowest best fitness
+     * @param count Number of horses
+     * @return Horse indices, worst first (ties by index)
+     */
+    const std::vector<int>& selectWorst(int count);
+
+    /**
+     * @brief Number of positions where the current permutations of two horses differ
+     * @param a First horse
+     * @param b Second horse
+     * @return Hamming distance
+     */
+    int hammingDistance(int a, int b) const;
+
+private:
+    /**
+     * @brief Resize the arrays for a herd
+     * @param num_horses Number of horses
+     * @param num_jobs Permutation length
+     */
+    void resize(int num_horses, int num_jobs);
+
+    /**
+     * @brief Move one histogram entry from a job to another at a position
+     * @param position Sequence position
+     * @param old_job Job removed (-1: none)
+     * @param new_job Job added
+     */
+    void replaceCount(int position, int old_job, int new_job);
+};
+
+#endif // POPULATION_ARENA_H
@@ -0,0 +1,74 @@
+#include "SolveHandle.h"
+#include "HHOA.h"
+#include "../utils/Random.h"
+#include "../utils/Timer.h"
+
+SolveHandle::SolveHandle(HHOA& hhoa, std::uint64_t seed, size_t queue_capacity)
+    : hhoa_(&hhoa), state_(std::make_shared<State>(queue_capacity)) {
+    std::promise<Solution> promise;
+    future_ = promise.get_future();
+
+    auto timer = std::make_shared<Timer>("Solve");
+    std::shared_ptr<State> state = state_;
+    hhoa.solve_callback_ = [state, timer](int iteration, const Solution& best) {
+        publish(*state, iteration, best, timer->getElapsedMs());
+    };
+
+    thread_ = std::thread([&hhoa, state, timer, seed, promise = std::move(promise)]() mutable {
+        // Own stream: the solve does not share the caller's generator
+        Random solve_rng(seed);
+        Random::Binding binding(solve_rng);
+
+        // The hook is removed and done set first: a ready future always implies isDone()
+        timer->start();
+        try {
+            Solution best = hhoa.optimize();
+            hhoa.solve_callback_ = nullptr;
+            state->done.store(true, std::memory_order_release);
+            promise.set_value(std::move(best));
+        } catch (...) {
+            hhoa.solve_callback_ = nullptr;
+            state->done.store(true, std::memory_order_release);
+            promise.set_exception(std::current_exception());
+        }
+    });
+}
+
+SolveHandle::~SolveHandle() {
+    if (thread_.joinable()) {
+        if (!isDone()) {
+            hhoa_->requestStop();
+        }
+        thread_.join();
+    }
+}
+
+void SolveHandle::publish(State& state, int iteration, const Solution& best, double time_ms) {
+    auto snapshot = std::make_shared<const Solution>(best);
+    {
+        std::lock_guard<std::mutex> lock(state.best_mutex);
+        state.best.swap(snapshot);
+    }
+
+    SolveImprovement improvement{iteration, best.getMakespan(), time_ms, best.getJobSequence()};
+    while (!state.improvements.tryPush(improvement)) {
+        // Full: drop the oldest entry to make room for the newest
+        SolveImprovement oldest;
+        if (state.improvements.tryPop(oldest)) {
+            state.dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+std::shared_ptr<const Solution> SolveHandle::currentBest() const {
+    std::lock_guard<std::mutex> lock(state_->best_mutex);
+    return state_->best;
+}
+
+bool SolveHandle::pollImprovement(SolveImprovement& improvement) {
+    return state_->improvements.tryPop(improvement);
+}
+
+void SolveHandle::cancel() {
+    hhoa_->requestStop();
+}
@@ -0,0 +1,130 @@
+#ifndef SOLVE_HANDLE_H
+#define SOLVE_HANDLE_H
+
+#include "../core/Solution.h"
+#include "../utils/MpmcQueue.h"
+#include <atomic>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class HHOA;
+
+/**
+ * @brief New best solution reported by an asynchronous solve
+ */
+struct SolveImprovement {
+    int iteration = 0;               // Iteration that found it (-1: initial herd)
+    int makespan = 0;                // Makespan of the solution
+    double time_ms = 0.0;            // Time since the solve started
+    std::vector<int> job_sequence;   // The solution
+};
+
+/**
+ * @brief Handle of an optimization running on its own thread (see HHOA::solveAsync)
+ *
+ * The optimizer publishes every new best solution twice: as the snapshot
+ * returned by currentBest() and as an entry of a bounded lock-free queue
+ * drained with pollImprovement(). When the queue is full the oldest entry
+ * is dropped, so the newest improvements are never lost. No call blocks on
+ * the optimizer except waiting on the future. The handle listens through an
+ * internal hook of the HHOA, removed when the solve ends, so the user's
+ * improvement callback is left in place.
+ *
+ * The handle is move-only. Destroying a handle whose solve is still running
+ * cancels it and waits for the thread; the HHOA object must outlive it.
+ */
+class SolveHandle {
+private:
+    /**
+     * @brief State shared with the optimizer thread
+     */
+    struct State {
+        explicit State(size_t capacity) : improvements(capacity) {}
+
+        MpmcQueue<SolveImprovement> improvements;        // Pending improvements, oldest first
+        std::atomic<long long> dropped{0};               // Improvements dropped on a full queue
+        mutable std::mutex best_mutex;                   // Guards best (pointer swap only)
+        std::shared_ptr<const Solution> best;            // Latest best solution
+        std::atomic<bool> done{false};                   // Optimizer thread has finished
+    };
+
+    HHOA* hhoa_;                       // Running optimizer
+    std::shared_ptr<State> state_;     // Shared with the optimizer thread
+    std::future<Solution> future_;     // Final best solution
+    std::thread thread_;               // Optimizer thread
+
+    friend class HHOA;
+
+    /**
+     * @brief Start the optimizer thread (HHOA::solveAsync)
+     * @param hhoa Optimizer to run
+     * @param seed Seed of the thread's random generator
+     * @param queue_capacity Improvements kept before the oldest is dropped
+     */
+    SolveHandle(HHOA& hhoa, std::uint64_t seed, size_t queue_capacity);
+
+    /**
+     * @brief Publish a new best solution (optimizer thread only)
+     * @param state Shared state
+     * @param iteration Iteration that found it
+     * @param best New best solution
+     * @param time_ms Time since the start
+     */
+    static void publish(State& state, int iteration, const Solution& best, double time_ms);
+
+public:
+    SolveHandle(SolveHandle&& other) noexcept = default;
+    SolveHandle& operator=(SolveHandle&&) = delete;
+    SolveHandle(const SolveHandle&) = delete;
+    SolveHandle& operator=(const SolveHandle&) = delete;
+
+    /**
+     * @brief Destructor: cancels a running solve and joins its thread
+     */
+    ~SolveHandle();
+
+    /**
+     * @brief Future of the final best solution (rethrows optimizer exceptions)
+     * @return Future, valid until get() is called on it
+     */
+    std::future<Solution>& getFuture() { return future_; }
+
+    /**
+     * @brief Snapshot of the best solution so far (any thread)
+     * @return Best solution (null before the initial herd is built)
+     */
+    std::shared_ptr<const Solution> currentBest() const;
+
+    /**
+     * @brief Pop the oldest pending improvement (any thread)
+     * @param improvement Output improvement
+     * @return False if none is pending
+     */
+    bool pollImprovement(SolveImprovement& improvement);
+
+    /**
+     * @brief Ask the solve to stop as soon as possible (any thread)
+     *
+     * Honoured mid-phase: the local searches stop at their next move and the
+     * remaining phases are skipped. The future still receives the best
+     * solution found.
+     */
+    void cancel();
+
+    /**
+     * @brief Check whether the optimization has finished
+     * @return True once the run is over (set just before the future becomes ready)
+     */
+    bool isDone() const { return state_->done.load(std::memory_order_acquire); }
+
+    /**
+     * @brief Improvements dropped because the queue was full
+     * @return Dropped count
+     */
+    long long getDroppedImprovements() const { return state_->dropped.load(std::memory_order_relaxed); }
+};
+
+#endif // SOLVE_HANDLE_H
@@ -0,0 +1,220 @@
+#include "SolverService.h"
+#include <iostream>
+#include <stdexcept>
+
+void SolverServiceParameters::print() const {
+    std::cout << "Solver Service Parameters:" << std::endl;
+    std::cout << "  Workers: " << num_workers << std::endl;
+    std::cout << "  Instance Cache Size: " << instance_cache_size << std::endl;
+}
+
+bool SolverServiceParameters::isValid() const {
+    return num_workers > 0 && instance_cache_size >= 0;
+}
+
+SolverService::SolverService(const HHOAParameters& parameters, const SolverServiceParameters& service_parameters)
+    : parameters_(parameters), service_parameters_(service_parameters),
+      seed_generator_(Random::getInstance().nextSeed()) {
+
+    if (!parameters_.isValid()) {
+        throw std::invalid_argument("Invalid HHOA parameters");
+    }
+    if (!service_parameters_.isValid()) {
+        throw std::invalid_argument("Invalid solver service parameters");
+    }
+    if (!parameters_.checkpoint_file.empty() || !parameters_.history_file.empty()) {
+        // Every request would overwrite the same file
+        throw std::invalid_argument("Solver service runs cannot write checkpoint or history files");
+    }
+
+    running_.assign(service_parameters_.num_workers, nullptr);
+    workers_.reserve(service_parameters_.num_workers);
+    for (int i = 0; i < service_parameters_.num_workers; ++i) {
+        workers_.emplace_back(&SolverService::workerLoop, this, i, seed_generator_.nextSeed());
+    }
+}
+
+SolverService::~SolverService() {
+    std::deque<Job> abandoned;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        for (HHOA* hhoa : running_) {
+            if (hhoa) {
+                hhoa->requestStop();
+            }
+        }
+        abandoned.swap(queue_);
+    }
+    work_available_.notify_all();
+
+    for (Job& job : abandoned) {
+        job.promise.set_exception(std::make_exception_ptr(std::runtime_error("Solver service stopped")));
+    }
+    for (std::thread& worker : workers_) {
+        worker.join();
+    }
+}
+
+std::future<SolveResult> SolverService::submit(std::shared_ptr<ProblemInstance> instance, const SolveBudget& budget) {
+    if (!instance || !instance->isValid()) {
+        throw std::invalid_argument("Invalid problem instance");
+    }
+    if (budget.max_iterations < 0 || budget.time_limit_ms < 0.0 || budget.max_evaluations < 0) {
+        throw std::invalid_argument("Invalid solve budget");
+    }
+
+    // Hashed outside the lock: O(jobs * machines), O(jobs^2 * machines) with setup times
+    std::uint64_t checksum = instance->getChecksum();
+
+    Job job;
+    job.budget = budget;
+    std::future<SolveResult> future = job.promise.get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (stopping_) {
+            throw std::runtime_error("Solver service stopped");
+        }
+        job.instance = acquireInstance(instance, checksum, job.instance_cached);
+        if (job.budget.seed == 0) {
+            job.budget.seed = seed_generator_.nextSeed();
+        }
+        job.queued = std::chrono::steady_clock::now();
+        queue_.push_back(std::move(job));
+    }
+    work_available_.notify_one();
+    return future;
+}
+
+std::future<SolveResult> SolverService::submit(const std::vector<std::vector<int>>& processing_times,
+                                               const SolveBudget& budget) {
+    return submit(std::make_shared<ProblemInstance>(processing_times), budget);
+}
+
+SolverServiceStatistics SolverService::getStatistics() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return statistics_;
+}
+
+size_t SolverService::getQueueLength() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+std::shared_ptr<ProblemInstance> SolverService::acquireInstance(const std::shared_ptr<ProblemInstance>& instance,
+                                                                std::uint64_t checksum, bool& cached) {
+    cached = false;
+    if (service_parameters_.instance_cache_size == 0) {
+        ++statistics_.instance_cache_misses;
+        return std::make_shared<ProblemInstance>(*instance);
+    }
+
+    // Same checksum and same data: the checksum alone is not trusted
+    auto range = instance_index_.equal_range(checksum);
+    for (auto it = range.first; it != range.second; ++it) {
+        if ((*it->second)->hasSameData(*instance)) {
+            instances_.splice(instances_.begin(), instances_, it->second);
+            cached = true;
+            ++statistics_.instance_cache_hits;
+            return instances_.front();
+        }
+    }
+
+    // Miss: keep a private copy so later edits by the caller cannot stale the entry
+    ++statistics_.instance_cache_misses;
+    instances_.push_front(std::make_shared<ProblemInstance>(*instance));
+    instance_index_.emplace(checksum, instances_.begin());
+
+    if (static_cast<int>(instances_.size()) > service_parameters_.instance_cache_size) {
+        // Evict the least recently used instance (running jobs keep their own reference)
+        auto oldest = std::prev(instances_.end());
+        auto evicted = instance_index_.equal_range((*oldest)->getChecksum());
+        for (auto it = evicted.first; it != evicted.second; ++it) {
+            if (it->second == oldest) {
+                instance_index_.erase(it);
+                break;
+            }
+        }
+        instances_.erase(oldest);
+    }
+    return instances_.front();
+}
+
+void SolverService::workerLoop(int index, std::uint64_t seed) {
+    // Worker-lifetime stream: building the HHOA draws from it, not from a run's seed
+    Random worker_rng(seed);
+    Random::Binding worker_binding(worker_rng);
+    std::unique_ptr<HHOA> hhoa;
+
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_available_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+            if (stopping_) {
+                return;
+            }
+            job = std::move(queue_.front());
+            queue_.pop_front();
+        }
+
+        SolveResult result;
+        result.seed = job.budget.seed;
+        result.instance_cached = job.instance_cached;
+        result.wait_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - job.queued).count();
+
+        try {
+            HHOAParameters parameters = parameters_;
+            if (job.budget.max_iterations > 0) {
+                parameters.max_iterations = job.budget.max_iterations;
+            }
+            if (job.budget.time_limit_ms > 0.0) {
+                parameters.time_limit_ms = job.budget.time_limit_ms;
+            }
+            if (job.budget.max_evaluations > 0) {
+                parameters.max_evaluations = job.budget.max_evaluations;
+            }
+
+            // Reset the adaptive rates of the previous run along with the budget
+            result.herd_reused = hhoa != nullptr;
+            if (hhoa) {
+                hhoa->setInstance(job.instance);
+                hhoa->setParameters(parameters);
+            } else {
+                hhoa = std::make_unique<HHOA>(job.instance, parameters);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                ++(result.herd_reused ? statistics_.herds_reused : statistics_.herds_created);
+                running_[index] = hhoa.get();
+                if (stopping_) {
+                    hhoa->requestStop();
+                }
+            }
+
+            {
+                Random run_rng(job.budget.seed);
+                Random::Binding run_binding(run_rng);
+                Solution best = hhoa->optimize();
+                result.job_sequence = best.getJobSequence();
+                result.makespan = best.getMakespan();
+            }
+            result.statistics = hhoa->getStatistics();
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                running_[index] = nullptr;
+                ++statistics_.requests_completed;
+            }
+            job.promise.set_value(std::move(result));
+        } catch (...) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                running_[index] = nullptr;
+            }
+            // The optimizer may be half way through a run: start over
+            hhoa.reset();
+            job.promise.set_exception(std::current_exception());
+        }
+    }
+}
@@ -0,0 +1,181 @@
+#ifndef SOLVER_SERVICE_H
+#define SOLVER_SERVICE_H
+
+#include "HHOA.h"
+#include "../utils/Random.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * @brief Parameters of a SolverService
+ */
+struct SolverServiceParameters {
+    int num_workers = 1;             // Worker threads, each owning one reused HHOA
+    int instance_cache_size = 64;    // Distinct instances kept by content (0: no cache)
+
+    /**
+     * @brief Print parameters
+     */
+    void print() const;
+
+    /**
+     * @brief Validate parameters
+     * @return True if valid
+     */
+    bool isValid() const;
+};
+
+/**
+ * @brief Budget of one request (zero fields keep the service's HHOA parameters)
+ */
+struct SolveBudget {
+    int max_iterations = 0;          // Iteration bound
+    double time_limit_ms = 0.0;      // Wall-clock budget
+    long long max_evaluations = 0;   // Makespan evaluation budget
+    std::uint64_t seed = 0;          // Seed of the run (0: drawn by the service)
+};
+
+/**
+ * @brief Result of one request
+ */
+struct SolveResult {
+    std::vector<int> job_sequence;   // Best solution found
+    int makespan = 0;                // Its makespan
+    HHOAStatistics statistics;       // Statistics of the run
+    std::uint64_t seed = 0;          // Seed the run used (reproduces it)
+    double wait_ms = 0.0;            // Time queued before a worker took the request
+    bool instance_cached = false;    // Instance was already in the service's cache
+    bool herd_reused = false;        // Worker reused its HHOA instead of building one
+};
+
+/**
+ * @brief Counters of a SolverService
+ */
+struct SolverServiceStatistics {
+    long long requests_completed = 0;
+    long long instance_cache_hits = 0;
+    long long instance_cache_misses = 0;
+    long long herds_created = 0;
+    long long herds_reused = 0;
+};
+
+/**
+ * @brief Solves a stream of instances on a pool of long-lived workers
+ *
+ * Every worker keeps one HHOA across requests: its herd buffers, arena,
+ * thread pool and cache slots are reused and the instance is swapped with
+ * HHOA::setInstance. Instances are deduplicated by content, so repeated
+ * submissions of the same data share one ProblemInstance (and its lower
+ * bound) and a worker that solved it last does not even switch instances.
+ *
+ * A request is reproducible from its seed: the result for (instance, seed)
+ * does not depend on what the worker solved before.
+ */
+class SolverService {
+private:
+    /**
+     * @brief Queued request
+     */
+    struct Job {
+        std::shared_ptr<ProblemInstance> instance;
+        SolveBudget budget;
+        bool instance_cached = false;
+        std::chrono::steady_clock::time_point queued;
+        std::promise<SolveResult> promise;
+    };
+
+    using InstanceList = std::list<std::shared_ptr<ProblemInstance>>;
+
+    HHOAParameters parameters_;                  // Base parameters of every run
+    SolverServiceParameters service_parameters_;
+
+    std::mutex mutex_;                           // Guards every member below
+    std::condition_variable work_available_;     // Signals queued jobs and shutdown
+    std::deque<Job> queue_;                      // Requests not taken by a worker yet
+    InstanceList instances_;                     // Cached instances, most recently used first
+    std::unordered_multimap<std::uint64_t, InstanceList::iterator> instance_index_;  // Checksum -> entry
+    Random seed_generator_;                      // Draws the seeds of unseeded requests
+    std::vector<HHOA*> running_;                 // Optimizer each worker is running (null: idle)
+    SolverServiceStatistics statistics_;
+    bool stopping_ = false;                      // Destructor called
+
+    std::vector<std::thread> workers_;
+
+public:
+    /**
+     * @brief Constructor: starts the workers
+     * @param parameters HHOA parameters of every run (budgets can be overridden per request)
+     * @param service_parameters Pool and cache sizes
+     */
+    explicit SolverService(const HHOAParameters& parameters = HHOAParameters{},
+                           const SolverServiceParameters& service_parameters = SolverServiceParameters{});
+
+    /**
+     * @brief Destructor: stops the running solves, fails the queued ones and joins the workers
+     */
+    ~SolverService();
+
+    SolverService(const SolverService&) = delete;
+    SolverService& operator=(const SolverService&) = delete;
+
+    /**
+     * @brief Queue an instance
+     * @param instance Problem instance (copied on a cache miss, never modified)
+     * @param budget Budget and seed of the run
+     * @return Future of the result (rethrows exceptions of the run)
+     */
+    std::future<SolveResult> submit(std::shared_ptr<ProblemInstance> instance, const SolveBudget& budget = SolveBudget{});
+
+    /**
+     * @brief Queue an instance given by its processing times
+     * @param processing_times Processing times [job][machine]
+     * @param budget Budget and seed of the run
+     * @return Future of the result
+     */
+    std::future<SolveResult> submit(const std::vector<std::vector<int>>& processing_times,
+                                    const SolveBudget& budget = SolveBudget{});
+
+    /**
+     * @brief Snapshot of the counters
+     * @return Statistics
+     */
+    SolverServiceStatistics getStatistics();
+
+    /**
+     * @brief Requests queued and not taken by a worker yet
+     * @return Queue length
+     */
+    size_t getQueueLength();
+
+    const HHOAParameters& getParameters() const { return parameters_; }
+    const SolverServiceParameters& getServiceParameters() const { return service_parameters_; }
+
+private:
+    /**
+     * @brief Shared instance with the same content, inserting it on a miss (mutex held)
+     * @param instance Submitted instance
+     * @param checksum Its ProblemInstance::getChecksum
+     * @param cached Set to true on a cache hit
+     * @return Instance the job runs on
+     */
+    std::shared_ptr<ProblemInstance> acquireInstance(const std::shared_ptr<ProblemInstance>& instance,
+                                                     std::uint64_t checksum, bool& cached);
+
+    /**
+     * @brief Worker thread body
+     * @param index Worker index
+     * @param seed Seed of the worker's own generator
+     */
+    void workerLoop(int index, std::uint64_t seed);
+};
+
+#endif // SOLVER_SERVICE_H
@@ -0,0 +1,98 @@
+#include "StatisticsSink.h"
+#include <iostream>
+#include <cstdio>
+
+IterationHistory::IterationHistory(size_t capacity)
+    : capacity_(capacity), oldest_(0) {
+}
+
+void IterationHistory::push(const IterationRecord& record) {
+    if (capacity_ == 0 || records_.size() < capacity_) {
+        records_.push_back(record);
+        return;
+    }
+
+    records_[oldest_] = record;
+    oldest_ = (oldest_ + 1) % capacity_;
+}
+
+void IterationHistory::clear() {
+    records_.clear();
+    oldest_ = 0;
+}
+
+std::vector<IterationRecord> IterationHistory::toVector() const {
+    std::vector<IterationRecord> records;
+    records.reserve(records_.size());
+    for (size_t i = 0; i < records_.size(); ++i) {
+        records.push_back((*this)[i]);
+    }
+    return records;
+}
+
+void IterationHistory::appendCsvRow(const IterationRecord& record, std::string& out) {
+    // %g with 6 digits: the default formatting of an ostream
+    char row[96];
+    int length = std::snprintf(row, sizeof(row), "%d,%d,%g,%g\n", record.iteration, record.best_makespan,
+                               record.diversity, record.average_fitness);
+    out.append(row, length);
+}
+
+bool StatisticsSink::open(const std::string& filename, bool append) {
+    close();
+    filename_ = filename;
+
+    // Appending to an empty or missing file still needs the header
+    bool has_header = false;
+    if (append) {
+        std::ifstream existing(filename, std::ios::binary | std::ios::ate);
+        has_header = existing.is_open() && existing.tellg() > 0;
+    }
+
+    file_.open(filename, append ? std::ios::app : std::ios::trunc);
+    if (!file_.is_open()) {
+        std::cerr << "Error: Cannot create statistics file " << filename << std::endl;
+        return false;
+    }
+
+    buffer_.reserve(kBufferSize + 128);
+    if (!has_header) {
+        buffer_ += IterationHistory::csvHeader();
+        buffer_ += '\n';
+    }
+    return true;
+}
+
+void StatisticsSink::write(const IterationRecord& record) {
+    if (!file_.is_open()) {
+        return;
+    }
+
+    IterationHistory::appendCsvRow(record, buffer_);
+    if (buffer_.size() >= kBufferSize) {
+        flush();
+    }
+}
+
+bool StatisticsSink::flush() {
+    if (!file_.is_open()) {
+        return false;
+    }
+
+    file_.write(buffer_.data(), buffer_.size());
+    file_.flush();
+    buffer_.clear();
+    if (!file_) {
+        std::cerr << "Error: Cannot write statistics file " << filename_ << std::endl;
+        file_.close();
+        return false;
+    }
+    return true;
+}
+
+void StatisticsSink::close() {
+    if (file_.is_open()) {
+        flush();
+        file_.close();
+    }
+}
@@ -0,0 +1,150 @@
+#ifndef STATISTICS_SINK_H
+#define STATISTICS_SINK_H
+
+#include <cstddef>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Statistics of one recorded iteration
+ */
+struct IterationRecord {
+    int iteration = 0;              // Iteration number
+    int best_makespan = 0;          // Best makespan after the iteration
+    double diversity = 0.0;         // Herd diversity after the iteration
+    double average_fitness = 0.0;   // Average fitness of the herd
+
+    bool operator==(const IterationRecord& other) const {
+        return iteration == other.iteration && best_makespan == other.best_makespan &&
+               diversity == other.diversity && average_fitness == other.average_fitness;
+    }
+};
+
+/**
+ * @brief Bounded ring of the newest iteration records
+ *
+ * Once the capacity is reached every new record overwrites the oldest one,
+ * so memory stays constant however long the run is.
+ */
+class IterationHistory {
+public:
+    static constexpr size_t kDefaultCapacity = 10000;  // Records kept by default
+
+private:
+    std::vector<IterationRecord> records_;   // Ring storage
+    size_t capacity_;                        // Maximum records kept (0: unbounded)
+    size_t oldest_;                          // Index of the oldest record once full
+
+public:
+    /**
+     * @brief Constructor keeping kDefaultCapacity records
+     */
+    IterationHistory() : IterationHistory(kDefaultCapacity) {}
+
+    /**
+     * @brief Constructor
+     * @param capacity Maximum records kept (0: unbounded)
+     */
+    explicit IterationHistory(size_t capacity);
+
+    /**
+     * @brief Append a record, evicting the oldest one when full
+     * @param record Record
+     */
+    void push(const IterationRecord& record);
+
+    /**
+     * @brief Remove every record
+     */
+    void clear();
+
+    /**
+     * @brief Record by age
+     * @param index 0 for the oldest kept record, size() - 1 for the newest
+     * @return Record
+     */
+    const IterationRecord& operator[](size_t index) const {
+        return records_[capacity_ > 0 && records_.size() == capacity_ ? (oldest_ + index) % capacity_ : index];
+    }
+
+    const IterationRecord& back() const { return (*this)[records_.size() - 1]; }
+    size_t size() const { return records_.size(); }
+    bool empty() const { return records_.empty(); }
+    size_t getCapacity() const { return capacity_; }
+
+    /**
+     * @brief Copy of the kept records
+     * @return Records, oldest first
+     */
+    std::vector<IterationRecord> toVector() const;
+
+    /**
+     * @brief Format a record as a CSV row (Iteration,BestMakespan,Diversity,AverageFitness)
+     * @param record Record
+     * @param out String the row and its newline are appended to
+     */
+    static void appendCsvRow(const IterationRecord& record, std::string& out);
+
+    /**
+     * @brief CSV header matching appendCsvRow
+     * @return Header line without newline
+     */
+    static const char* csvHeader() { return "Iteration,BestMakespan,Diversity,AverageFitness"; }
+};
+
+/**
+ * @brief Streams iteration records to a CSV file while a run progresses
+ *
+ * Rows are formatted into an in-memory buffer and written in blocks of
+ * about kBufferSize bytes instead of one flush per row.
+ */
+class StatisticsSink {
+public:
+    static constexpr size_t kBufferSize = 64 * 1024;  // Bytes buffered before a write
+
+private:
+    std::ofstream file_;     // Destination
+    std::string buffer_;     // Rows not written yet
+    std::string filename_;   // Name of the destination (for errors)
+
+public:
+    StatisticsSink() = default;
+    ~StatisticsSink() { close(); }
+
+    StatisticsSink(const StatisticsSink&) = delete;
+    StatisticsSink& operator=(const StatisticsSink&) = delete;
+
+    /**
+     * @brief Open the destination
+     * @param filename CSV file
+     * @param append Continue an existing file instead of starting a new one
+     * @return True if successful
+     */
+    bool open(const std::string& filename, bool append = false);
+
+    /**
+     * @brief Whether a destination is open
+     * @return True after a successful open
+     */
+    bool isOpen() const { return file_.is_open(); }
+
+    /**
+     * @brief Queue a record, writing the buffer once it is full
+     * @param record Record
+     */
+    void write(const IterationRecord& record);
+
+    /**
+     * @brief Write the buffered rows
+     * @return True if the file is still good
+     */
+    bool flush();
+
+    /**
+     * @brief Write the buffered rows and close the file
+     */
+    void close();
+};
+
+#endif // STATISTICS_SINK_H
@@ -0,0 +1,49 @@
+#include "EvaluationCache.h"
+#include <stdexcept>
+
+EvaluationCache::EvaluationCache(int capacity)
+    : stripes_(new std::mutex[kStripes]), mask_(0), hits_(0), misses_(0) {
+    if (capacity <= 0) {
+        throw std::invalid_argument("Cache capacity must be positive");
+    }
+
+    std::uint64_t size = 1;
+    while (size < static_cast<std::uint64_t>(capacity)) {
+        size <<= 1;
+    }
+    entries_.resize(size);
+    mask_ = size - 1;
+}
+
+bool EvaluationCache::lookup(std::uint64_t hash, int& makespan) {
+    std::uint64_t slot = slotOf(hash);
+    bool hit = false;
+    {
+        std::lock_guard<std::mutex> lock(stripes_[slot % kStripes]);
+        const Entry& entry = entries_[slot];
+        if (entry.makespan >= 0 && entry.hash == hash) {
+            makespan = entry.makespan;
+            hit = true;
+        }
+    }
+
+    (hit ? hits_ : misses_).fetch_add(1, std::memory_order_relaxed);
+    return hit;
+}
+
+void EvaluationCache::insert(std::uint64_t hash, int makespan) {
+    std::uint64_t slot = slotOf(hash);
+    std::lock_guard<std::mutex> lock(stripes_[slot % kStripes]);
+    entries_[slot] = Entry{hash, makespan};
+}
+
+void EvaluationCache::clear() {
+    for (int stripe = 0; stripe < kStripes; ++stripe) {
+        std::lock_guard<std::mutex> lock(stripes_[stripe]);
+        for (std::uint64_t slot = stripe; slot < entries_.size(); slot += kStripes) {
+            entries_[slot] = Entry{};
+        }
+    }
+    hits_.store(0, std::memory_order_relaxed);
+    misses_.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,74 @@
+#ifndef EVALUATION_CACHE_H
+#define EVALUATION_CACHE_H
+
+#include <vector>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <memory>
+
+/**
+ * @brief Bounded, thread-safe map from permutation fingerprints to makespans
+ *
+ * A direct-mapped table of fixed capacity: each fingerprint (see
+ * Solution::getHash) has one slot, and a newer entry simply overwrites an
+ * older one. Slots are grouped into lock stripes so concurrent lookups from
+ * different horses rarely contend.
+ */
+class EvaluationCache {
+private:
+    struct Entry {
+        std::uint64_t hash = 0;   // Fingerprint of the permutation
+        int makespan = -1;        // Makespan (-1: empty slot)
+    };
+
+    static constexpr int kStripes = 64;  // Lock stripes
+
+    std::vector<Entry> entries_;                 // Slot table (capacity is a power of two)
+    std::unique_ptr<std::mutex[]> stripes_;      // Stripe i guards the slots with (slot % kStripes) == i
+    std::uint64_t mask_;                         // capacity - 1
+    std::atomic<long long> hits_;                // Successful lookups
+    std::atomic<long long> misses_;              // Failed lookups
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Number of slots (rounded up to a power of two, must be positive)
+     */
+    explicit EvaluationCache(int capacity);
+
+    // Getters
+    int getCapacity() const { return entries_.size(); }
+    long long getHits() const { return hits_.load(std::memory_order_relaxed); }
+    long long getMisses() const { return misses_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Look up a makespan
+     * @param hash Permutation fingerprint
+     * @param makespan Output: cached makespan on a hit
+     * @return True on a hit
+     */
+    bool lookup(std::uint64_t hash, int& makespan);
+
+    /**
+     * @brief Store a makespan, replacing the slot's previous entry
+     * @param hash Permutation fingerprint
+     * @param makespan Makespan of the permutation
+     */
+    void insert(std::uint64_t hash, int makespan);
+
+    /**
+     * @brief Remove all entries and reset the counters
+     */
+    void clear();
+
+private:
+    /**
+     * @brief Slot of a fingerprint
+     * @param hash Permutation fingerprint
+     * @return Slot index
+     */
+    std::uint64_t slotOf(std::uint64_t hash) const { return (hash ^ (hash >> 32)) & mask_; }
+};
+
+#endif // EVALUATION_CACHE_H
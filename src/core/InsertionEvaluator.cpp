@@ -0,0 +1,84 @@
+#include "InsertionEvaluator.h"
+#include "Objective.h"
+#include "../utils/Profiler.h"
+#include "../utils/ThreadPool.h"
+#include <algorithm>
+#include <stdexcept>
+
+InsertionEvaluator::InsertionEvaluator(std::shared_ptr<ProblemInstance> instance)
+    : instance_(instance), kernels_(nullptr) {
+    if (!instance_ || !instance_->isValid()) {
+        throw std::invalid_argument("Invalid problem instance");
+    }
+    kernels_ = &MakespanKernels::select(instance_->getNumMachines());
+}
+
+int InsertionEvaluator::evaluateInsertions(const std::vector<int>& sequence, int job,
+                                           std::vector<int>& makespans, ThreadPool* pool) {
+    int k = sequence.size();
+
+    makespans.resize(k + 1);
+    HHOA_COUNT_EVALUATIONS(k + 1);
+
+    ObjectiveType objective = instance_->getObjective();
+    if (objective != ObjectiveType::MAKESPAN) {
+        // The objective's own sweep, on the calling thread
+        return visitObjective(objective, [&](auto policy) {
+            return decltype(policy)::insertionSweep(*instance_, sequence.data(), k, job, makespans.data(),
+                                                    heads_, tails_);
+        });
+    }
+
+    buildHeadsAndTails(sequence);
+
+    int num_chunks = pool ? std::min(pool->getNumThreads(), (k + 1) / kMinChunkPositions) : 1;
+    if (num_chunks <= 1) {
+        return kernels_->insertion_sweep(*instance_, heads_.data(), tails_.data(), job, k, makespans.data());
+    }
+
+    // Chunk c scores positions [begin, end): a sweep over rows begin..end-1 of the matrices
+    int num_machines = instance_->getNumMachines();
+    chunk_best_.resize(num_chunks);
+    pool->parallelFor(num_chunks, [&](int c) {
+        int begin = static_cast<int>(static_cast<long long>(k + 1) * c / num_chunks);
+        int end = static_cast<int>(static_cast<long long>(k + 1) * (c + 1) / num_chunks);
+        chunk_best_[c] = begin + kernels_->insertion_sweep(*instance_, heads_.data() + begin * num_machines,
+                                                           tails_.data() + begin * num_machines, job,
+                                                           end - begin - 1, makespans.data() + begin);
+    });
+
+    // Chunks are in position order: keep the first best one, as a single sweep does
+    int best = chunk_best_[0];
+    for (int c = 1; c < num_chunks; ++c) {
+        if (makespans[chunk_best_[c]] < makespans[best]) {
+            best = chunk_best_[c];
+        }
+    }
+    return best;
+}
+
+int InsertionEvaluator::evaluateReinsertions(const std::vector<int>& sequence, int position,
+                                             std::vector<int>& makespans) {
+    if (position < 0 || position >= static_cast<int>(sequence.size())) {
+        throw std::out_of_range("Invalid position");
+    }
+
+    partial_sequence_.assign(sequence.begin(), sequence.end());
+    partial_sequence_.erase(partial_sequence_.begin() + position);
+
+    return evaluateInsertions(partial_sequence_, sequence[position], makespans);
+}
+
+void InsertionEvaluator::buildHeadsAndTails(const std::vector<int>& sequence) {
+    int num_machines = instance_->getNumMachines();
+    int k = sequence.size();
+
+    heads_.resize((k + 1) * num_machines);
+    tails_.resize((k + 1) * num_machines);
+
+    // Heads: row r holds the completion times of the first r jobs (row 0 is empty)
+    kernels_->build_heads(*instance_, sequence.data(), k, heads_.data());
+
+    // Tails: row r holds the time from the start of job r on each machine to the end (row k is empty)
+    kernels_->build_tails(*instance_, sequence.data(), k, tails_.data());
+}
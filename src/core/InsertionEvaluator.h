@@ -0,0 +1,77 @@
+#ifndef INSERTION_EVALUATOR_H
+#define INSERTION_EVALUATOR_H
+
+#include <vector>
+#include <memory>
+#include "ProblemInstance.h"
+#include "MakespanKernels.h"
+
+class ThreadPool;
+
+/**
+ * @brief Accelerated evaluation of the insertion neighborhood (Taillard, 1990)
+ *
+ * For a partial sequence of k jobs, the head matrix (earliest completion times)
+ * and the tail matrix (latest start times measured from the end) are built once.
+ * The makespan of inserting a job at any of the k+1 positions is then obtained
+ * in O(m), so a whole insertion sweep costs O(k*m) instead of O(k^2*m).
+ * The sweeps run on the kernels selected for the machine count (see
+ * MakespanKernels). Under another objective of the instance the sweep is
+ * that objective's insertionSweep (see Objective.h) and the makespans are
+ * its values.
+ */
+class InsertionEvaluator {
+public:
+    static constexpr int kMinChunkPositions = 64;  // Fewest positions a parallel chunk scores
+
+private:
+    std::shared_ptr<ProblemInstance> instance_;  // Problem instance
+    const MakespanKernels* kernels_;             // Kernels for the machine count of the instance
+    std::vector<int> heads_;                     // heads_[r*m + j]: completion of first r jobs on machine j
+    std::vector<int> tails_;                     // tails_[r*m + j]: tail from position r on machine j
+    std::vector<int> partial_sequence_;          // Scratch sequence with one job removed
+    std::vector<int> chunk_best_;                // Scratch: best position of each parallel chunk
+
+public:
+    /**
+     * @brief Constructor
+     * @param instance Problem instance
+     */
+    explicit InsertionEvaluator(std::shared_ptr<ProblemInstance> instance);
+
+    // Getters
+    const std::shared_ptr<ProblemInstance>& getInstance() const { return instance_; }
+
+    /**
+     * @brief Evaluate inserting a job at every position of a partial sequence
+     * @param sequence Partial job sequence (must not contain the job)
+     * @param job Job to insert
+     * @param makespans Output: makespans[k] is the makespan with the job inserted before position k
+     *                  (k = 0..sequence.size())
+     * @param pool Threads scoring the positions in chunks of at least kMinChunkPositions
+     *             (null: the calling thread only; other objectives than the makespan
+     *             always sweep on the calling thread). The result does not depend on it.
+     * @return Position with the smallest makespan (first one on ties)
+     */
+    int evaluateInsertions(const std::vector<int>& sequence, int job, std::vector<int>& makespans,
+                           ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Evaluate moving the job at a position to every position of the sequence
+     * @param sequence Complete job sequence
+     * @param position Position of the job to remove
+     * @param makespans Output: makespans[k] is the makespan with the removed job reinserted
+     *                  before position k of the reduced sequence (k = 0..sequence.size()-1)
+     * @return Position with the smallest makespan (first one on ties)
+     */
+    int evaluateReinsertions(const std::vector<int>& sequence, int position, std::vector<int>& makespans);
+
+private:
+    /**
+     * @brief Build head and tail matrices for a partial sequence
+     * @param sequence Partial job sequence
+     */
+    void buildHeadsAndTails(const std::vector<int>& sequence);
+};
+
+#endif // INSERTION_EVALUATOR_H
@@ -0,0 +1,143 @@
+#include "MakespanEvaluator.h"
+#include "Objective.h"
+#include "../utils/Profiler.h"
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+MakespanEvaluator::MakespanEvaluator(std::shared_ptr<ProblemInstance> instance)
+    : instance_(instance), cache_(nullptr) {
+    if (!instance_ || !instance_->isValid()) {
+        throw std::invalid_argument("Invalid problem instance");
+    }
+    rows_.resize(static_cast<size_t>(instance_->getNumMachines()) * kLanes);
+}
+
+void MakespanEvaluator::evaluate(const std::vector<std::vector<int>>& sequences, std::vector<int>& makespans) {
+    batch_sequences_.clear();
+    for (const auto& sequence : sequences) {
+        if (sequence.size() != static_cast<size_t>(instance_->getNumJobs())) {
+            throw std::invalid_argument("Job sequence size does not match problem instance");
+        }
+        batch_sequences_.push_back(sequence.data());
+    }
+    
+    makespans.resize(sequences.size());
+    evaluate(batch_sequences_.data(), batch_sequences_.size(), makespans.data());
+}
+
+void MakespanEvaluator::evaluate(std::vector<Solution>& solutions) {
+    batch_sequences_.clear();
+    batch_solutions_.clear();
+    for (auto& solution : solutions) {
+        if (solution.makespan_calculated_) {
+            continue;
+        }
+        
+        int cached_makespan = 0;
+        if (cache_ && cache_->lookup(solution.getHash(), cached_makespan)) {
+            solution.setKnownMakespan(cached_makespan);
+            continue;
+        }
+        
+        batch_sequences_.push_back(solution.job_sequence_.data());
+        batch_solutions_.push_back(&solution);
+    }
+    
+    batch_makespans_.resize(batch_sequences_.size());
+    evaluate(batch_sequences_.data(), batch_sequences_.size(), batch_makespans_.data());
+    
+    for (size_t i = 0; i < batch_solutions_.size(); ++i) {
+        batch_solutions_[i]->setKnownMakespan(batch_makespans_[i]);
+        if (cache_) {
+            cache_->insert(batch_solutions_[i]->getHash(), batch_makespans_[i]);
+        }
+    }
+}
+
+void MakespanEvaluator::evaluate(const int* const* sequences, int count, int* makespans) {
+    int full_groups = count / kLanes;
+    HHOA_COUNT_EVALUATIONS(count);
+    
+    // The lanes run the makespan recurrence: other objectives are scored one by one
+    if (instance_->getObjective() != ObjectiveType::MAKESPAN) {
+        int num_jobs = instance_->getNumJobs();
+        visitObjective(instance_->getObjective(), [&](auto policy) {
+            for (int i = 0; i < count; ++i) {
+                makespans[i] = decltype(policy)::evaluate(*instance_, sequences[i], num_jobs);
+            }
+        });
+        return;
+    }
+    
+    for (int group = 0; group < full_groups; ++group) {
+        evaluateGroup(sequences + group * kLanes, makespans + group * kLanes);
+    }
+    
+    // Pad the last partial group by repeating its first sequence
+    int remaining = count - full_groups * kLanes;
+    if (remaining > 0) {
+        const int* padded[kLanes];
+        int padded_makespans[kLanes];
+        const int* const* rest = sequences + full_groups * kLanes;
+        
+        for (int lane = 0; lane < kLanes; ++lane) {
+            padded[lane] = lane < remaining ? rest[lane] : rest[0];
+        }
+        
+        evaluateGroup(padded, padded_makespans);
+        std::copy(padded_makespans, padded_makespans + remaining, makespans + full_groups * kLanes);
+    }
+}
+
+void MakespanEvaluator::evaluateGroup(const int* const* sequences, int* makespans) {
+    int num_jobs = instance_->getNumJobs();
+    int num_machines = instance_->getNumMachines();
+    int* rows = rows_.data();
+    
+    std::fill(rows_.begin(), rows_.end(), 0);
+    
+    alignas(64) int jobs[kLanes];
+    
+    for (int pos = 0; pos < num_jobs; ++pos) {
+        for (int lane = 0; lane < kLanes; ++lane) {
+            jobs[lane] = sequences[lane][pos];
+        }
+        
+        // C[pos][machine] = max(C[pos-1][machine], C[pos][machine-1]) + p[job][machine], for all lanes
+#if defined(__AVX512F__)
+        __m512i job_indices = _mm512_load_si512(jobs);
+        __m512i previous = _mm512_setzero_si512();
+        for (int machine = 0; machine < num_machines; ++machine) {
+            __m512i times = _mm512_i32gather_epi32(job_indices, instance_->getMachineTimes(machine), 4);
+            __m512i row = _mm512_load_si512(rows + machine * kLanes);
+            previous = _mm512_add_epi32(_mm512_max_epi32(row, previous), times);
+            _mm512_store_si512(rows + machine * kLanes, previous);
+        }
+#elif defined(__AVX2__)
+        __m256i job_indices = _mm256_load_si256(reinterpret_cast<const __m256i*>(jobs));
+        __m256i previous = _mm256_setzero_si256();
+        for (int machine = 0; machine < num_machines; ++machine) {
+            __m256i times = _mm256_i32gather_epi32(instance_->getMachineTimes(machine), job_indices, 4);
+            __m256i* row_ptr = reinterpret_cast<__m256i*>(rows + machine * kLanes);
+            previous = _mm256_add_epi32(_mm256_max_epi32(_mm256_load_si256(row_ptr), previous), times);
+            _mm256_store_si256(row_ptr, previous);
+        }
+#else
+        int previous[kLanes] = {0};
+        for (int machine = 0; machine < num_machines; ++machine) {
+            const int* machine_times = instance_->getMachineTimes(machine);
+            int* row = rows + machine * kLanes;
+            for (int lane = 0; lane < kLanes; ++lane) {
+                previous[lane] = std::max(row[lane], previous[lane]) + machine_times[jobs[lane]];
+                row[lane] = previous[lane];
+            }
+        }
+#endif
+    }
+    
+    std::copy(rows + (num_machines - 1) * kLanes, rows + num_machines * kLanes, makespans);
+}
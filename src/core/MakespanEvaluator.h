@@ -0,0 +1,84 @@
+#ifndef MAKESPAN_EVALUATOR_H
+#define MAKESPAN_EVALUATOR_H
+
+#include <vector>
+#include <memory>
+#include "ProblemInstance.h"
+#include "Solution.h"
+#include "EvaluationCache.h"
+
+/**
+ * @brief Batch makespan evaluation of many permutations at once
+ *
+ * Candidate sequences are processed side by side in groups of kLanes: the
+ * max-plus recurrence advances every lane of a group with one vector
+ * instruction per machine (AVX-512 or AVX2 when the compiler targets them,
+ * a lane loop the compiler may auto-vectorize otherwise). Under another
+ * objective of the instance the sequences are evaluated one at a time by
+ * that objective (see Objective.h).
+ */
+class MakespanEvaluator {
+public:
+#if defined(__AVX512F__)
+    static constexpr int kLanes = 16;  // Sequences advanced per instruction
+#else
+    static constexpr int kLanes = 8;   // Sequences advanced per instruction
+#endif
+
+private:
+    std::shared_ptr<ProblemInstance> instance_;  // Problem instance
+    AlignedIntVector rows_;                      // Scratch: completion rows [machine * kLanes + lane]
+    std::vector<const int*> batch_sequences_;    // Scratch: sequence pointers of the current batch
+    std::vector<int> batch_makespans_;           // Scratch: makespans of the current batch
+    std::vector<Solution*> batch_solutions_;     // Scratch: solutions of the current batch
+    EvaluationCache* cache_;                     // Optional fingerprint cache (not owned)
+
+public:
+    /**
+     * @brief Constructor
+     * @param instance Problem instance
+     */
+    explicit MakespanEvaluator(std::shared_ptr<ProblemInstance> instance);
+
+    /**
+     * @brief Consult a fingerprint cache when evaluating solutions
+     * @param cache Cache shared by the callers (nullptr disables it)
+     */
+    void setCache(EvaluationCache* cache) { cache_ = cache; }
+
+    /**
+     * @brief Evaluate the makespan of several job sequences
+     * @param sequences Complete job sequences of the instance
+     * @param makespans Output: makespans[i] of sequences[i]
+     */
+    void evaluate(const std::vector<std::vector<int>>& sequences, std::vector<int>& makespans);
+
+    /**
+     * @brief Evaluate and cache the makespan of several solutions
+     *
+     * Solutions whose makespan is already cached are skipped. With a cache
+     * set, the remaining ones are first looked up by fingerprint and only
+     * misses are evaluated (and then inserted).
+     *
+     * @param solutions Solutions of the instance
+     */
+    void evaluate(std::vector<Solution>& solutions);
+
+    /**
+     * @brief Evaluate the makespan of sequences given as raw pointers
+     * @param sequences Pointers to num_jobs job indices each
+     * @param count Number of sequences
+     * @param makespans Output buffer of count values
+     */
+    void evaluate(const int* const* sequences, int count, int* makespans);
+
+private:
+    /**
+     * @brief Evaluate one group of exactly kLanes sequences
+     * @param sequences kLanes sequence pointers
+     * @param makespans Output buffer of kLanes values
+     */
+    void evaluateGroup(const int* const* sequences, int* makespans);
+};
+
+#endif // MAKESPAN_EVALUATOR_H
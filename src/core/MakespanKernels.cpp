@@ -0,0 +1,132 @@
+#include "MakespanKernels.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+// Fully unroll the machine loops of the fixed-M instantiations
+#if defined(__GNUC__)
+#define HHOA_UNROLL_MACHINES _Pragma("GCC unroll 32")
+#else
+#define HHOA_UNROLL_MACHINES
+#endif
+
+// Machine count of an instantiation (M == 0: taken from the instance)
+template<int M>
+inline int machineCount(const ProblemInstance& instance) {
+    return M > 0 ? M : instance.getNumMachines();
+}
+
+template<int M>
+int makespanKernel(const ProblemInstance& instance, const int* sequence, int count) {
+    const int num_machines = machineCount<M>(instance);
+    
+    // Fixed M: a local row the compiler can keep in registers
+    int fixed_row[M > 0 ? M : 1] = {0};
+    static thread_local std::vector<int> dynamic_row;
+    int* row = fixed_row;
+    if (M == 0) {
+        dynamic_row.assign(num_machines, 0);
+        row = dynamic_row.data();
+    }
+    
+    for (int pos = 0; pos < count; ++pos) {
+        const int* times = instance.getJobTimes(sequence[pos]);
+        
+        row[0] += times[0];
+        HHOA_UNROLL_MACHINES
+        for (int machine = 1; machine < num_machines; ++machine) {
+            row[machine] = std::max(row[machine], row[machine - 1]) + times[machine];
+        }
+    }
+    
+    return count > 0 ? row[num_machines - 1] : 0;
+}
+
+template<int M>
+void buildHeadsKernel(const ProblemInstance& instance, const int* sequence, int count, int* heads) {
+    const int num_machines = machineCount<M>(instance);
+    std::fill(heads, heads + num_machines, 0);
+    
+    for (int r = 1; r <= count; ++r) {
+        const int* times = instance.getJobTimes(sequence[r - 1]);
+        const int* prev = heads + (r - 1) * num_machines;
+        int* row = heads + r * num_machines;
+        
+        int completion = 0;
+        HHOA_UNROLL_MACHINES
+        for (int machine = 0; machine < num_machines; ++machine) {
+            completion = std::max(completion, prev[machine]) + times[machine];
+            row[machine] = completion;
+        }
+    }
+}
+
+template<int M>
+void buildTailsKernel(const ProblemInstance& instance, const int* sequence, int count, int* tails) {
+    const int num_machines = machineCount<M>(instance);
+    std::fill(tails + count * num_machines, tails + (count + 1) * num_machines, 0);
+    
+    for (int r = count - 1; r >= 0; --r) {
+        const int* times = instance.getJobTimes(sequence[r]);
+        const int* next = tails + (r + 1) * num_machines;
+        int* row = tails + r * num_machines;
+        
+        int tail = 0;
+        HHOA_UNROLL_MACHINES
+        for (int machine = num_machines - 1; machine >= 0; --machine) {
+            tail = std::max(tail, next[machine]) + times[machine];
+            row[machine] = tail;
+        }
+    }
+}
+
+template<int M>
+int insertionSweepKernel(const ProblemInstance& instance, const int* heads, const int* tails,
+                         int job, int count, int* makespans) {
+    const int num_machines = machineCount<M>(instance);
+    const int* times = instance.getJobTimes(job);
+    
+    int best_position = 0;
+    for (int pos = 0; pos <= count; ++pos) {
+        const int* head = heads + pos * num_machines;
+        const int* tail = tails + pos * num_machines;
+        
+        // Completion times of the inserted job right after the first pos jobs
+        int completion = 0;
+        int makespan = 0;
+        HHOA_UNROLL_MACHINES
+        for (int machine = 0; machine < num_machines; ++machine) {
+            completion = std::max(completion, head[machine]) + times[machine];
+            makespan = std::max(makespan, completion + tail[machine]);
+        }
+        
+        makespans[pos] = makespan;
+        if (makespan < makespans[best_position]) {
+            best_position = pos;
+        }
+    }
+    
+    return best_position;
+}
+
+template<int M>
+const MakespanKernels& kernelTable() {
+    static const MakespanKernels table = {
+        M, makespanKernel<M>, buildHeadsKernel<M>, buildTailsKernel<M>, insertionSweepKernel<M>
+    };
+    return table;
+}
+}
+
+const MakespanKernels& MakespanKernels::select(int num_machines) {
+    switch (num_machines) {
+        case 5:  return kernelTable<5>();
+        case 10: return kernelTable<10>();
+        case 20: return kernelTable<20>();
+        default: return kernelTable<0>();
+    }
+}
+
+const MakespanKernels& MakespanKernels::generic() {
+    return kernelTable<0>();
+}
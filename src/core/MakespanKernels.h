@@ -0,0 +1,72 @@
+#ifndef MAKESPAN_KERNELS_H
+#define MAKESPAN_KERNELS_H
+
+#include "ProblemInstance.h"
+
+/**
+ * @brief Makespan recurrences specialized for common machine counts
+ *
+ * The kernels are templates on the machine count M. For the machine counts
+ * of the Taillard benchmarks (5, 10 and 20) the machine loop has a constant
+ * trip count, so it is fully unrolled and the completion row stays in
+ * registers; every other count uses the generic runtime-m instantiation.
+ * select() picks the table once from ProblemInstance::getNumMachines().
+ */
+struct MakespanKernels {
+    int num_machines;  // Machine count the kernels apply to (0: any)
+
+    /**
+     * @brief Makespan of a job sequence (rolling row, no matrix)
+     * @param instance Problem instance
+     * @param sequence Job indices
+     * @param count Number of jobs in the sequence
+     * @return Makespan (0 for an empty sequence)
+     */
+    int (*makespan)(const ProblemInstance& instance, const int* sequence, int count);
+
+    /**
+     * @brief Head matrix of a partial sequence
+     * @param instance Problem instance
+     * @param sequence Job indices
+     * @param count Number of jobs in the sequence
+     * @param heads Output: (count + 1) * m values, row r holds the completion times of the first r jobs
+     */
+    void (*build_heads)(const ProblemInstance& instance, const int* sequence, int count, int* heads);
+
+    /**
+     * @brief Tail matrix of a partial sequence
+     * @param instance Problem instance
+     * @param sequence Job indices
+     * @param count Number of jobs in the sequence
+     * @param tails Output: (count + 1) * m values, row r holds the time from the start of job r to the end
+     */
+    void (*build_tails)(const ProblemInstance& instance, const int* sequence, int count, int* tails);
+
+    /**
+     * @brief Makespans of inserting a job at every position of a partial sequence
+     * @param instance Problem instance
+     * @param heads Head matrix of the partial sequence
+     * @param tails Tail matrix of the partial sequence
+     * @param job Job to insert
+     * @param count Number of jobs in the partial sequence
+     * @param makespans Output: count + 1 values, makespans[k] with the job inserted before position k
+     * @return Position with the smallest makespan (first one on ties)
+     */
+    int (*insertion_sweep)(const ProblemInstance& instance, const int* heads, const int* tails,
+                           int job, int count, int* makespans);
+
+    /**
+     * @brief Kernels for a machine count
+     * @param num_machines Number of machines of the instance
+     * @return Specialized kernels if available, otherwise the generic ones
+     */
+    static const MakespanKernels& select(int num_machines);
+
+    /**
+     * @brief Generic runtime-m kernels (valid for any machine count)
+     * @return Kernel table
+     */
+    static const MakespanKernels& generic();
+};
+
+#endif // MAKESPAN_KERNELS_H
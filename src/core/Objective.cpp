@@ -0,0 +1,297 @@
+#include "Objective.h"
+#include "MakespanKernels.h"
+#include <algorithm>
+#include <climits>
+
+namespace {
+// Row steps: turn the completion row of the previous job (all zero before
+// the first job) into the row of the next job, in place.
+
+// Permutation flow shop: wait for the machine and for the previous operation
+inline void permutationStep(const ProblemInstance& instance, int, int job, int* row) {
+    const int num_machines = instance.getNumMachines();
+    const int* times = instance.getJobTimes(job);
+    int completion = 0;
+    for (int machine = 0; machine < num_machines; ++machine) {
+        completion = std::max(completion, row[machine]) + times[machine];
+        row[machine] = completion;
+    }
+}
+
+// Anticipatory setups: a machine is set up for the job as soon as it is free
+inline void setupStep(const ProblemInstance& instance, int previous_job, int job, int* row) {
+    const int num_machines = instance.getNumMachines();
+    const int* times = instance.getJobTimes(job);
+    const int* setups = instance.getSetupTimes(previous_job, job);
+    int completion = 0;
+    for (int machine = 0; machine < num_machines; ++machine) {
+        completion = std::max(completion, row[machine] + setups[machine]) + times[machine];
+        row[machine] = completion;
+    }
+}
+
+// No-wait: the earliest start that finds every machine free when the job reaches it
+inline void noWaitStep(const ProblemInstance& instance, int, int job, int* row) {
+    const int num_machines = instance.getNumMachines();
+    const int* times = instance.getJobTimes(job);
+    int start = 0;
+    int work = 0;
+    for (int machine = 0; machine < num_machines; ++machine) {
+        start = std::max(start, row[machine] - work);
+        work += times[machine];
+    }
+    int completion = start;
+    for (int machine = 0; machine < num_machines; ++machine) {
+        completion += times[machine];
+        row[machine] = completion;
+    }
+}
+
+inline int totalWork(const ProblemInstance& instance, int job) {
+    const int* times = instance.getJobTimes(job);
+    int total = 0;
+    for (int machine = 0; machine < instance.getNumMachines(); ++machine) {
+        total += times[machine];
+    }
+    return total;
+}
+
+template<typename Step>
+void buildRows(const ProblemInstance& instance, const int* sequence, int first, int count, int* rows, Step step) {
+    const int num_machines = instance.getNumMachines();
+    for (int pos = first; pos < count; ++pos) {
+        int* row = rows + pos * num_machines;
+        if (pos > 0) {
+            std::copy(row - num_machines, row, row);
+        } else {
+            std::fill(row, row + num_machines, 0);
+        }
+        step(instance, pos > 0 ? sequence[pos - 1] : -1, sequence[pos], row);
+    }
+}
+
+// Sum: the value adds up the last machine of every row (flowtime), otherwise it is the last row's
+template<bool Sum, typename Step>
+int resumeRows(const ProblemInstance& instance, const int* sequence, int first, int count,
+               const int* rows, int bound, Step step) {
+    const int num_machines = instance.getNumMachines();
+    static thread_local std::vector<int> row;
+    row.assign(num_machines, 0);
+
+    int value = 0;
+    if (first > 0) {
+        std::copy_n(rows + (first - 1) * num_machines, num_machines, row.begin());
+        value = row[num_machines - 1];
+        if (Sum) {
+            value = 0;
+            for (int pos = 0; pos < first; ++pos) {
+                value += rows[pos * num_machines + num_machines - 1];
+            }
+        }
+    }
+
+    // Completion times on the last machine only grow: every partial value bounds the final one
+    for (int pos = first; pos < count; ++pos) {
+        step(instance, pos > 0 ? sequence[pos - 1] : -1, sequence[pos], row.data());
+        value = Sum ? value + row[num_machines - 1] : row[num_machines - 1];
+        if (value >= bound) {
+            return value;
+        }
+    }
+    return value;
+}
+
+inline int firstBest(const int* values, int count) {
+    return std::min_element(values, values + count) - values;
+}
+}
+
+int MakespanObjective::evaluate(const ProblemInstance& instance, const int* sequence, int count) {
+    return MakespanKernels::select(instance.getNumMachines()).makespan(instance, sequence, count);
+}
+
+void MakespanObjective::buildCompletionTimes(const ProblemInstance& instance, const int* sequence, int first,
+                                             int count, int* completion_times) {
+    buildRows(instance, sequence, first, count, completion_times, permutationStep);
+}
+
+int MakespanObjective::resume(const ProblemInstance& instance, const int* sequence, int first, int count,
+                              const int* completion_times, int bound) {
+    return resumeRows<false>(instance, sequence, first, count, completion_times, bound, permutationStep);
+}
+
+int MakespanObjective::insertionSweep(const ProblemInstance& instance, const int* sequence, int count, int job,
+                                      int* values, std::vector<int>& heads, std::vector<int>& tails) {
+    const int num_machines = instance.getNumMachines();
+    const MakespanKernels& kernels = MakespanKernels::select(num_machines);
+    heads.resize((count + 1) * num_machines);
+    tails.resize((count + 1) * num_machines);
+    kernels.build_heads(instance, sequence, count, heads.data());
+    kernels.build_tails(instance, sequence, count, tails.data());
+    return kernels.insertion_sweep(instance, heads.data(), tails.data(), job, count, values);
+}
+
+int TotalFlowtimeObjective::evaluate(const ProblemInstance& instance, const int* sequence, int count) {
+    return resumeRows<true>(instance, sequence, 0, count, nullptr, INT_MAX, permutationStep);
+}
+
+void TotalFlowtimeObjective::buildCompletionTimes(const ProblemInstance& instance, const int* sequence, int first,
+                                                  int count, int* completion_times) {
+    buildRows(instance, sequence, first, count, completion_times, permutationStep);
+}
+
+int TotalFlowtimeObjective::resume(const ProblemInstance& instance, const int* sequence, int first, int count,
+                                   const int* completion_times, int bound) {
+    return resumeRows<true>(instance, sequence, first, count, completion_times, bound, permutationStep);
+}
+
+int TotalFlowtimeObjective::insertionSweep(const ProblemInstance& instance, const int* sequence, int count, int job,
+                                           int* values, std::vector<int>& heads, std::vector<int>& tails) {
+    const int num_machines = instance.getNumMachines();
+
+    // heads row r: completion times of the first r jobs; tails[r]: their flowtime
+    heads.assign((count + 1) * num_machines, 0);
+    tails.assign(count + 1, 0);
+    buildRows(instance, sequence, 0, count, heads.data() + num_machines, permutationStep);
+    for (int r = 1; r <= count; ++r) {
+        tails[r] = tails[r - 1] + heads[r * num_machines + num_machines - 1];
+    }
+
+    static thread_local std::vector<int> row;
+    for (int pos = 0; pos <= count; ++pos) {
+        // The prefix is unchanged: replay the inserted job and the suffix from head row pos
+        row.assign(heads.begin() + pos * num_machines, heads.begin() + (pos + 1) * num_machines);
+        permutationStep(instance, -1, job, row.data());
+        int value = tails[pos] + row[num_machines - 1];
+        for (int r = pos; r < count; ++r) {
+            permutationStep(instance, -1, sequence[r], row.data());
+            value += row[num_machines - 1];
+        }
+        values[pos] = value;
+    }
+
+    return firstBest(values, count + 1);
+}
+
+int SdstMakespanObjective::evaluate(const ProblemInstance& instance, const int* sequence, int count) {
+    return resumeRows<false>(instance, sequence, 0, count, nullptr, INT_MAX, setupStep);
+}
+
+void SdstMakespanObjective::buildCompletionTimes(const ProblemInstance& instance, const int* sequence, int first,
+                                                 int count, int* completion_times) {
+    buildRows(instance, sequence, first, count, completion_times, setupStep);
+}
+
+int SdstMakespanObjective::resume(const ProblemInstance& instance, const int* sequence, int first, int count,
+                                  const int* completion_times, int bound) {
+    return resumeRows<false>(instance, sequence, first, count, completion_times, bound, setupStep);
+}
+
+int SdstMakespanObjective::insertionSweep(const ProblemInstance& instance, const int* sequence, int count, int job,
+                                          int* values, std::vector<int>& heads, std::vector<int>& tails) {
+    const int num_machines = instance.getNumMachines();
+    const int* times = instance.getJobTimes(job);
+
+    // heads row r: completion times of the first r jobs, setups included
+    heads.resize((count + 1) * num_machines);
+    std::fill(heads.begin(), heads.begin() + num_machines, 0);
+    buildRows(instance, sequence, 0, count, heads.data() + num_machines, setupStep);
+
+    // tails row r: longest path from the start of job r on a machine (after its setup) to the end
+    tails.assign((count + 1) * num_machines, 0);
+    for (int r = count - 1; r >= 0; --r) {
+        const int* job_times = instance.getJobTimes(sequence[r]);
+        const int* next = tails.data() + (r + 1) * num_machines;
+        const int* setups = r + 1 < count ? instance.getSetupTimes(sequence[r], sequence[r + 1]) : nullptr;
+        int* tail = tails.data() + r * num_machines;
+
+        int later = 0;
+        for (int machine = num_machines - 1; machine >= 0; --machine) {
+            int successor = setups ? setups[machine] + next[machine] : 0;
+            later = std::max(later, successor) + job_times[machine];
+            tail[machine] = later;
+        }
+    }
+
+    for (int pos = 0; pos <= count; ++pos) {
+        const int* head = heads.data() + pos * num_machines;
+        const int* tail = tails.data() + pos * num_machines;
+        const int* setups_in = instance.getSetupTimes(pos > 0 ? sequence[pos - 1] : -1, job);
+        const int* setups_out = pos < count ? instance.getSetupTimes(job, sequence[pos]) : nullptr;
+
+        // Paths into the rest of the sequence leave the inserted job through the setup to job pos
+        int completion = 0;
+        int makespan = 0;
+        for (int machine = 0; machine < num_machines; ++machine) {
+            completion = std::max(completion, head[machine] + setups_in[machine]) + times[machine];
+            if (setups_out) {
+                makespan = std::max(makespan, completion + setups_out[machine] + tail[machine]);
+            }
+        }
+        values[pos] = setups_out ? makespan : completion;
+    }
+
+    return firstBest(values, count + 1);
+}
+
+int NoWaitMakespanObjective::evaluate(const ProblemInstance& instance, const int* sequence, int count) {
+    if (count == 0) {
+        return 0;
+    }
+    int start = 0;
+    for (int pos = 1; pos < count; ++pos) {
+        start += instance.noWaitDelay(sequence[pos - 1], sequence[pos]);
+    }
+    return start + totalWork(instance, sequence[count - 1]);
+}
+
+void NoWaitMakespanObjective::buildCompletionTimes(const ProblemInstance& instance, const int* sequence, int first,
+                                                   int count, int* completion_times) {
+    buildRows(instance, sequence, first, count, completion_times, noWaitStep);
+}
+
+int NoWaitMakespanObjective::resume(const ProblemInstance& instance, const int* sequence, int first, int count,
+                                    const int* completion_times, int bound) {
+    return resumeRows<false>(instance, sequence, first, count, completion_times, bound, noWaitStep);
+}
+
+int NoWaitMakespanObjective::insertionSweep(const ProblemInstance& instance, const int* sequence, int count, int job,
+                                            int* values, std::vector<int>&, std::vector<int>&) {
+    int work = totalWork(instance, job);
+    if (count == 0) {
+        values[0] = work;
+        return 0;
+    }
+
+    // Replace the delay between the neighbors by the two delays through the job
+    int makespan = evaluate(instance, sequence, count);
+    values[0] = makespan + instance.noWaitDelay(job, sequence[0]);
+    for (int pos = 1; pos < count; ++pos) {
+        values[pos] = makespan - instance.noWaitDelay(sequence[pos - 1], sequence[pos]) +
+                      instance.noWaitDelay(sequence[pos - 1], job) + instance.noWaitDelay(job, sequence[pos]);
+    }
+    values[count] = makespan - totalWork(instance, sequence[count - 1]) +
+                    instance.noWaitDelay(sequence[count - 1], job) + work;
+
+    return firstBest(values, count + 1);
+}
+
+const char* objectiveName(ObjectiveType objective) {
+    switch (objective) {
+        case ObjectiveType::TOTAL_FLOWTIME:   return "flowtime";
+        case ObjectiveType::SDST_MAKESPAN:    return "sdst";
+        case ObjectiveType::NO_WAIT_MAKESPAN: return "nowait";
+        default:                              return "makespan";
+    }
+}
+
+bool parseObjective(const std::string& name, ObjectiveType& objective) {
+    for (ObjectiveType candidate : {ObjectiveType::MAKESPAN, ObjectiveType::TOTAL_FLOWTIME,
+                                    ObjectiveType::SDST_MAKESPAN, ObjectiveType::NO_WAIT_MAKESPAN}) {
+        if (name == objectiveName(candidate)) {
+            objective = candidate;
+            return true;
+        }
+    }
+    return false;
+}
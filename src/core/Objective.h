@@ -0,0 +1,179 @@
+#ifndef OBJECTIVE_H
+#define OBJECTIVE_H
+
+#include <string>
+#include <vector>
+#include "ProblemInstance.h"
+
+/*
+ * Objectives of a job sequence: one policy struct per ObjectiveType, all
+ * with the same static interface (documented on MakespanObjective). Code
+ * templated on a policy, or dispatched once per call with visitObjective,
+ * runs the recurrences without a virtual call; the plain makespan keeps the
+ * machine-count specialized kernels of MakespanKernels.
+ *
+ * A completion-time row holds, for one position of the sequence, the time
+ * the job's operation ends on every machine under the objective's schedule
+ * (after its setups, or as late as the no-wait constraint starts it).
+ */
+
+/**
+ * @brief Permutation flow shop makespan (Taillard insertion sweeps)
+ */
+struct MakespanObjective {
+    static constexpr ObjectiveType kType = ObjectiveType::MAKESPAN;
+
+    /**
+     * @brief Objective value of a sequence
+     * @param instance Problem instance
+     * @param sequence Job indices
+     * @param count Number of jobs in the sequence
+     * @return Value (0 for an empty sequence)
+     */
+    static int evaluate(const ProblemInstance& instance, const int* sequence, int count);
+
+    /**
+     * @brief Completion-time rows from a position on
+     * @param instance Problem instance
+     * @param sequence Job indices
+     * @param first First row to build (rows before it must be valid)
+     * @param count Number of jobs in the sequence
+     * @param completion_times Rows [position * m + machine]
+     */
+    static void buildCompletionTimes(const ProblemInstance& instance, const int* sequence, int first, int count,
+                                     int* completion_times);
+
+    /**
+     * @brief Objective value of a sequence whose leading rows are known
+     * @param instance Problem instance
+     * @param sequence Job indices
+     * @param first Number of leading positions whose rows are given
+     * @param count Number of jobs in the sequence
+     * @param completion_times Rows of positions 0..first-1 (may be null when first is 0)
+     * @param bound Abandon once the value is known to be at least this value
+     * @return Value if it is below bound, otherwise a value >= bound
+     */
+    static int resume(const ProblemInstance& instance, const int* sequence, int first, int count,
+                      const int* completion_times, int bound);
+
+    /**
+     * @brief Objective values of inserting a job at every position of a partial sequence
+     * @param instance Problem instance
+     * @param sequence Partial sequence (must not contain the job)
+     * @param count Number of jobs in the partial sequence
+     * @param job Job to insert
+     * @param values Output: count + 1 values, values[k] with the job inserted before position k
+     * @param heads Scratch buffer
+     * @param tails Scratch buffer
+     * @return Position with the smallest value (first one on ties)
+     */
+    static int insertionSweep(const ProblemInstance& instance, const int* sequence, int count, int job,
+                              int* values, std::vector<int>& heads, std::vector<int>& tails);
+};
+
+/**
+ * @brief Total flowtime: sum of the completion times on the last machine
+ *
+ * An insertion changes the completion times of every job after it, so a
+ * sweep reuses the head rows and the flowtime of the unchanged prefix and
+ * only replays the suffix: O(k^2 * m / 2) instead of O(k^2 * m). Values
+ * fit an int: ProblemInstance::setObjective rejects instances where they
+ * might not.
+ */
+struct TotalFlowtimeObjective {
+    static constexpr ObjectiveType kType = ObjectiveType::TOTAL_FLOWTIME;
+
+    static int evaluate(const ProblemInstance& instance, const int* sequence, int count);
+    static void buildCompletionTimes(const ProblemInstance& instance, const int* sequence, int first, int count,
+                                     int* completion_times);
+    static int resume(const ProblemInstance& instance, const int* sequence, int first, int count,
+                      const int* completion_times, int bound);
+    static int insertionSweep(const ProblemInstance& instance, const int* sequence, int count, int job,
+                              int* values, std::vector<int>& heads, std::vector<int>& tails);
+};
+
+/**
+ * @brief Makespan with anticipatory sequence-dependent setup times
+ *
+ * A machine is set up for the next job as soon as it is free, so the
+ * setups become edge weights of the Taillard graph: heads include the setup
+ * before each job and tails start after it, and an insertion sweep still
+ * costs O(m) per position plus the setups into and out of the job.
+ */
+struct SdstMakespanObjective {
+    static constexpr ObjectiveType kType = ObjectiveType::SDST_MAKESPAN;
+
+    static int evaluate(const ProblemInstance& instance, const int* sequence, int count);
+    static void buildCompletionTimes(const ProblemInstance& instance, const int* sequence, int first, int count,
+                                     int* completion_times);
+    static int resume(const ProblemInstance& instance, const int* sequence, int first, int count,
+                      const int* completion_times, int bound);
+    static int insertionSweep(const ProblemInstance& instance, const int* sequence, int count, int job,
+                              int* values, std::vector<int>& heads, std::vector<int>& tails);
+};
+
+/**
+ * @brief No-wait makespan: the operations of a job follow without waiting
+ *
+ * The start of a job after another depends on the two jobs only, so with
+ * the delays precomputed by the instance the makespan is the sum of the
+ * delays along the sequence plus the work of the last job: O(n) to
+ * evaluate and O(1) per insertion position.
+ */
+struct NoWaitMakespanObjective {
+    static constexpr ObjectiveType kType = ObjectiveType::NO_WAIT_MAKESPAN;
+
+    static int evaluate(const ProblemInstance& instance, const int* sequence, int count);
+    static void buildCompletionTimes(const ProblemInstance& instance, const int* sequence, int first, int count,
+                                     int* completion_times);
+    static int resume(const ProblemInstance& instance, const int* sequence, int first, int count,
+                      const int* completion_times, int bound);
+    static int insertionSweep(const ProblemInstance& instance, const int* sequence, int count, int job,
+                              int* values, std::vector<int>& heads, std::vector<int>& tails);
+};
+
+/**
+ * @brief Call a visitor with the policy of an objective
+ * @param objective Objective type
+ * @param visitor Callable taking any of the policy structs
+ * @return Result of the visitor
+ */
+template<typename Visitor>
+decltype(auto) visitObjective(ObjectiveType objective, Visitor&& visitor) {
+    switch (objective) {
+        case ObjectiveType::TOTAL_FLOWTIME:   return visitor(TotalFlowtimeObjective{});
+        case ObjectiveType::SDST_MAKESPAN:    return visitor(SdstMakespanObjective{});
+        case ObjectiveType::NO_WAIT_MAKESPAN: return visitor(NoWaitMakespanObjective{});
+        default:                              return visitor(MakespanObjective{});
+    }
+}
+
+/**
+ * @brief Value of a sequence under the objective of its instance
+ * @param instance Problem instance
+ * @param sequence Job indices
+ * @param count Number of jobs in the sequence
+ * @return Objective value
+ */
+inline int evaluateObjective(const ProblemInstance& instance, const int* sequence, int count) {
+    return visitObjective(instance.getObjective(), [&](auto objective) {
+        return decltype(objective)::evaluate(instance, sequence, count);
+    });
+}
+
+/**
+ * @brief Command-line name of an objective
+ * @param objective Objective type
+ * @return "makespan", "flowtime", "sdst" or "nowait"
+ */
+const char* objectiveName(ObjectiveType objective);
+
+/**
+ * @brief Parse a command-line objective name
+ * @param name Name returned by objectiveName
+ * @param objective Output: objective type
+ * @return True if the name is known
+ */
+bool parseObjective(const std::string& name, ObjectiveType& objective);
+
+#endif // OBJECTIVE_H
@@ -1,28 +1,225 @@
 #include "ProblemInstance.h"
+#include "Objective.h"
 #include "../utils/Random.h"
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#define HHOA_HAVE_MMAP 1
+#endif
+
+namespace {
+// Binary instance file: this header, the name, then the job-major and the
+// machine-major matrices and the optional setup matrix, each starting on a
+// 64-byte boundary of the file. Values are stored in the byte order of the
+// writing machine. Version 1 headers end before the objective.
+struct BinaryHeader {
+    char magic[8];               // kBinaryMagic
+    std::uint32_t version;       // kBinaryVersion
+    std::uint32_t name_length;   // Bytes of the name following the header
+    std::int32_t num_jobs;
+    std::int32_t num_machines;
+    std::int32_t lower_bound;    // Best-known lower bound (-1: unknown)
+    std::int32_t upper_bound;    // Best-known makespan (-1: unknown)
+    std::uint64_t checksum;      // checksumOf the job-major, then the machine-major matrix
+    std::uint64_t data_offset;   // Offset of the job-major matrix
+    std::int32_t objective;      // ObjectiveType
+    std::uint32_t reserved;
+    std::uint64_t setup_offset;  // Offset of the setup matrix (0: no setup times)
+};
+
+const char kBinaryMagic[8] = {'H', 'H', 'O', 'A', 'F', 'S', 'P', '\0'};
+constexpr std::uint32_t kBinaryVersion = 2;
+constexpr size_t kBinaryHeaderV1Size = offsetof(BinaryHeader, objective);
+constexpr std::uint64_t kBinaryAlignment = 64;
+
+std::uint64_t alignUp(std::uint64_t offset) {
+    return (offset + kBinaryAlignment - 1) / kBinaryAlignment * kBinaryAlignment;
+}
+
+// FNV-1a over 32-bit values, continuing from hash
+std::uint64_t checksumOf(const int* values, size_t count, std::uint64_t hash = 0xcbf29ce484222325ULL) {
+    for (size_t i = 0; i < count; ++i) {
+        hash ^= static_cast<std::uint32_t>(values[i]);
+        hash *= 0x100000001b3ULL;
+    }
+    return hash;
+}
+
+// Values of a setup matrix: (n + 1) predecessors (the last one initial) x n successors x m machines
+size_t setupCount(int num_jobs, int num_machines) {
+    return static_cast<size_t>(num_jobs + 1) * num_jobs * num_machines;
+}
+
+// Read-only view of a whole file; memory-mapped where available
+std::shared_ptr<const void> mapFile(const std::string& filename, size_t& size) {
+#ifdef HHOA_HAVE_MMAP
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+    struct stat status;
+    if (::fstat(fd, &status) != 0 || status.st_size <= 0) {
+        ::close(fd);
+        return nullptr;
+    }
+    size = status.st_size;
+    void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        return nullptr;
+    }
+    return std::shared_ptr<const void>(data, [size](const void* address) {
+        ::munmap(const_cast<void*>(address), size);
+    });
+#else
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file.is_open() || file.tellg() <= 0) {
+        return nullptr;
+    }
+    size = file.tellg();
+    auto buffer = std::make_shared<std::vector<char, AlignedAllocator<char, 64>>>(size);
+    file.seekg(0);
+    if (!file.read(buffer->data(), size)) {
+        return nullptr;
+    }
+    return std::shared_ptr<const void>(buffer, buffer->data());
+#endif
+}
+}
 
 ProblemInstance::ProblemInstance(int num_jobs, int num_machines, const std::string& instance_name)
-    : num_jobs_(num_jobs), num_machines_(num_machines), instance_name_(instance_name) {
-    processing_times_.resize(num_jobs_, std::vector<int>(num_machines_, 0));
+    : num_jobs_(num_jobs), num_machines_(num_machines), job_major_(nullptr), machine_major_(nullptr),
+      instance_name_(instance_name), known_lower_bound_(-1), known_upper_bound_(-1), lower_bound_(-1),
+      objective_(ObjectiveType::MAKESPAN), setup_times_(nullptr) {
+    if (num_jobs_ > 0 && num_machines_ > 0) {
+        job_major_times_.assign(static_cast<size_t>(num_jobs_) * num_machines_, 0);
+        machine_major_times_.assign(static_cast<size_t>(num_jobs_) * num_machines_, 0);
+    }
+    bindStorage();
 }
 
 ProblemInstance::ProblemInstance(const std::vector<std::vector<int>>& processing_times, 
                                const std::string& instance_name)
-    : processing_times_(processing_times), instance_name_(instance_name) {
+    : job_major_(nullptr), machine_major_(nullptr), instance_name_(instance_name),
+      known_lower_bound_(-1), known_upper_bound_(-1), lower_bound_(-1),
+      objective_(ObjectiveType::MAKESPAN), setup_times_(nullptr) {
     num_jobs_ = processing_times.size();
     num_machines_ = processing_times.empty() ? 0 : processing_times[0].size();
+    
+    for (const auto& job_times : processing_times) {
+        if (job_times.size() != static_cast<size_t>(num_machines_)) {
+            throw std::invalid_argument("All jobs must have one processing time per machine");
+        }
+    }
+    
+    job_major_times_.resize(static_cast<size_t>(num_jobs_) * num_machines_);
+    machine_major_times_.resize(static_cast<size_t>(num_jobs_) * num_machines_);
+    
+    for (int job = 0; job < num_jobs_; ++job) {
+        for (int machine = 0; machine < num_machines_; ++machine) {
+            job_major_times_[job * num_machines_ + machine] = processing_times[job][machine];
+            machine_major_times_[machine * num_jobs_ + job] = processing_times[job][machine];
+        }
+    }
+    bindStorage();
+    lower_bound_.store(computeLowerBound(), std::memory_order_relaxed);
+}
+
+ProblemInstance::ProblemInstance(const ProblemInstance& other)
+    : num_jobs_(other.num_jobs_), num_machines_(other.num_machines_),
+      job_major_times_(other.job_major_times_), machine_major_times_(other.machine_major_times_),
+      job_major_(other.job_major_), machine_major_(other.machine_major_), mapping_(other.mapping_),
+      instance_name_(other.instance_name_), known_lower_bound_(other.known_lower_bound_),
+      known_upper_bound_(other.known_upper_bound_),
+      lower_bound_(other.lower_bound_.load(std::memory_order_relaxed)), objective_(other.objective_),
+      setup_times_storage_(other.setup_times_storage_), setup_times_(other.setup_times_),
+      no_wait_delays_(other.no_wait_delays_) {
+    bindStorage();
+}
+
+ProblemInstance& ProblemInstance::operator=(const ProblemInstance& other) {
+    if (this != &other) {
+        num_jobs_ = other.num_jobs_;
+        num_machines_ = other.num_machines_;
+        job_major_times_ = other.job_major_times_;
+        machine_major_times_ = other.machine_major_times_;
+        job_major_ = other.job_major_;
+        machine_major_ = other.machine_major_;
+        mapping_ = other.mapping_;
+        instance_name_ = other.instance_name_;
+        known_lower_bound_ = other.known_lower_bound_;
+        known_upper_bound_ = other.known_upper_bound_;
+        lower_bound_.store(other.lower_bound_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        objective_ = other.objective_;
+        setup_times_storage_ = other.setup_times_storage_;
+        setup_times_ = other.setup_times_;
+        no_wait_delays_ = other.no_wait_delays_;
+        bindStorage();
+    }
+    return *this;
 }
 
 int ProblemInstance::getProcessingTime(int job, int machine) const {
     if (job < 0 || job >= num_jobs_ || machine < 0 || machine >= num_machines_) {
         throw std::out_of_range("Invalid job or machine index");
     }
-    return processing_times_[job][machine];
+    return job_major_[job * num_machines_ + machine];
+}
+
+std::vector<std::vector<int>> ProblemInstance::getProcessingTimes() const {
+    std::vector<std::vector<int>> processing_times(num_jobs_, std::vector<int>(num_machines_));
+    
+    for (int job = 0; job < num_jobs_; ++job) {
+        const int* times = getJobTimes(job);
+        std::copy(times, times + num_machines_, processing_times[job].begin());
+    }
+    
+    return processing_times;
+}
+
+int ProblemInstance::getSetupTime(int machine, int previous_job, int next_job) const {
+    if (machine < 0 || machine >= num_machines_ || previous_job < -1 || previous_job >= num_jobs_ ||
+        next_job < 0 || next_job >= num_jobs_) {
+        throw std::out_of_range("Invalid machine or job index");
+    }
+    return setup_times_ ? getSetupTimes(previous_job, next_job)[machine] : 0;
+}
+
+std::uint64_t ProblemInstance::getChecksum() const {
+    std::uint64_t hash = checksumOf(job_major_, static_cast<size_t>(num_jobs_) * num_machines_);
+    if (setup_times_) {
+        hash = checksumOf(setup_times_, setupCount(num_jobs_, num_machines_), hash);
+    }
+    if (objective_ != ObjectiveType::MAKESPAN) {
+        int objective = static_cast<int>(objective_);
+        hash = checksumOf(&objective, 1, hash);
+    }
+    return hash;
+}
+
+bool ProblemInstance::hasSameData(const ProblemInstance& other) const {
+    if (num_jobs_ != other.num_jobs_ || num_machines_ != other.num_machines_ || objective_ != other.objective_ ||
+        hasSetupTimes() != other.hasSetupTimes()) {
+        return false;
+    }
+    if (std::memcmp(job_major_, other.job_major_, sizeof(int) * num_jobs_ * num_machines_) != 0) {
+        return false;
+    }
+    return !setup_times_ ||
+           std::memcmp(setup_times_, other.setup_times_, sizeof(int) * setupCount(num_jobs_, num_machines_)) == 0;
 }
 
 void ProblemInstance::setProcessingTime(int job, int machine, int time) {
@@ -32,20 +229,108 @@ void ProblemInstance::setProcessingTime(int job, int machine, int time) {
     if (time < 0) {
         throw std::invalid_argument("Processing time cannot be negative");
     }
-    processing_times_[job][machine] = time;
+    if (objective_ == ObjectiveType::TOTAL_FLOWTIME) {
+        checkFlowtimeRange(checkedTotalWork() - job_major_[job * num_machines_ + machine] + time);
+    }
+    detachMapping();
+    job_major_times_[job * num_machines_ + machine] = time;
+    machine_major_times_[machine * num_jobs_ + job] = time;
+    lower_bound_.store(-1, std::memory_order_relaxed);
+    if (objective_ == ObjectiveType::NO_WAIT_MAKESPAN) {
+        updateNoWaitDelays(job);
+    }
+}
+
+void ProblemInstance::setObjective(ObjectiveType objective) {
+    if (objective == ObjectiveType::SDST_MAKESPAN && !setup_times_) {
+        throw std::invalid_argument("Sequence-dependent setup objective needs setup times");
+    }
+    if (objective == ObjectiveType::TOTAL_FLOWTIME) {
+        checkFlowtimeRange(checkedTotalWork());
+    }
+    objective_ = objective;
+    if (objective_ == ObjectiveType::NO_WAIT_MAKESPAN) {
+        computeNoWaitDelays();
+    } else {
+        no_wait_delays_.clear();
+        no_wait_delays_.shrink_to_fit();
+    }
+}
+
+void ProblemInstance::setSetupTime(int machine, int previous_job, int next_job, int time) {
+    if (machine < 0 || machine >= num_machines_ || previous_job < -1 || previous_job >= num_jobs_ ||
+        next_job < 0 || next_job >= num_jobs_) {
+        throw std::out_of_range("Invalid machine or job index");
+    }
+    if (time < 0) {
+        throw std::invalid_argument("Setup time cannot be negative");
+    }
+    detachMapping();
+    if (setup_times_storage_.empty()) {
+        setup_times_storage_.assign(setupCount(num_jobs_, num_machines_), 0);
+        bindStorage();
+    }
+    setup_times_storage_[(static_cast<size_t>(previous_job < 0 ? num_jobs_ : previous_job) * num_jobs_ + next_job)
+                         * num_machines_ + machine] = time;
+}
+
+void ProblemInstance::generateRandomSetupTimes(int min_time, int max_time) {
+    if (min_time < 0 || max_time < min_time) {
+        throw std::invalid_argument("Invalid parameters for random setup time generation");
+    }
+    detachMapping();
+    setup_times_storage_.resize(setupCount(num_jobs_, num_machines_));
+    for (int& time : setup_times_storage_) {
+        time = Random::getInstance().randInt(min_time, max_time);
+    }
+    bindStorage();
+}
+
+int ProblemInstance::getLowerBound() const {
+    // Racing first calls compute the same value
+    int lower_bound = lower_bound_.load(std::memory_order_relaxed);
+    if (lower_bound < 0) {
+        lower_bound = computeLowerBound();
+        lower_bound_.store(lower_bound, std::memory_order_relaxed);
+    }
+    return std::max(lower_bound, known_lower_bound_);
+}
+
+void ProblemInstance::setKnownBounds(int lower_bound, int upper_bound) {
+    if (lower_bound >= 0 && upper_bound >= 0 && lower_bound > upper_bound) {
+        throw std::invalid_argument("Lower bound exceeds upper bound");
+    }
+    known_lower_bound_ = lower_bound < 0 ? -1 : lower_bound;
+    known_upper_bound_ = upper_bound < 0 ? -1 : upper_bound;
 }
 
 std::shared_ptr<ProblemInstance> ProblemInstance::loadFromFile(const std::string& filename) {
+    if (isBinaryFile(filename)) {
+        return loadBinary(filename);
+    }
+    
     std::ifstream file(filename);
     if (!file.is_open()) {
         std::cerr << "Error: Cannot open file " << filename << std::endl;
         return nullptr;
     }
 
-    int num_jobs, num_machines;
-    file >> num_jobs >> num_machines;
+    // Parse the whole file from memory, filling the matrices directly
+    std::string content((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    const char* cursor = content.c_str();
+    auto next_value = [&cursor](long& value) {
+        char* end = nullptr;
+        errno = 0;
+        value = std::strtol(cursor, &end, 10);
+        bool parsed = end != cursor && errno == 0;
+        cursor = end;
+        return parsed;
+    };
 
-    if (num_jobs <= 0 || num_machines <= 0) {
+    long num_jobs = 0, num_machines = 0;
+    // Cells are indexed by int, so the matrix size must fit one
+    if (!next_value(num_jobs) || !next_value(num_machines) || num_jobs <= 0 || num_machines <= 0 ||
+        num_jobs > INT_MAX / num_machines) {
         std::cerr << "Error: Invalid problem dimensions" << std::endl;
         return nullptr;
     }
@@ -54,17 +339,120 @@ std::shared_ptr<ProblemInstance> ProblemInstance::loadFromFile(const std::string
 
     for (int job = 0; job < num_jobs; ++job) {
         for (int machine = 0; machine < num_machines; ++machine) {
-            int time;
-            file >> time;
-            instance->setProcessingTime(job, machine, time);
+            long time = 0;
+            if (!next_value(time) || time < 0 || time > INT_MAX) {
+                std::cerr << "Error: Invalid processing time for job " << job << ", machine " << machine
+                          << " in " << filename << std::endl;
+                return nullptr;
+            }
+            instance->job_major_times_[job * num_machines + machine] = time;
+            instance->machine_major_times_[machine * num_jobs + job] = time;
         }
     }
+    instance->lower_bound_.store(instance->computeLowerBound(), std::memory_order_relaxed);
+
+    return instance;
+}
+
+std::shared_ptr<ProblemInstance> ProblemInstance::loadBinary(const std::string& filename) {
+    size_t size = 0;
+    std::shared_ptr<const void> mapping = mapFile(filename, size);
+    if (!mapping) {
+        std::cerr << "Error: Cannot open file " << filename << std::endl;
+        return nullptr;
+    }
+
+    const char* bytes = static_cast<const char*>(mapping.get());
+    BinaryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    if (size < kBinaryHeaderV1Size) {
+        std::cerr << "Error: Truncated binary instance " << filename << std::endl;
+        return nullptr;
+    }
+    std::memcpy(&header, bytes, kBinaryHeaderV1Size);
+
+    if (std::memcmp(header.magic, kBinaryMagic, sizeof(kBinaryMagic)) != 0 ||
+        header.version < 1 || header.version > kBinaryVersion) {
+        std::cerr << "Error: Unsupported binary instance format in " << filename << std::endl;
+        return nullptr;
+    }
+    size_t header_size = header.version == 1 ? kBinaryHeaderV1Size : sizeof(header);
+    if (size < header_size) {
+        std::cerr << "Error: Truncated binary instance " << filename << std::endl;
+        return nullptr;
+    }
+    std::memcpy(&header, bytes, header_size);
+    if (header.objective < static_cast<int>(ObjectiveType::MAKESPAN) ||
+        header.objective > static_cast<int>(ObjectiveType::NO_WAIT_MAKESPAN)) {
+        std::cerr << "Error: Unknown objective in binary instance " << filename << std::endl;
+        return nullptr;
+    }
+    if (header.num_jobs <= 0 || header.num_machines <= 0) {
+        std::cerr << "Error: Invalid problem dimensions" << std::endl;
+        return nullptr;
+    }
+
+    std::uint64_t matrix_bytes = static_cast<std::uint64_t>(header.num_jobs) * header.num_machines * sizeof(int);
+    std::uint64_t machine_major_offset = header.data_offset + alignUp(matrix_bytes);
+    std::uint64_t setup_bytes = header.setup_offset != 0 ? setupCount(header.num_jobs, header.num_machines) * sizeof(int) : 0;
+    if (header_size + static_cast<std::uint64_t>(header.name_length) > header.data_offset ||
+        header.data_offset % kBinaryAlignment != 0 || machine_major_offset + matrix_bytes > size ||
+        header.setup_offset % kBinaryAlignment != 0 ||
+        (setup_bytes > 0 && (header.setup_offset < machine_major_offset + matrix_bytes ||
+                             header.setup_offset + setup_bytes > size))) {
+        std::cerr << "Error: Truncated binary instance " << filename << std::endl;
+        return nullptr;
+    }
+
+    const int* job_major = reinterpret_cast<const int*>(bytes + header.data_offset);
+    const int* machine_major = reinterpret_cast<const int*>(bytes + machine_major_offset);
+    const int* setup_times = setup_bytes > 0 ? reinterpret_cast<const int*>(bytes + header.setup_offset) : nullptr;
+    size_t count = static_cast<size_t>(header.num_jobs) * header.num_machines;
+    std::uint64_t checksum = checksumOf(machine_major, count, checksumOf(job_major, count));
+    if (setup_times) {
+        checksum = checksumOf(setup_times, setup_bytes / sizeof(int), checksum);
+    }
+    if (checksum != header.checksum) {
+        std::cerr << "Error: Checksum mismatch in binary instance " << filename << std::endl;
+        return nullptr;
+    }
+
+    std::string name(bytes + header_size, header.name_length);
+    auto instance = std::make_shared<ProblemInstance>(0, 0, name.empty() ? filename : name);
+    instance->num_jobs_ = header.num_jobs;
+    instance->num_machines_ = header.num_machines;
+    instance->job_major_ = job_major;
+    instance->machine_major_ = machine_major;
+    instance->setup_times_ = setup_times;
+    instance->mapping_ = mapping;
+    instance->setKnownBounds(header.lower_bound, header.upper_bound);
+    instance->lower_bound_.store(instance->computeLowerBound(), std::memory_order_relaxed);
+    try {
+        instance->setObjective(static_cast<ObjectiveType>(header.objective));
+    } catch (const std::invalid_argument& e) {
+        std::cerr << "Error: " << e.what() << " in " << filename << std::endl;
+        return nullptr;
+    }
 
-    file.close();
     return instance;
 }
 
-bool ProblemInstance::saveToFile(const std::string& filename) const {
+bool ProblemInstance::isBinaryFile(const std::string& filename) {
+    std::ifstream file(filename, std::ios::binary);
+    char magic[sizeof(kBinaryMagic)];
+    return file.read(magic, sizeof(magic)) && std::memcmp(magic, kBinaryMagic, sizeof(magic)) == 0;
+}
+
+bool ProblemInstance::convertToBinary(const std::string& input_file, const std::string& output_file) {
+    std::shared_ptr<ProblemInstance> instance = loadFromFile(input_file);
+    return instance && instance->saveToFile(output_file, InstanceFormat::BINARY);
+}
+
+bool ProblemInstance::saveToFile(const std::string& filename, InstanceFormat format) const {
+    if (format == InstanceFormat::BINARY) {
+        return saveBinary(filename);
+    }
+    
     std::ofstream file(filename);
     if (!file.is_open()) {
         std::cerr << "Error: Cannot create file " << filename << std::endl;
@@ -75,7 +463,7 @@ bool ProblemInstance::saveToFile(const std::string& filename) const {
     
     for (int job = 0; job < num_jobs_; ++job) {
         for (int machine = 0; machine < num_machines_; ++machine) {
-            file << processing_times_[job][machine];
+            file << processingTime(job, machine);
             if (machine < num_machines_ - 1) file << " ";
         }
         file << std::endl;
@@ -85,6 +473,49 @@ bool ProblemInstance::saveToFile(const std::string& filename) const {
     return true;
 }
 
+bool ProblemInstance::saveBinary(const std::string& filename) const {
+    std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Error: Cannot create file " << filename << std::endl;
+        return false;
+    }
+
+    BinaryHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, kBinaryMagic, sizeof(kBinaryMagic));
+    header.version = kBinaryVersion;
+    header.name_length = instance_name_.size();
+    header.num_jobs = num_jobs_;
+    header.num_machines = num_machines_;
+    header.lower_bound = known_lower_bound_;
+    header.upper_bound = known_upper_bound_;
+    size_t count = static_cast<size_t>(num_jobs_) * num_machines_;
+    header.checksum = checksumOf(machine_major_, count, checksumOf(job_major_, count));
+    header.data_offset = alignUp(sizeof(header) + instance_name_.size());
+    header.objective = static_cast<int>(objective_);
+
+    std::uint64_t matrix_bytes = static_cast<std::uint64_t>(num_jobs_) * num_machines_ * sizeof(int);
+    std::uint64_t setup_bytes = setup_times_ ? setupCount(num_jobs_, num_machines_) * sizeof(int) : 0;
+    if (setup_times_) {
+        header.checksum = checksumOf(setup_times_, setupCount(num_jobs_, num_machines_), header.checksum);
+        header.setup_offset = header.data_offset + 2 * alignUp(matrix_bytes);
+    }
+    const std::vector<char> padding(kBinaryAlignment, 0);
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(instance_name_.data(), instance_name_.size());
+    file.write(padding.data(), header.data_offset - sizeof(header) - instance_name_.size());
+    file.write(reinterpret_cast<const char*>(job_major_), matrix_bytes);
+    file.write(padding.data(), alignUp(matrix_bytes) - matrix_bytes);
+    file.write(reinterpret_cast<const char*>(machine_major_), matrix_bytes);
+    if (setup_times_) {
+        file.write(padding.data(), alignUp(matrix_bytes) - matrix_bytes);
+        file.write(reinterpret_cast<const char*>(setup_times_), setup_bytes);
+    }
+
+    return static_cast<bool>(file);
+}
+
 std::shared_ptr<ProblemInstance> ProblemInstance::generateRandom(int num_jobs, int num_machines, 
                                                                int min_time, int max_time) {
     if (num_jobs <= 0 || num_machines <= 0 || min_time < 0 || max_time < min_time) {
@@ -100,6 +531,7 @@ std::shared_ptr<ProblemInstance> ProblemInstance::generateRandom(int num_jobs, i
             instance->setProcessingTime(job, machine, time);
         }
     }
+    instance->lower_bound_.store(instance->computeLowerBound(), std::memory_order_relaxed);
 
     return instance;
 }
@@ -107,6 +539,8 @@ std::shared_ptr<ProblemInstance> ProblemInstance::generateRandom(int num_jobs, i
 void ProblemInstance::print() const {
     std::cout << "Problem Instance: " << instance_name_ << std::endl;
     std::cout << "Jobs: " << num_jobs_ << ", Machines: " << num_machines_ << std::endl;
+    std::cout << "Objective: " << objectiveName(objective_) << (setup_times_ ? " (with setup times)" : "") << std::endl;
+    std::cout << "Lower Bound: " << getLowerBound() << std::endl;
     std::cout << "Processing Times:" << std::endl;
     
     // Print header
@@ -120,31 +554,160 @@ void ProblemInstance::print() const {
     for (int job = 0; job < num_jobs_; ++job) {
         std::cout << std::setw(6) << "J" + std::to_string(job + 1);
         for (int machine = 0; machine < num_machines_; ++machine) {
-            std::cout << std::setw(6) << processing_times_[job][machine];
+            std::cout << std::setw(6) << processingTime(job, machine);
         }
         std::cout << std::endl;
     }
 }
 
 bool ProblemInstance::isValid() const {
-    if (num_jobs_ <= 0 || num_machines_ <= 0) {
+    if (num_jobs_ <= 0 || num_machines_ <= 0 || !job_major_ || !machine_major_) {
         return false;
     }
     
-    if (processing_times_.size() != static_cast<size_t>(num_jobs_)) {
+    size_t expected_size = static_cast<size_t>(num_jobs_) * num_machines_;
+    if (!mapping_ && (job_major_times_.size() != expected_size || machine_major_times_.size() != expected_size)) {
+        return false;
+    }
+    if (objective_ == ObjectiveType::SDST_MAKESPAN && !setup_times_) {
         return false;
     }
     
-    for (const auto& job_times : processing_times_) {
-        if (job_times.size() != static_cast<size_t>(num_machines_)) {
+    for (size_t i = 0; i < expected_size; ++i) {
+        if (job_major_[i] < 0) {
             return false;
         }
-        for (int time : job_times) {
-            if (time < 0) {
-                return false;
+    }
+    
+    return true;
+}
+
+int ProblemInstance::computeLowerBound() const {
+    if (num_jobs_ <= 0 || num_machines_ <= 0 || !job_major_) {
+        return 0;
+    }
+    
+    long long bound = 0;
+    
+    // Machine-based: min head + load + min tail, heads and tails grown machine by machine
+    std::vector<long long> heads(num_jobs_, 0);
+    std::vector<long long> tails(num_jobs_, 0);
+    for (int job = 0; job < num_jobs_; ++job) {
+        const int* times = getJobTimes(job);
+        for (int machine = 1; machine < num_machines_; ++machine) {
+            tails[job] += times[machine];
+        }
+    }
+    for (int machine = 0; machine < num_machines_; ++machine) {
+        const int* times = getMachineTimes(machine);
+        long long load = 0;
+        long long min_head = heads[0];
+        long long min_tail = tails[0];
+        for (int job = 0; job < num_jobs_; ++job) {
+            load += times[job];
+            min_head = std::min(min_head, heads[job]);
+            min_tail = std::min(min_tail, tails[job]);
+        }
+        bound = std::max(bound, min_head + load + min_tail);
+        
+        if (machine + 1 < num_machines_) {
+            const int* next = getMachineTimes(machine + 1);
+            for (int job = 0; job < num_jobs_; ++job) {
+                heads[job] += times[job];
+                tails[job] -= next[job];
             }
         }
     }
     
-    return true;
+    // Job-based: own total plus min(first, last machine) of every other job
+    long long min_ends = 0;
+    std::vector<long long> ends(num_jobs_);
+    for (int job = 0; job < num_jobs_; ++job) {
+        const int* times = getJobTimes(job);
+        ends[job] = std::min(times[0], times[num_machines_ - 1]);
+        min_ends += ends[job];
+    }
+    for (int job = 0; job < num_jobs_; ++job) {
+        const int* times = getJobTimes(job);
+        long long total = 0;
+        for (int machine = 0; machine < num_machines_; ++machine) {
+            total += times[machine];
+        }
+        bound = std::max(bound, total + min_ends - ends[job]);
+    }
+    
+    return static_cast<int>(bound);
+}
+
+long long ProblemInstance::checkedTotalWork() const {
+    long long total = 0;
+    for (size_t i = 0; i < static_cast<size_t>(num_jobs_) * num_machines_; ++i) {
+        total += job_major_[i];
+        if (total > INT_MAX) {
+            return static_cast<long long>(INT_MAX) + 1;
+        }
+    }
+    return total;
+}
+
+void ProblemInstance::checkFlowtimeRange(long long total_work) const {
+    // Every completion time is at most the total work, so n times it bounds any flowtime
+    if (total_work > INT_MAX / std::max(num_jobs_, 1)) {
+        throw std::invalid_argument("Total flowtime of the instance may exceed the int range");
+    }
+}
+
+void ProblemInstance::computeNoWaitDelays() {
+    no_wait_delays_.resize(static_cast<size_t>(num_jobs_) * num_jobs_);
+    for (int previous_job = 0; previous_job < num_jobs_; ++previous_job) {
+        for (int next_job = 0; next_job < num_jobs_; ++next_job) {
+            no_wait_delays_[previous_job * num_jobs_ + next_job] = computeNoWaitDelay(previous_job, next_job);
+        }
+    }
+}
+
+void ProblemInstance::updateNoWaitDelays(int job) {
+    for (int other = 0; other < num_jobs_; ++other) {
+        no_wait_delays_[job * num_jobs_ + other] = computeNoWaitDelay(job, other);
+        no_wait_delays_[other * num_jobs_ + job] = computeNoWaitDelay(other, job);
+    }
+}
+
+int ProblemInstance::computeNoWaitDelay(int previous_job, int next_job) const {
+    // Machine j must be free: start(next) + work of next before j >= start(previous) + work of previous up to j
+    const int* previous = getJobTimes(previous_job);
+    const int* next = getJobTimes(next_job);
+    int previous_work = 0;
+    int next_work = 0;
+    int delay = 0;
+    for (int machine = 0; machine < num_machines_; ++machine) {
+        previous_work += previous[machine];
+        delay = std::max(delay, previous_work - next_work);
+        next_work += next[machine];
+    }
+    return delay;
+}
+
+void ProblemInstance::bindStorage() {
+    if (mapping_) {
+        return;
+    }
+    job_major_ = job_major_times_.empty() ? nullptr : job_major_times_.data();
+    machine_major_ = machine_major_times_.empty() ? nullptr : machine_major_times_.data();
+    setup_times_ = setup_times_storage_.empty() ? nullptr : setup_times_storage_.data();
+}
+
+void ProblemInstance::detachMapping() {
+    if (!mapping_) {
+        return;
+    }
+    
+    size_t count = static_cast<size_t>(num_jobs_) * num_machines_;
+    job_major_times_.assign(job_major_, job_major_ + count);
+    machine_major_times_.assign(machine_major_, machine_major_ + count);
+    if (setup_times_) {
+        setup_times_storage_.assign(setup_times_, setup_times_ + setupCount(num_jobs_, num_machines_));
+    }
+    mapping_.reset();
+    bindStorage();
 }
@@ -4,19 +4,68 @@
 #include <vector>
 #include <string>
 #include <memory>
+#include <atomic>
+#include <cstdint>
+#include "../utils/AlignedAllocator.h"
+
+/**
+ * @brief Contiguous, cache-line aligned storage for processing time matrices
+ */
+using AlignedIntVector = std::vector<int, AlignedAllocator<int, 64>>;
+
+/**
+ * @brief On-disk formats of an instance
+ */
+enum class InstanceFormat {
+    TEXT = 0,    // "n m" followed by n rows of m processing times
+    BINARY = 1   // Header and aligned matrices, loaded zero-copy (see ProblemInstance::loadBinary)
+};
+
+/**
+ * @brief Objective a sequence of the instance is scored by (see Objective.h)
+ */
+enum class ObjectiveType {
+    MAKESPAN = 0,          // Completion time of the last job
+    TOTAL_FLOWTIME = 1,    // Sum of the completion times of all jobs on the last machine
+    SDST_MAKESPAN = 2,     // Makespan with sequence-dependent setup times (needs setup times)
+    NO_WAIT_MAKESPAN = 3   // Makespan when a job never waits between two machines
+};
 
 /**
  * @brief Represents a Flow Shop Scheduling Problem instance
  * 
  * This class encapsulates a FSSP instance with n jobs and m machines.
- * Each job has processing times for each machine.
+ * Each job has processing times for each machine. The times are stored in
+ * one flat job-major buffer (row per job) together with a transposed
+ * machine-major copy (row per machine), both aligned for vectorized kernels.
+ * An instance loaded from a binary file reads both matrices straight from
+ * the memory-mapped file; modifying it first copies them into owned storage.
+ * The classic machine-based and job-based lower bounds on the makespan are
+ * computed once, when the instance is loaded or generated.
+ *
+ * The instance also carries the objective its sequences are scored by, and
+ * optional sequence-dependent setup times: setup_times[(prev * n + next) * m
+ * + machine] is the setup of machine before next when it follows prev, and
+ * row prev = n holds the initial setups. Under the no-wait objective the
+ * n x n start delays between consecutive jobs are precomputed.
  */
 class ProblemInstance {
 private:
     int num_jobs_;           // Number of jobs (n)
     int num_machines_;       // Number of machines (m)
-    std::vector<std::vector<int>> processing_times_;  // processing_times_[job][machine]
+    AlignedIntVector job_major_times_;      // Owned job_major_times_[job * m + machine] (empty when mapped)
+    AlignedIntVector machine_major_times_;  // Owned machine_major_times_[machine * n + job] (empty when mapped)
+    const int* job_major_;                  // Job-major matrix in use (owned storage or mapped file)
+    const int* machine_major_;              // Machine-major matrix in use
+    std::shared_ptr<const void> mapping_;   // Keeps the mapped binary file alive (null: owned storage)
     std::string instance_name_;
+    int known_lower_bound_;                 // Best-known lower bound on the makespan (-1: unknown)
+    int known_upper_bound_;                 // Best-known makespan (-1: unknown)
+    mutable std::atomic<int> lower_bound_;  // Machine/job-based lower bound (-1: not computed yet)
+    ObjectiveType objective_;               // Objective sequences are scored by
+    AlignedIntVector setup_times_storage_;  // Owned setup times (empty when mapped or absent)
+    const int* setup_times_;                // Setup times in use (null: no setup times)
+    std::vector<int> no_wait_delays_;       // no_wait_delays_[a * n + b]: start of b after the start of a (no-wait only)
 
 public:
     /**
@@ -35,30 +84,214 @@ public:
     ProblemInstance(const std::vector<std::vector<int>>& processing_times, 
                    const std::string& instance_name = "");
 
+    /**
+     * @brief Copy constructor (a mapped instance shares the mapping)
+     * @param other Instance to copy
+     */
+    ProblemInstance(const ProblemInstance& other);
+
+    /**
+     * @brief Copy assignment
+     * @param other Instance to copy
+     * @return Reference to this instance
+     */
+    ProblemInstance& operator=(const ProblemInstance& other);
+
     // Getters
     int getNumJobs() const { return num_jobs_; }
     int getNumMachines() const { return num_machines_; }
     int getProcessingTime(int job, int machine) const;
-    const std::vector<std::vector<int>>& getProcessingTimes() const { return processing_times_; }
+    std::vector<std::vector<int>> getProcessingTimes() const;
+
+    /**
+     * @brief Unchecked access to a processing time (hot paths only)
+     * @param job Job index (must be valid)
+     * @param machine Machine index (must be valid)
+     * @return Processing time
+     */
+    int processingTime(int job, int machine) const { return job_major_[job * num_machines_ + machine]; }
+
+    /**
+     * @brief Unchecked pointer to the processing times of a job on all machines
+     * @param job Job index (must be valid)
+     * @return Pointer to num_machines contiguous values
+     */
+    const int* getJobTimes(int job) const { return job_major_ + job * num_machines_; }
+
+    /**
+     * @brief Unchecked pointer to the processing times of all jobs on a machine
+     * @param machine Machine index (must be valid)
+     * @return Pointer to num_jobs contiguous values
+     */
+    const int* getMachineTimes(int machine) const { return machine_major_ + machine * num_jobs_; }
+
+    /**
+     * @brief Flat job-major processing time matrix (64-byte aligned)
+     * @return Pointer to num_jobs * num_machines values
+     */
+    const int* getJobMajorTimes() const { return job_major_; }
+
+    /**
+     * @brief Flat machine-major (transposed) processing time matrix (64-byte aligned)
+     * @return Pointer to num_machines * num_jobs values
+     */
+    const int* getMachineMajorTimes() const { return machine_major_; }
+
+    /**
+     * @brief Unchecked pointer to the setup times between two jobs on all machines
+     * @param previous_job Job processed before (-1: initial setup)
+     * @param next_job Job the machines are set up for
+     * @return Pointer to num_machines contiguous values (requires hasSetupTimes())
+     */
+    const int* getSetupTimes(int previous_job, int next_job) const {
+        return setup_times_ + (static_cast<size_t>(previous_job < 0 ? num_jobs_ : previous_job) * num_jobs_ + next_job)
+                              * num_machines_;
+    }
+
+    /**
+     * @brief Unchecked no-wait start delay of a job right after another
+     * @param previous_job Job started first
+     * @param next_job Job started right after it
+     * @return Time between the two starts on the first machine (requires the no-wait objective)
+     */
+    int noWaitDelay(int previous_job, int next_job) const { return no_wait_delays_[previous_job * num_jobs_ + next_job]; }
+
     const std::string& getInstanceName() const { return instance_name_; }
+    int getKnownLowerBound() const { return known_lower_bound_; }
+    int getKnownUpperBound() const { return known_upper_bound_; }
+    bool isMapped() const { return mapping_ != nullptr; }
+    ObjectiveType getObjective() const { return objective_; }
+    bool hasSetupTimes() const { return setup_times_ != nullptr; }
+
+    /**
+     * @brief Checked access to a setup time
+     * @param machine Machine index
+     * @param previous_job Job processed before (-1: initial setup)
+     * @param next_job Job the machine is set up for
+     * @return Setup time (0 without setup times)
+     */
+    int getSetupTime(int machine, int previous_job, int next_job) const;
+
+    /**
+     * @brief Lower bound on the optimal makespan
+     *
+     * The larger of the computed bound (see computeLowerBound) and the
+     * best-known lower bound. A makespan equal to it is optimal. The
+     * computed part is cached; modifying the instance recomputes it on the
+     * next call. Setups, no-wait delays and the completion times of the
+     * other jobs only add to the makespan, so it bounds every objective.
+     *
+     * @return Lower bound (0 for an empty instance)
+     */
+    int getLowerBound() const;
+
+    /**
+     * @brief Checksum of the data (FNV-1a over the job-major values)
+     *
+     * The objective and the setup times are folded in when they differ from
+     * the plain makespan instance, whose checksum they leave unchanged.
+     *
+     * @return 64-bit checksum
+     */
+    std::uint64_t getChecksum() const;
+
+    /**
+     * @brief Whether another instance has the same times, setups and objective
+     * @param other Instance to compare
+     * @return True if every sequence scores the same on both
+     */
+    bool hasSameData(const ProblemInstance& other) const;
 
     // Setters
+    /**
+     * @brief Set one processing time
+     * @param job Job index
+     * @param machine Machine index
+     * @param time Processing time (under total flowtime, rejected if the flowtime could leave the int range)
+     */
     void setProcessingTime(int job, int machine, int time);
     void setInstanceName(const std::string& name) { instance_name_ = name; }
 
     /**
-     * @brief Load instance from file
+     * @brief Set the best-known bounds on the optimal makespan
+     * @param lower_bound Lower bound (-1: unknown)
+     * @param upper_bound Best-known makespan (-1: unknown)
+     */
+    void setKnownBounds(int lower_bound, int upper_bound);
+
+    /**
+     * @brief Select the objective sequences are scored by
+     *
+     * The no-wait objective precomputes the start delays in O(n^2 * m). Set
+     * it before solving: solutions and caches built earlier keep their values.
+     * Total flowtime is rejected unless n times the total work fits an int,
+     * so no sequence's flowtime can overflow.
+     *
+     * @param objective Objective (SDST_MAKESPAN requires setup times)
+     */
+    void setObjective(ObjectiveType objective);
+
+    /**
+     * @brief Set one setup time (the first call allocates a zero setup matrix)
+     * @param machine Machine index
+     * @param previous_job Job processed before (-1: initial setup)
+     * @param next_job Job the machine is set up for
+     * @param time Setup time
+     */
+    void setSetupTime(int machine, int previous_job, int next_job, int time);
+
+    /**
+     * @brief Draw every setup time uniformly (Ruiz's SDST benchmarks use [1, 9] to [1, 124])
+     * @param min_time Minimum setup time
+     * @param max_time Maximum setup time
+     */
+    void generateRandomSetupTimes(int min_time, int max_time);
+
+    /**
+     * @brief Load instance from file, in either format
+     *
+     * Binary files are recognized by their magic number and loaded with
+     * loadBinary; anything else is parsed as text.
+     *
      * @param filename Path to the instance file
-     * @return Shared pointer to the loaded instance
+     * @return Shared pointer to the loaded instance (null on error)
      */
     static std::shared_ptr<ProblemInstance> loadFromFile(const std::string& filename);
 
+    /**
+     * @brief Load a binary instance file without copying its matrices
+     *
+     * The file is memory-mapped read-only and the instance reads the
+     * processing and setup times in place; the header and the checksum are
+     * verified. Version 1 files (no objective, no setups) are still read.
+     *
+     * @param filename Path to the binary file
+     * @return Shared pointer to the loaded instance (null on error)
+     */
+    static std::shared_ptr<ProblemInstance> loadBinary(const std::string& filename);
+
+    /**
+     * @brief Check whether a file starts with the binary instance magic number
+     * @param filename Path to the file
+     * @return True for a binary instance file
+     */
+    static bool isBinaryFile(const std::string& filename);
+
+    /**
+     * @brief Convert an instance file to the binary format
+     * @param input_file Instance file (text or binary)
+     * @param output_file Binary file to write
+     * @return True if successful, false otherwise
+     */
+    static bool convertToBinary(const std::string& input_file, const std::string& output_file);
+
     /**
      * @brief Save instance to file
      * @param filename Path to save the instance
+     * @param format File format (the text format stores the processing times only)
      * @return True if successful, false otherwise
      */
-    bool saveToFile(const std::string& filename) const;
+    bool saveToFile(const std::string& filename, InstanceFormat format = InstanceFormat::TEXT) const;
 
     /**
      * @brief Generate random instance
@@ -81,6 +314,69 @@ public:
      * @return True if valid, false otherwise
      */
     bool isValid() const;
+
+private:
+    /**
+     * @brief Compute the classic flow shop lower bounds in O(nm)
+     *
+     * Machine-based: machine i cannot start before the smallest head (work
+     * on machines 0..i-1) of any job, is busy for its total load, and is
+     * followed by the smallest tail (work on machines i+1..m-1).
+     * Job-based: job j takes its total processing time, and every other
+     * job runs either before it on the first machine or after it on the
+     * last one.
+     *
+     * @return Maximum over all machine and job bounds
+     */
+    int computeLowerBound() const;
+
+    /**
+     * @brief Sum of all processing times, saturated just above INT_MAX
+     * @return Total work (INT_MAX + 1 if it exceeds the int range)
+     */
+    long long checkedTotalWork() const;
+
+    /**
+     * @brief Throw unless every flowtime with this total work fits an int
+     * @param total_work Total work (see checkedTotalWork)
+     */
+    void checkFlowtimeRange(long long total_work) const;
+
+    /**
+     * @brief Precompute the no-wait start delays in O(n^2 * m)
+     */
+    void computeNoWaitDelays();
+
+    /**
+     * @brief Recompute the no-wait delays from and to one job in O(n * m)
+     * @param job Job whose processing times changed
+     */
+    void updateNoWaitDelays(int job);
+
+    /**
+     * @brief No-wait start delay of next_job right after previous_job, from the times
+     * @param previous_job Job started first
+     * @param next_job Job started right after it
+     * @return Smallest start difference keeping every machine free
+     */
+    int computeNoWaitDelay(int previous_job, int next_job) const;
+
+    /**
+     * @brief Point the matrix pointers at the owned storage (no-op when mapped)
+     */
+    void bindStorage();
+
+    /**
+     * @brief Copy mapped matrices into owned storage before a modification
+     */
+    void detachMapping();
+
+    /**
+     * @brief Write the binary format
+     * @param filename Path to save the instance
+     * @return True if successful, false otherwise
+     */
+    bool saveBinary(const std::string& filename) const;
 };
 
 #endif // PROBLEM_INSTANCE_H
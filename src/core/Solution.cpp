@@ -1,13 +1,38 @@
 #include "Solution.h"
+#include "InsertionEvaluator.h"
+#include "MakespanKernels.h"
+#include "Objective.h"
 #include "../utils/Random.h"
+#include "../utils/Profiler.h"
 #include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <numeric>
 #include <climits>
 
+namespace {
+// Zobrist key of a job at a position (splitmix64 of the pair, no table needed)
+inline std::uint64_t zobristKey(int position, int job) {
+    std::uint64_t z = ((static_cast<std::uint64_t>(position) << 32) | static_cast<std::uint32_t>(job))
+                      + 0x9E3779B97F4A7C15ULL;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+// Per-thread insertion evaluator, rebuilt only when the instance changes
+InsertionEvaluator& threadEvaluator(const std::shared_ptr<ProblemInstance>& instance) {
+    static thread_local std::unique_ptr<InsertionEvaluator> evaluator;
+    if (!evaluator || evaluator->getInstance() != instance) {
+        evaluator = std::make_unique<InsertionEvaluator>(instance);
+    }
+    return *evaluator;
+}
+}
+
 Solution::Solution(std::shared_ptr<ProblemInstance> instance)
-    : instance_(instance), makespan_(-1), makespan_calculated_(false) {
+    : instance_(instance), makespan_(-1), makespan_calculated_(false), valid_rows_(0),
+      valid_tail_rows_(0), hash_(0), hash_valid_(false) {
     if (!instance_ || !instance_->isValid()) {
         throw std::invalid_argument("Invalid problem instance");
     }
@@ -18,7 +43,8 @@ Solution::Solution(std::shared_ptr<ProblemInstance> instance)
 }
 
 Solution::Solution(const std::vector<int>& job_sequence, std::shared_ptr<ProblemInstance> instance)
-    : job_sequence_(job_sequence), instance_(instance), makespan_(-1), makespan_calculated_(false) {
+    : job_sequence_(job_sequence), instance_(instance), makespan_(-1), makespan_calculated_(false),
+      valid_rows_(0), valid_tail_rows_(0), hash_(0), hash_valid_(false) {
     if (!instance_ || !instance_->isValid()) {
         throw std::invalid_argument("Invalid problem instance");
     }
@@ -31,15 +57,52 @@ Solution::Solution(const std::vector<int>& job_sequence, std::shared_ptr<Problem
 Solution::Solution(const Solution& other)
     : job_sequence_(other.job_sequence_), instance_(other.instance_),
       makespan_(other.makespan_), makespan_calculated_(other.makespan_calculated_),
-      completion_times_(other.completion_times_) {}
+      valid_rows_(0), valid_tail_rows_(0), hash_(other.hash_), hash_valid_(other.hash_valid_) {}
 
 Solution& Solution::operator=(const Solution& other) {
     if (this != &other) {
         job_sequence_ = other.job_sequence_;
-        instance_ = other.instance_;
+        if (instance_ != other.instance_) {
+            instance_ = other.instance_;  // Skip the atomic refcount update in the common case
+        }
         makespan_ = other.makespan_;
         makespan_calculated_ = other.makespan_calculated_;
-        completion_times_ = other.completion_times_;
+        valid_rows_ = 0;  // Keep our buffers for reuse, but not their contents
+        valid_tail_rows_ = 0;
+        hash_ = other.hash_;
+        hash_valid_ = other.hash_valid_;
+    }
+    return *this;
+}
+
+Solution::Solution(Solution&& other) noexcept
+    : job_sequence_(std::move(other.job_sequence_)), instance_(std::move(other.instance_)),
+      makespan_(other.makespan_), makespan_calculated_(other.makespan_calculated_),
+      completion_times_(std::move(other.completion_times_)), valid_rows_(other.valid_rows_),
+      tails_(std::move(other.tails_)), suffix_loads_(std::move(other.suffix_loads_)),
+      valid_tail_rows_(other.valid_tail_rows_), hash_(other.hash_), hash_valid_(other.hash_valid_) {
+    other.makespan_calculated_ = false;
+    other.valid_rows_ = 0;
+    other.valid_tail_rows_ = 0;
+}
+
+Solution& Solution::operator=(Solution&& other) noexcept {
+    if (this != &other) {
+        // Swap buffers so the moved-from solution keeps ours for reuse
+        job_sequence_.swap(other.job_sequence_);
+        instance_ = std::move(other.instance_);
+        makespan_ = other.makespan_;
+        makespan_calculated_ = other.makespan_calculated_;
+        completion_times_.swap(other.completion_times_);
+        valid_rows_ = other.valid_rows_;
+        tails_.swap(other.tails_);
+        suffix_loads_.swap(other.suffix_loads_);
+        valid_tail_rows_ = other.valid_tail_rows_;
+        hash_ = other.hash_;
+        hash_valid_ = other.hash_valid_;
+        other.makespan_calculated_ = false;
+        other.valid_rows_ = 0;
+        other.valid_tail_rows_ = 0;
     }
     return *this;
 }
@@ -55,16 +118,62 @@ void Solution::setJobSequence(const std::vector<int>& sequence) {
     if (sequence.size() != static_cast<size_t>(instance_->getNumJobs())) {
         throw std::invalid_argument("Job sequence size does not match problem instance");
     }
+    // Keep the completion times of the common prefix and the tails of the common suffix
+    auto mismatch = std::mismatch(job_sequence_.begin(), job_sequence_.end(), sequence.begin());
+    int first_changed = mismatch.first - job_sequence_.begin();
+    if (first_changed == static_cast<int>(job_sequence_.size())) {
+        return;
+    }
+    auto suffix = std::mismatch(job_sequence_.rbegin(), job_sequence_.rend(), sequence.rbegin());
+    int last_changed = job_sequence_.rend() - suffix.first - 1;
+    
     job_sequence_ = sequence;
-    invalidateCache();
+    hash_valid_ = false;
+    invalidateRange(first_changed, last_changed);
+}
+
+void Solution::moveJob(int from_pos, int to_pos) {
+    int size = job_sequence_.size();
+    if (from_pos < 0 || from_pos >= size || to_pos < 0 || to_pos >= size) {
+        throw std::out_of_range("Invalid position");
+    }
+    if (from_pos == to_pos) {
+        return;
+    }
+    
+    int first = std::min(from_pos, to_pos);
+    int last = std::max(from_pos, to_pos);
+    if (hash_valid_) {
+        for (int pos = first; pos <= last; ++pos) {
+            hash_ ^= zobristKey(pos, job_sequence_[pos]);
+        }
+    }
+    
+    // Shift the jobs in between by one instead of erasing and reinserting
+    auto begin = job_sequence_.begin();
+    if (from_pos < to_pos) {
+        std::rotate(begin + from_pos, begin + from_pos + 1, begin + to_pos + 1);
+    } else {
+        std::rotate(begin + to_pos, begin + from_pos, begin + from_pos + 1);
+    }
+    
+    if (hash_valid_) {
+        for (int pos = first; pos <= last; ++pos) {
+            hash_ ^= zobristKey(pos, job_sequence_[pos]);
+        }
+    }
+    invalidateRange(first, last);
 }
 
 void Solution::setJobAt(int position, int job) {
     if (position < 0 || position >= static_cast<int>(job_sequence_.size())) {
         throw std::out_of_range("Invalid position");
     }
+    if (hash_valid_) {
+        hash_ ^= zobristKey(position, job_sequence_[position]) ^ zobristKey(position, job);
+    }
     job_sequence_[position] = job;
-    invalidateCache();
+    invalidateRange(position, position);
 }
 
 void Solution::swapJobs(int pos1, int pos2) {
@@ -72,8 +181,33 @@ void Solution::swapJobs(int pos1, int pos2) {
         pos2 < 0 || pos2 >= static_cast<int>(job_sequence_.size())) {
         throw std::out_of_range("Invalid positions");
     }
+    if (pos1 == pos2) {
+        return;
+    }
+    if (hash_valid_) {
+        int job1 = job_sequence_[pos1];
+        int job2 = job_sequence_[pos2];
+        hash_ ^= zobristKey(pos1, job1) ^ zobristKey(pos2, job2) ^
+                 zobristKey(pos1, job2) ^ zobristKey(pos2, job1);
+    }
     std::swap(job_sequence_[pos1], job_sequence_[pos2]);
-    invalidateCache();
+    invalidateRange(std::min(pos1, pos2), std::max(pos1, pos2));
+}
+
+std::uint64_t Solution::getHash() const {
+    if (!hash_valid_) {
+        hash_ = 0;
+        for (int pos = 0; pos < static_cast<int>(job_sequence_.size()); ++pos) {
+            hash_ ^= zobristKey(pos, job_sequence_[pos]);
+        }
+        hash_valid_ = true;
+    }
+    return hash_;
+}
+
+void Solution::setKnownMakespan(int makespan) {
+    makespan_ = makespan;
+    makespan_calculated_ = true;
 }
 
 int Solution::getMakespan() const {
@@ -83,24 +217,60 @@ int Solution::getMakespan() const {
     return makespan_;
 }
 
-const std::vector<std::vector<int>>& Solution::getCompletionTimes() const {
-    if (!makespan_calculated_) {
-        calculateMakespan();
-    }
+const std::vector<int>& Solution::getCompletionTimes() const {
+    buildCompletionTimes();
     return completion_times_;
 }
 
 int Solution::getCompletionTime(int job_position, int machine) const {
-    if (!makespan_calculated_) {
-        calculateMakespan();
+    int num_machines = instance_->getNumMachines();
+    if (job_position < 0 || job_position >= static_cast<int>(job_sequence_.size()) ||
+        machine < 0 || machine >= num_machines) {
+        throw std::out_of_range("Invalid job position or machine index");
     }
     
-    if (job_position < 0 || job_position >= static_cast<int>(completion_times_.size()) ||
-        machine < 0 || machine >= static_cast<int>(completion_times_[0].size())) {
-        throw std::out_of_range("Invalid job position or machine index");
+    buildCompletionTimes();
+    return completion_times_[job_position * num_machines + machine];
+}
+
+int Solution::evaluateSwap(int pos1, int pos2, int bound) const {
+    int size = job_sequence_.size();
+    if (pos1 < 0 || pos1 >= size || pos2 < 0 || pos2 >= size) {
+        throw std::out_of_range("Invalid positions");
     }
+    if (pos1 == pos2) {
+        return getMakespan();
+    }
+    
+    int first = std::min(pos1, pos2);
+    int last = std::max(pos1, pos2);
+    static thread_local std::vector<int> window;
+    window.assign(job_sequence_.begin() + first, job_sequence_.begin() + last + 1);
+    std::swap(window.front(), window.back());
     
-    return completion_times_[job_position][machine];
+    return evaluateWindow(first, last, window.data(), bound);
+}
+
+int Solution::evaluateMove(int from_pos, int to_pos, int bound) const {
+    int size = job_sequence_.size();
+    if (from_pos < 0 || from_pos >= size || to_pos < 0 || to_pos >= size) {
+        throw std::out_of_range("Invalid position");
+    }
+    if (from_pos == to_pos) {
+        return getMakespan();
+    }
+    
+    int first = std::min(from_pos, to_pos);
+    int last = std::max(from_pos, to_pos);
+    static thread_local std::vector<int> window;
+    window.assign(job_sequence_.begin() + first, job_sequence_.begin() + last + 1);
+    if (from_pos < to_pos) {
+        std::rotate(window.begin(), window.begin() + 1, window.end());
+    } else {
+        std::rotate(window.begin(), window.end() - 1, window.end());
+    }
+    
+    return evaluateWindow(first, last, window.data(), bound);
 }
 
 void Solution::initializeRandom() {
@@ -131,6 +301,83 @@ void Solution::initializeGreedy() {
     invalidateCache();
 }
 
+void Solution::initializeNEH() {
+    int num_jobs = instance_->getNumJobs();
+    int num_machines = instance_->getNumMachines();
+    
+    // Longest total processing time first (stable: lower index first on ties)
+    std::vector<long long> totals(num_jobs, 0);
+    for (int job = 0; job < num_jobs; ++job) {
+        const int* times = instance_->getJobTimes(job);
+        totals[job] = std::accumulate(times, times + num_machines, 0LL);
+    }
+    
+    std::vector<int> order(num_jobs);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&totals](int a, int b) { return totals[a] > totals[b]; });
+    
+    constructByInsertion(order, false);
+}
+
+void Solution::initializeRandomizedNEH(double perturbation) {
+    if (perturbation < 0.0 || perturbation > 1.0) {
+        throw std::invalid_argument("Perturbation must be between 0.0 and 1.0");
+    }
+    
+    Random& rng = Random::getInstance();
+    int num_jobs = instance_->getNumJobs();
+    int num_machines = instance_->getNumMachines();
+    
+    std::vector<double> keys(num_jobs);
+    for (int job = 0; job < num_jobs; ++job) {
+        const int* times = instance_->getJobTimes(job);
+        double total = std::accumulate(times, times + num_machines, 0.0);
+        keys[job] = perturbation > 0.0 ? total * (1.0 + rng.randDouble(-perturbation, perturbation)) : total;
+    }
+    
+    std::vector<int> order(num_jobs);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&keys](int a, int b) { return keys[a] > keys[b]; });
+    
+    constructByInsertion(order, true);
+}
+
+void Solution::constructByInsertion(const std::vector<int>& order, bool random_ties) {
+    InsertionEvaluator& evaluator = threadEvaluator(instance_);
+    static thread_local std::vector<int> partial;
+    static thread_local std::vector<int> makespans;
+    Random& rng = Random::getInstance();
+    
+    partial.clear();
+    partial.reserve(order.size());
+    int makespan = 0;
+    
+    for (int job : order) {
+        int position = evaluator.evaluateInsertions(partial, job, makespans);
+        makespan = makespans[position];
+        
+        if (random_ties) {
+            // Uniform choice among the positions tied with the first best one
+            int ties = std::count(makespans.begin() + position, makespans.end(), makespan);
+            if (ties > 1) {
+                int pick = rng.randInt(0, ties - 1);
+                for (size_t k = position + 1; pick > 0; ++k) {
+                    if (makespans[k] == makespan) {
+                        position = k;
+                        pick--;
+                    }
+                }
+            }
+        }
+        
+        partial.insert(partial.begin() + position, job);
+    }
+    
+    job_sequence_.assign(partial.begin(), partial.end());
+    invalidateCache();
+    setKnownMakespan(makespan);
+}
+
 bool Solution::isValid() const {
     if (job_sequence_.size() != static_cast<size_t>(instance_->getNumJobs())) {
         return false;
@@ -147,22 +394,29 @@ bool Solution::isValid() const {
     return true;
 }
 
-bool Solution::apply2Opt() {
+bool Solution::apply2Opt(bool first_improvement) {
     bool improved = false;
+    
     int current_makespan = getMakespan();
     
     for (int i = 0; i < static_cast<int>(job_sequence_.size()) - 1; ++i) {
         for (int j = i + 1; j < static_cast<int>(job_sequence_.size()); ++j) {
-            // Try swapping jobs at positions i and j
-            swapJobs(i, j);
+            // The solution stays consistent between moves: stop as soon as the budget runs out
+            if (SearchBudget::isCurrentExhausted()) {
+                return improved;
+            }
             
-            int new_makespan = getMakespan();
+            // Score the swap of positions i and j without applying it
+            int new_makespan = evaluateSwap(i, j, current_makespan);
             if (new_makespan < current_makespan) {
+                swapJobs(i, j);
+                setKnownMakespan(new_makespan);
                 current_makespan = new_makespan;
                 improved = true;
-            } else {
-                // Revert the swap
-                swapJobs(i, j);
+                
+                if (first_improvement) {
+                    return true;
+                }
             }
         }
     }
@@ -170,28 +424,40 @@ bool Solution::apply2Opt() {
     return improved;
 }
 
-bool Solution::applyInsertionSearch() {
+bool Solution::applyInsertionSearch(bool first_improvement) {
     bool improved = false;
     int current_makespan = getMakespan();
+    int num_jobs = job_sequence_.size();
     
-    for (int i = 0; i < static_cast<int>(job_sequence_.size()); ++i) {
-        for (int j = 0; j < static_cast<int>(job_sequence_.size()); ++j) {
+    // Per-thread evaluator and buffer, reused across calls on the same instance
+    static thread_local std::vector<int> makespans;
+    InsertionEvaluator& evaluator = threadEvaluator(instance_);
+    
+    for (int i = 0; i < num_jobs; ++i) {
+        if (SearchBudget::isCurrentExhausted()) {
+            return improved;
+        }
+        
+        // Score every reinsertion position of the job at position i in one sweep
+        evaluator.evaluateReinsertions(job_sequence_, i, makespans);
+        
+        for (int j = 0; j < num_jobs; ++j) {
             if (i == j) continue;
             
             // Remove job from position i and insert at position j
-            int job = job_sequence_[i];
-            job_sequence_.erase(job_sequence_.begin() + i);
-            job_sequence_.insert(job_sequence_.begin() + (j > i ? j - 1 : j), job);
-            
-            int new_makespan = getMakespan();
-            if (new_makespan < current_makespan) {
-                current_makespan = new_makespan;
+            int target = j > i ? j - 1 : j;
+            if (makespans[target] < current_makespan) {
+                moveJob(i, target);
+                
+                current_makespan = makespans[target];
                 improved = true;
-            } else {
-                // Revert the move
-                job_sequence_.erase(job_sequence_.begin() + (j > i ? j - 1 : j));
-                job_sequence_.insert(job_sequence_.begin() + i, job);
-                invalidateCache();
+                
+                if (first_improvement) {
+                    return true;
+                }
+                
+                // Position i now holds a different job
+                evaluator.evaluateReinsertions(job_sequence_, i, makespans);
             }
         }
     }
@@ -199,31 +465,80 @@ bool Solution::applyInsertionSearch() {
     return improved;
 }
 
-Solution Solution::createSwapNeighbor() const {
-    Solution neighbor(*this);
+bool Solution::applyIteratedGreedy(int destruction_size, ThreadPool* pool) {
+    if (destruction_size < 1) {
+        throw std::invalid_argument("Destruction size must be positive");
+    }
+    
+    int num_jobs = job_sequence_.size();
+    int d = std::min(destruction_size, num_jobs - 1);
+    if (d < 1 || SearchBudget::isCurrentExhausted()) {
+        return false;
+    }
+    
+    InsertionEvaluator& evaluator = threadEvaluator(instance_);
+    static thread_local std::vector<int> partial;
+    static thread_local std::vector<int> removed;
+    static thread_local std::vector<int> makespans;
+    Random& rng = Random::getInstance();
+    
+    // Destruction: d distinct random jobs, in removal order
+    partial.assign(job_sequence_.begin(), job_sequence_.end());
+    removed.clear();
+    for (int r = 0; r < d; ++r) {
+        int position = rng.randInt(0, partial.size() - 1);
+        removed.push_back(partial[position]);
+        partial.erase(partial.begin() + position);
+    }
+    
+    // Reconstruction: each job at the first best position of the current partial sequence
+    int makespan = 0;
+    for (int job : removed) {
+        int position = evaluator.evaluateInsertions(partial, job, makespans, pool);
+        makespan = makespans[position];
+        partial.insert(partial.begin() + position, job);
+    }
+    
+    int current_makespan = getMakespan();
+    if (makespan > current_makespan) {
+        return false;
+    }
+    
+    job_sequence_.assign(partial.begin(), partial.end());
+    invalidateCache();
+    setKnownMakespan(makespan);
+    return makespan < current_makespan;
+}
+
+void Solution::applyRandomSwap() {
     Random& rng = Random::getInstance();
     
     int pos1 = rng.randInt(0, job_sequence_.size() - 1);
     int pos2 = rng.randInt(0, job_sequence_.size() - 1);
     
-    neighbor.swapJobs(pos1, pos2);
-    return neighbor;
+    swapJobs(pos1, pos2);
 }
 
-Solution Solution::createInsertNeighbor() const {
-    Solution neighbor(*this);
+void Solution::applyRandomInsertion() {
     Random& rng = Random::getInstance();
     
     int from_pos = rng.randInt(0, job_sequence_.size() - 1);
     int to_pos = rng.randInt(0, job_sequence_.size() - 1);
     
     if (from_pos != to_pos) {
-        int job = neighbor.job_sequence_[from_pos];
-        neighbor.job_sequence_.erase(neighbor.job_sequence_.begin() + from_pos);
-        neighbor.job_sequence_.insert(neighbor.job_sequence_.begin() + (to_pos > from_pos ? to_pos - 1 : to_pos), job);
-        neighbor.invalidateCache();
+        moveJob(from_pos, to_pos > from_pos ? to_pos - 1 : to_pos);
     }
-    
+}
+
+Solution Solution::createSwapNeighbor() const {
+    Solution neighbor(*this);
+    neighbor.applyRandomSwap();
+    return neighbor;
+}
+
+Solution Solution::createInsertNeighbor() const {
+    Solution neighbor(*this);
+    neighbor.applyRandomInsertion();
     return neighbor;
 }
 
@@ -267,7 +582,7 @@ void Solution::printDetailed() const {
     for (int pos = 0; pos < static_cast<int>(job_sequence_.size()); ++pos) {
         std::cout << std::setw(8) << ("J" + std::to_string(job_sequence_[pos] + 1));
         for (int machine = 0; machine < instance_->getNumMachines(); ++machine) {
-            std::cout << std::setw(8) << completion_times[pos][machine];
+            std::cout << std::setw(8) << completion_times[pos * instance_->getNumMachines() + machine];
         }
         std::cout << std::endl;
     }
@@ -293,37 +608,188 @@ void Solution::calculateMakespan() const {
     int num_jobs = job_sequence_.size();
     int num_machines = instance_->getNumMachines();
     
-    completion_times_.assign(num_jobs, std::vector<int>(num_machines, 0));
+    if (valid_rows_ > 0) {
+        // A valid prefix is held: resume the matrix from the first modified row
+        buildCompletionTimes();
+        return;
+    }
     
-    for (int pos = 0; pos < num_jobs; ++pos) {
-        int job = job_sequence_[pos];
+    // Value only: one rolling row of completion times, no matrix
+    if (instance_->getObjective() == ObjectiveType::MAKESPAN) {
+        const MakespanKernels& kernels = MakespanKernels::select(num_machines);
+        makespan_ = kernels.makespan(*instance_, job_sequence_.data(), num_jobs);
+    } else {
+        makespan_ = evaluateObjective(*instance_, job_sequence_.data(), num_jobs);
+    }
+    makespan_calculated_ = true;
+    HHOA_COUNT_EVALUATIONS(1);
+}
+
+void Solution::buildCompletionTimes() const {
+    int num_jobs = job_sequence_.size();
+    int num_machines = instance_->getNumMachines();
+    
+    if (valid_rows_ == num_jobs && makespan_calculated_) {
+        return;
+    }
+    
+    completion_times_.resize(static_cast<size_t>(num_jobs) * num_machines);
+    
+    ObjectiveType objective = instance_->getObjective();
+    if (objective != ObjectiveType::MAKESPAN) {
+        // The objective's own schedule, resumed from the valid rows as well
+        visitObjective(objective, [&](auto policy) {
+            using Policy = decltype(policy);
+            Policy::buildCompletionTimes(*instance_, job_sequence_.data(), valid_rows_, num_jobs,
+                                         completion_times_.data());
+            makespan_ = Policy::resume(*instance_, job_sequence_.data(), num_jobs, num_jobs,
+                                       completion_times_.data(), INT_MAX);
+        });
+        valid_rows_ = num_jobs;
+        makespan_calculated_ = true;
+        HHOA_COUNT_EVALUATIONS(1);
+        return;
+    }
+    
+    // Rows before valid_rows_ are unaffected by the last modifications
+    for (int pos = valid_rows_; pos < num_jobs; ++pos) {
+        const int* times = instance_->getJobTimes(job_sequence_[pos]);
+        int* row = &completion_times_[pos * num_machines];
         
-        for (int machine = 0; machine < num_machines; ++machine) {
-            int processing_time = instance_->getProcessingTime(job, machine);
-            
-            if (pos == 0 && machine == 0) {
-                // First job on first machine
-                completion_times_[pos][machine] = processing_time;
-            } else if (pos == 0) {
-                // First job on other machines
-                completion_times_[pos][machine] = completion_times_[pos][machine - 1] + processing_time;
-            } else if (machine == 0) {
-                // Other jobs on first machine
-                completion_times_[pos][machine] = completion_times_[pos - 1][machine] + processing_time;
-            } else {
-                // Other jobs on other machines
-                completion_times_[pos][machine] = std::max(completion_times_[pos - 1][machine],
-                                                         completion_times_[pos][machine - 1]) + processing_time;
+        if (pos > 0) {
+            // Other jobs: wait for the machine and for the previous operation
+            const int* prev = row - num_machines;
+            row[0] = prev[0] + times[0];
+            for (int machine = 1; machine < num_machines; ++machine) {
+                row[machine] = std::max(prev[machine], row[machine - 1]) + times[machine];
+            }
+        } else {
+            // First job: operations follow each other without waiting
+            row[0] = times[0];
+            for (int machine = 1; machine < num_machines; ++machine) {
+                row[machine] = row[machine - 1] + times[machine];
             }
         }
     }
     
-    makespan_ = num_jobs > 0 ? completion_times_[num_jobs - 1][num_machines - 1] : 0;
+    valid_rows_ = num_jobs;
+    makespan_ = num_jobs > 0 ? completion_times_[num_jobs * num_machines - 1] : 0;
     makespan_calculated_ = true;
+    HHOA_COUNT_EVALUATIONS(1);
+}
+
+void Solution::buildTails() const {
+    int num_jobs = job_sequence_.size();
+    int num_machines = instance_->getNumMachines();
+    
+    if (valid_tail_rows_ == num_jobs) {
+        return;
+    }
+    
+    // Row num_jobs is the empty suffix
+    size_t rows = static_cast<size_t>(num_jobs + 1) * num_machines;
+    if (tails_.size() != rows) {
+        tails_.assign(rows, 0);
+        suffix_loads_.assign(rows, 0);
+        valid_tail_rows_ = 0;
+    }
+    
+    // Rows after the last modified position are unaffected
+    for (int pos = num_jobs - 1 - valid_tail_rows_; pos >= 0; --pos) {
+        const int* times = instance_->getJobTimes(job_sequence_[pos]);
+        int* tail = &tails_[pos * num_machines];
+        int* load = &suffix_loads_[pos * num_machines];
+        const int* next_tail = tail + num_machines;
+        const int* next_load = load + num_machines;
+        
+        // Last machine: only the next operation of the same machine follows
+        tail[num_machines - 1] = next_tail[num_machines - 1] + times[num_machines - 1];
+        load[num_machines - 1] = next_load[num_machines - 1] + times[num_machines - 1];
+        for (int machine = num_machines - 2; machine >= 0; --machine) {
+            tail[machine] = std::max(next_tail[machine], tail[machine + 1]) + times[machine];
+            load[machine] = next_load[machine] + times[machine];
+        }
+    }
+    
+    valid_tail_rows_ = num_jobs;
+}
+
+int Solution::evaluateWindow(int first, int last, const int* window, int bound) const {
+    int num_jobs = job_sequence_.size();
+    int num_machines = instance_->getNumMachines();
+    
+    // Completion times before the window and tails after it are reused
+    if (valid_rows_ < first) {
+        buildCompletionTimes();
+    }
+    HHOA_COUNT_EVALUATIONS(1);
+    
+    ObjectiveType objective = instance_->getObjective();
+    if (objective != ObjectiveType::MAKESPAN) {
+        // Other objectives: resume the schedule of the candidate from the window on
+        static thread_local std::vector<int> candidate;
+        candidate.assign(job_sequence_.begin(), job_sequence_.end());
+        std::copy(window, window + (last - first + 1), candidate.begin() + first);
+        return visitObjective(objective, [&](auto policy) {
+            return decltype(policy)::resume(*instance_, candidate.data(), first, num_jobs,
+                                            completion_times_.data(), bound);
+        });
+    }
+    buildTails();
+    
+    // remaining[k]: work left on machine k after the current row (the window
+    // permutes its own jobs, so the suffix from first holds the same work)
+    static thread_local std::vector<int> row;
+    static thread_local std::vector<int> remaining;
+    row.assign(num_machines, 0);
+    remaining.assign(suffix_loads_.begin() + first * num_machines,
+                     suffix_loads_.begin() + (first + 1) * num_machines);
+    if (first > 0) {
+        std::copy_n(&completion_times_[(first - 1) * num_machines], num_machines, row.begin());
+    }
+    
+    for (int pos = first; pos <= last; ++pos) {
+        const int* times = instance_->getJobTimes(window[pos - first]);
+        
+        row[0] += times[0];
+        remaining[0] -= times[0];
+        int lower_bound = row[0] + remaining[0];
+        for (int machine = 1; machine < num_machines; ++machine) {
+            row[machine] = std::max(row[machine], row[machine - 1]) + times[machine];
+            remaining[machine] -= times[machine];
+            lower_bound = std::max(lower_bound, row[machine] + remaining[machine]);
+        }
+        
+        // Every machine still has to process its remaining work
+        if (lower_bound >= bound) {
+            return lower_bound;
+        }
+    }
+    
+    if (last == num_jobs - 1) {
+        return row[num_machines - 1];
+    }
+    
+    // Join the window to the unchanged suffix through the tails
+    const int* tail = &tails_[(last + 1) * num_machines];
+    int makespan = 0;
+    for (int machine = 0; machine < num_machines; ++machine) {
+        makespan = std::max(makespan, row[machine] + tail[machine]);
+    }
+    return makespan;
 }
 
 void Solution::invalidateCache() {
     makespan_calculated_ = false;
     makespan_ = -1;
-    completion_times_.clear();
+    valid_rows_ = 0;
+    valid_tail_rows_ = 0;
+    hash_valid_ = false;
+}
+
+void Solution::invalidateRange(int first, int last) {
+    makespan_calculated_ = false;
+    makespan_ = -1;
+    valid_rows_ = std::min(valid_rows_, first);
+    valid_tail_rows_ = std::min(valid_tail_rows_, static_cast<int>(job_sequence_.size()) - 1 - last);
 }
@@ -3,21 +3,35 @@
 
 #include <vector>
 #include <memory>
+#include <cstdint>
+#include <climits>
 #include "ProblemInstance.h"
 
+class ThreadPool;
+
 /**
  * @brief Represents a solution for the Flow Shop Scheduling Problem
  * 
  * A solution is represented as a permutation of jobs, indicating the order
- * in which jobs should be processed on all machines.
+ * in which jobs should be processed on all machines. It is scored by the
+ * objective of its instance (see Objective.h); "makespan" below stands for
+ * that objective value, which is the makespan unless another one is set.
  */
 class Solution {
+    friend class MakespanEvaluator;  // Fills the makespan cache of batch-evaluated solutions
+
 private:
     std::vector<int> job_sequence_;          // Job permutation (0-indexed)
     std::shared_ptr<ProblemInstance> instance_;  // Problem instance
     mutable int makespan_;                   // Cached makespan value
     mutable bool makespan_calculated_;       // Flag to check if makespan is calculated
-    mutable std::vector<std::vector<int>> completion_times_;  // Completion times [job][machine]
+    mutable std::vector<int> completion_times_;  // Flat completion times [position * m + machine], built lazily
+    mutable int valid_rows_;                 // Number of leading rows of completion_times_ still valid
+    mutable std::vector<int> tails_;         // Flat tails [position * m + machine]: longest path from the operation to the end
+    mutable std::vector<int> suffix_loads_;  // Flat loads [position * m + machine]: work of the jobs from position onward
+    mutable int valid_tail_rows_;            // Number of trailing rows of tails_ and suffix_loads_ still valid
+    mutable std::uint64_t hash_;             // Cached Zobrist fingerprint of job_sequence_
+    mutable bool hash_valid_;                // Whether hash_ is up to date
 
 public:
     /**
@@ -34,18 +48,31 @@ public:
     Solution(const std::vector<int>& job_sequence, std::shared_ptr<ProblemInstance> instance);
 
     /**
-     * @brief Copy constructor
+     * @brief Copy constructor (copies the sequence and cached makespan only)
      * @param other Solution to copy
      */
     Solution(const Solution& other);
 
     /**
-     * @brief Assignment operator
+     * @brief Assignment operator (copies the sequence and cached makespan only)
      * @param other Solution to assign
      * @return Reference to this solution
      */
     Solution& operator=(const Solution& other);
 
+    /**
+     * @brief Move constructor (also takes over the completion-time buffer)
+     * @param other Solution to move from
+     */
+    Solution(Solution&& other) noexcept;
+
+    /**
+     * @brief Move assignment operator (also takes over the completion-time buffer)
+     * @param other Solution to move from
+     * @return Reference to this solution
+     */
+    Solution& operator=(Solution&& other) noexcept;
+
     // Getters
     const std::vector<int>& getJobSequence() const { return job_sequence_; }
     std::shared_ptr<ProblemInstance> getInstance() const { return instance_; }
@@ -58,16 +85,53 @@ public:
     void swapJobs(int pos1, int pos2);
 
     /**
-     * @brief Calculate and return the makespan (total completion time)
-     * @return Makespan value
+     * @brief Move the job at one position to another position
+     * @param from_pos Position of the job to move
+     * @param to_pos Position of the job in the resulting sequence
+     */
+    void moveJob(int from_pos, int to_pos);
+
+    /**
+     * @brief Calculate and return the objective value (the makespan by default)
+     * @return Objective value of the instance's objective
      */
     int getMakespan() const;
 
     /**
-     * @brief Get completion times matrix
-     * @return Completion times [job_in_sequence][machine]
+     * @brief Zobrist fingerprint of the job sequence
+     *
+     * XOR of one pseudo-random key per (position, job) pair. Once computed it
+     * is updated incrementally by swaps, single-job changes and moves, so
+     * neighbors of a hashed solution are hashed in O(1) or O(distance).
+     *
+     * @return 64-bit fingerprint
+     */
+    std::uint64_t getHash() const;
+
+    /**
+     * @brief Store an externally known makespan of the current sequence
+     *
+     * Used by evaluation caches; the completion-time matrix is not built.
+     *
+     * @param makespan Makespan of the current sequence
      */
-    const std::vector<std::vector<int>>& getCompletionTimes() const;
+    void setKnownMakespan(int makespan);
+
+    /**
+     * @brief Check whether the makespan is cached
+     * @return True if getMakespan() will not evaluate
+     */
+    bool isEvaluated() const { return makespan_calculated_; }
+
+    /**
+     * @brief Get completion times matrix (built on first request)
+     *
+     * Under the setup and no-wait objectives the times are those of the
+     * objective's schedule.
+     *
+     * @return Flat completion times [job_in_sequence * num_machines + machine]
+     */
+    const std::vector<int>& getCompletionTimes() const;
 
     /**
      * @brief Get completion time for a specific job and machine
@@ -77,6 +141,35 @@ public:
      */
     int getCompletionTime(int job_position, int machine) const;
 
+    /**
+     * @brief Makespan of the sequence with two jobs swapped, without applying the swap
+     *
+     * Only the rows between the two positions are recomputed: the completion
+     * times before them and the tails after them are reused. While the rows
+     * are swept, the remaining work of every machine gives a lower bound,
+     * and the evaluation is abandoned as soon as it reaches the bound.
+     * Other objectives than the makespan reuse the rows before the swap and
+     * replay the rest (see Objective.h).
+     *
+     * @param pos1 First position
+     * @param pos2 Second position
+     * @param bound Abandon once the makespan is known to be at least this value
+     * @return Makespan of the swapped sequence if it is below bound, otherwise a value >= bound
+     */
+    int evaluateSwap(int pos1, int pos2, int bound = INT_MAX) const;
+
+    /**
+     * @brief Makespan of the sequence with one job moved, without applying the move
+     *
+     * Same scheme as evaluateSwap(); the result matches moveJob(from_pos, to_pos).
+     *
+     * @param from_pos Position of the job to move
+     * @param to_pos Position of the job in the resulting sequence
+     * @param bound Abandon once the makespan is known to be at least this value
+     * @return Makespan of the resulting sequence if it is below bound, otherwise a value >= bound
+     */
+    int evaluateMove(int from_pos, int to_pos, int bound = INT_MAX) const;
+
     /**
      * @brief Initialize with random job sequence
      */
@@ -87,6 +180,27 @@ public:
      */
     void initializeGreedy();
 
+    /**
+     * @brief Initialize with the NEH heuristic (Nawaz, Enscore & Ham, 1983)
+     *
+     * Jobs are taken in decreasing order of total processing time and each
+     * one is inserted at the position that minimizes the partial makespan
+     * (first such position on ties). Every insertion step is one accelerated
+     * sweep (see InsertionEvaluator), O(n^2 * m) in total.
+     */
+    void initializeNEH();
+
+    /**
+     * @brief Initialize with a randomized NEH variant
+     *
+     * Ties between the best insertion positions are broken uniformly at
+     * random, and the total processing times that order the jobs can be
+     * perturbed by relative uniform noise.
+     *
+     * @param perturbation Noise amplitude in [0, 1] (0 keeps the NEH order)
+     */
+    void initializeRandomizedNEH(double perturbation = 0.0);
+
     /**
      * @brief Check if the solution is valid
      * @return True if valid, false otherwise
@@ -95,15 +209,50 @@ public:
 
     /**
      * @brief Apply 2-opt local search improvement
+     *
+     * Ends early, keeping the moves applied so far, once the search budget
+     * bound to the thread is exhausted (see SearchBudget).
+     *
+     * @param first_improvement Stop at the first improving move
      * @return True if improvement was found, false otherwise
      */
-    bool apply2Opt();
+    bool apply2Opt(bool first_improvement = false);
 
     /**
      * @brief Apply insertion-based local search
+     *
+     * Every reinsertion position of a job is scored at once with the
+     * accelerated insertion evaluator (see InsertionEvaluator). Like
+     * apply2Opt, it ends early once the thread's search budget is exhausted.
+     *
+     * @param first_improvement Stop at the first improving move
      * @return True if improvement was found, false otherwise
      */
-    bool applyInsertionSearch();
+    bool applyInsertionSearch(bool first_improvement = false);
+
+    /**
+     * @brief Apply one destruction-reconstruction step (iterated greedy, Ruiz & Stutzle, 2007)
+     *
+     * Removes destruction_size random jobs and reinserts them one by one at
+     * their best position, each with one accelerated insertion sweep, so the
+     * step costs O(d * n * m). The result is kept unless it is worse, so equal
+     * makespans move the solution across plateaus.
+     *
+     * @param destruction_size Jobs removed (d >= 1, capped at n - 1)
+     * @param pool Threads scoring each sweep in chunks (null: calling thread only)
+     * @return True if the makespan improved
+     */
+    bool applyIteratedGreedy(int destruction_size, ThreadPool* pool = nullptr);
+
+    /**
+     * @brief Swap two random jobs in place
+     */
+    void applyRandomSwap();
+
+    /**
+     * @brief Move a random job to a random position in place
+     */
+    void applyRandomInsertion();
 
     /**
      * @brief Create a neighbor solution by swapping two random jobs
@@ -144,14 +293,59 @@ public:
 
 private:
     /**
-     * @brief Calculate makespan and completion times
+     * @brief Calculate makespan
+     *
+     * Resumes from the valid prefix of the completion-time matrix when one is
+     * held, otherwise evaluates with a single rolling row of m values
+     * (using the kernel specialized for the machine count, if any) or with
+     * the evaluation of the instance's objective.
      */
     void calculateMakespan() const;
 
+    /**
+     * @brief Build the full completion-time matrix
+     */
+    void buildCompletionTimes() const;
+
     /**
      * @brief Invalidate cached values
      */
     void invalidateCache();
+
+    /**
+     * @brief Build the tail and suffix-load matrices (rows after the valid ones are kept)
+     */
+    void buildTails() const;
+
+    /**
+     * @brief Build the sequence by NEH insertion
+     * @param order Jobs in insertion order
+     * @param random_ties Break ties between best positions at random (otherwise first)
+     */
+    void constructByInsertion(const std::vector<int>& order, bool random_ties);
+
+    /**
+     * @brief Makespan with the positions of a window replaced by other jobs
+     * @param first First position of the window
+     * @param last Last position of the window
+     * @param window Jobs of positions first..last in the candidate sequence
+     *               (a permutation of the current jobs of the window)
+     * @param bound Abandon once the makespan is known to be at least this value
+     * @return Makespan if it is below bound, otherwise a value >= bound
+     */
+    int evaluateWindow(int first, int last, const int* window, int bound) const;
+
+    /**
+     * @brief Invalidate cached values of a range of modified positions
+     *
+     * Completion times of the positions before the range and tails of the
+     * positions after it are unchanged, so the next evaluation only
+     * recomputes the affected rows.
+     *
+     * @param first First modified position
+     * @param last Last modified position
+     */
+    void invalidateRange(int first, int last);
 };
 
 #endif // SOLUTION_H
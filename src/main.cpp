@@ -1,12 +1,19 @@
 #include "core/ProblemInstance.h"
 #include "core/Solution.h"
+#include "core/Objective.h"
 #include "algorithm/HHOA.h"
+#include "algorithm/IslandHHOA.h"
+#include "algorithm/BatchRunner.h"
 #include "utils/Logger.h"
 #include "utils/Timer.h"
 #include "utils/Random.h"
+#include "utils/Profiler.h"
 #include <iostream>
 #include <string>
 #include <memory>
+#include <thread>
+#include <algorithm>
+#include <iomanip>
 
 void printBanner() {
     std::cout << "=========================================" << std::endl;
@@ -26,13 +33,37 @@ void printUsage(const char* program_name) {
     std::cout << "  -p <population>  Population size (default: 30)" << std::endl;
     std::cout << "  -i <iterations>  Maximum iterations (default: 1000)" << std::endl;
     std::cout << "  -s <seed>        Random seed (default: time-based)" << std::endl;
-    std::cout << "  -o <output>      Output file for results" << std::endl;
+    std::cout << "  -t <threads>     Threads for the herd phases (default: 1)" << std::endl;
+    std::cout << "  -I <islands>     Run the island model with this many herds (default: 1)" << std::endl;
+    std::cout << "  -c <slots>       Evaluation cache slots per herd (default: 0, disabled)" << std::endl;
+    std::cout << "  -H <heuristic>   Constructive initialization: neh or spt (default: neh)" << std::endl;
+    std::cout << "  -G <mode>        Grazing local search: ls or ig (iterated greedy) (default: ls)" << std::endl;
+    std::cout << "  -d <jobs>        Jobs removed per iterated-greedy grazing step (default: 4)" << std::endl;
+    std::cout << "  -O <objective>   Objective: makespan, flowtime, sdst (setup times) or nowait (default: the instance's)" << std::endl;
+    std::cout << "  -U <max>         Draw setup times in [1, max] for the instance (stored by -B)" << std::endl;
+    std::cout << "  -L <ms>          Wall-clock limit per run (default: none)" << std::endl;
+    std::cout << "  -R <t>           Wall-clock limit per run of n*m/2*t ms (overrides -L)" << std::endl;
+    std::cout << "  -E <evaluations> Makespan evaluation limit per run (default: none)" << std::endl;
+    std::cout << "  -C <file>        Checkpoint the run to this file (resume with -r)" << std::endl;
+    std::cout << "  -K <iterations>  Iterations between checkpoints (default: 100)" << std::endl;
+    std::cout << "  -r <file>        Resume the run saved in a checkpoint of the same instance" << std::endl;
+    std::cout << "  -S <file>        Stream the iteration statistics to this CSV file while running" << std::endl;
+    std::cout << "  -k <k>           Record every k-th iteration in the statistics (0: improvements only; default: 1)" << std::endl;
+    std::cout << "  -a               Adaptive operator selection: skip operators that stopped improving" << std::endl;
+    std::cout << "  -o <output>      Output file for results (batch: .csv or .json)" << std::endl;
+    std::cout << "  -B <file>        Save the instance (-f or generated) in the binary format and exit" << std::endl;
+    std::cout << "  -T <trace>       Save a Chrome/Perfetto trace of the iteration phases (JSON)" << std::endl;
+    std::cout << "  -b <list>        Batch mode: run every instance of a list file (<path> [upper_bound] per line)" << std::endl;
+    std::cout << "  -n <seeds>       Batch mode: runs per instance, seeds -s, -s + 1, ... (default: 10)" << std::endl;
+    std::cout << "  -W <workers>     Batch mode: concurrent runs (default: hardware threads)" << std::endl;
     std::cout << "  -v              Verbose output" << std::endl;
     std::cout << "  -h              Show this help" << std::endl;
     std::cout << std::endl;
     std::cout << "Examples:" << std::endl;
     std::cout << "  " << program_name << " -j 10 -m 5 -p 30 -i 1000" << std::endl;
     std::cout << "  " << program_name << " -f data/instances/ta001.txt -v" << std::endl;
+    std::cout << "  " << program_name << " -f data/instances/ta001.txt -C run.ckpt -K 50" << std::endl;
+    std::cout << "  " << program_name << " -b data/instances/taillard.txt -s 1 -n 10 -W 8 -o results.csv" << std::endl;
 }
 
 std::shared_ptr<ProblemInstance> createTestInstance() {
@@ -53,6 +84,45 @@ std::shared_ptr<ProblemInstance> createTestInstance() {
     return std::make_shared<ProblemInstance>(processing_times, "TestInstance_10x10");
 }
 
+int runBatch(const std::string& list_file, const HHOAParameters& params,
+             const BatchParameters& batch_params, const std::string& output_file) {
+    BatchRunner runner(params, batch_params);
+    runner.loadInstanceList(list_file);
+    
+    int total = runner.getInstances().size() * batch_params.num_seeds;
+    std::cout << "Batch: " << runner.getInstances().size() << " instances x " << batch_params.num_seeds
+              << " seeds = " << total << " runs on " << batch_params.num_workers << " workers" << std::endl;
+    std::cout << std::endl;
+    
+    // The runs' own log lines would interleave: keep them in the log file, report per run instead
+    Logger::getInstance().setConsoleOutput(false);
+    runner.setProgressCallback([&runner](const BatchRun& run, int completed, int total_runs) {
+        std::cerr << "[" << completed << "/" << total_runs << "] " << runner.getInstances()[run.instance_index].name
+                  << " seed " << run.seed << ": " << run.makespan << " (" << run.time_ms << " ms)" << std::endl;
+    });
+    
+    Timer timer;
+    timer.start();
+    runner.run();
+    
+    std::cout << std::endl;
+    std::cout << "=== BATCH RESULTS ===" << std::endl;
+    runner.printSummary();
+    std::cout << "Total Time: " << timer.getElapsedMs() << " ms" << std::endl;
+    
+    if (!output_file.empty()) {
+        bool json = output_file.size() >= 5 && output_file.compare(output_file.size() - 5, 5, ".json") == 0;
+        if (json ? runner.saveJson(output_file) : runner.saveCsv(output_file)) {
+            std::cout << "Results saved to: " << output_file << std::endl;
+        } else {
+            std::cerr << "Warning: Failed to save results to " << output_file << std::endl;
+            return 1;
+        }
+    }
+    
+    return 0;
+}
+
 void iterationCallback(int iteration, const Solution& best_solution, const HHOAStatistics& stats) {
     if (iteration % 100 == 0) {
         std::cout << "Iteration " << iteration 
@@ -68,11 +138,33 @@ int main(int argc, char* argv[]) {
         // Parse command line arguments
         std::string instance_file;
         std::string output_file;
+        std::string batch_file;
+        std::string trace_file;
+        std::string binary_file;
+        std::string checkpoint_file;
+        std::string resume_file;
+        int checkpoint_interval = 100;
+        std::string history_file;
+        int history_interval = 1;
+        int num_seeds = 10;
+        int num_workers = std::max(1u, std::thread::hardware_concurrency());
         int num_jobs = 10;
         int num_machines = 5;
         int population_size = 30;
         int max_iterations = 1000;
         unsigned int seed = 0;
+        int num_threads = 1;
+        int num_islands = 1;
+        int cache_size = 0;
+        InitialHeuristic initial_heuristic = InitialHeuristic::NEH;
+        GrazingMode grazing_mode = GrazingMode::LOCAL_SEARCH;
+        int destruction_size = 4;
+        std::string objective_name;
+        int max_setup_time = 0;
+        double time_limit_ms = 0.0;
+        double time_factor = 0.0;
+        long long max_evaluations = 0;
+        bool operator_selection = false;
         bool verbose = false;
         bool use_file = false;
         
@@ -95,8 +187,73 @@ int main(int argc, char* argv[]) {
                 max_iterations = std::stoi(argv[++i]);
             } else if (arg == "-s" && i + 1 < argc) {
                 seed = std::stoul(argv[++i]);
+            } else if (arg == "-t" && i + 1 < argc) {
+                num_threads = std::stoi(argv[++i]);
+            } else if (arg == "-I" && i + 1 < argc) {
+                num_islands = std::stoi(argv[++i]);
+            } else if (arg == "-c" && i + 1 < argc) {
+                cache_size = std::stoi(argv[++i]);
+            } else if (arg == "-H" && i + 1 < argc) {
+                std::string heuristic = argv[++i];
+                if (heuristic == "neh") {
+                    initial_heuristic = InitialHeuristic::NEH;
+                } else if (heuristic == "spt") {
+                    initial_heuristic = InitialHeuristic::SPT;
+                } else {
+                    std::cerr << "Unknown initial heuristic: " << heuristic << std::endl;
+                    return 1;
+                }
+            } else if (arg == "-G" && i + 1 < argc) {
+                std::string mode = argv[++i];
+                if (mode == "ls") {
+                    grazing_mode = GrazingMode::LOCAL_SEARCH;
+                } else if (mode == "ig") {
+                    grazing_mode = GrazingMode::ITERATED_GREEDY;
+                } else {
+                    std::cerr << "Unknown grazing mode: " << mode << std::endl;
+                    return 1;
+                }
+            } else if (arg == "-d" && i + 1 < argc) {
+                destruction_size = std::stoi(argv[++i]);
+            } else if (arg == "-O" && i + 1 < argc) {
+                objective_name = argv[++i];
+                ObjectiveType objective;
+                if (!parseObjective(objective_name, objective)) {
+                    std::cerr << "Unknown objective: " << objective_name << std::endl;
+                    return 1;
+                }
+            } else if (arg == "-U" && i + 1 < argc) {
+                max_setup_time = std::stoi(argv[++i]);
+            } else if (arg == "-L" && i + 1 < argc) {
+                time_limit_ms = std::stod(argv[++i]);
+            } else if (arg == "-R" && i + 1 < argc) {
+                time_factor = std::stod(argv[++i]);
+            } else if (arg == "-E" && i + 1 < argc) {
+                max_evaluations = std::stoll(argv[++i]);
+            } else if (arg == "-C" && i + 1 < argc) {
+                checkpoint_file = argv[++i];
+            } else if (arg == "-K" && i + 1 < argc) {
+                checkpoint_interval = std::stoi(argv[++i]);
+            } else if (arg == "-r" && i + 1 < argc) {
+                resume_file = argv[++i];
+            } else if (arg == "-S" && i + 1 < argc) {
+                history_file = argv[++i];
+            } else if (arg == "-k" && i + 1 < argc) {
+                history_interval = std::stoi(argv[++i]);
+            } else if (arg == "-a") {
+                operator_selection = true;
             } else if (arg == "-o" && i + 1 < argc) {
                 output_file = argv[++i];
+            } else if (arg == "-B" && i + 1 < argc) {
+                binary_file = argv[++i];
+            } else if (arg == "-T" && i + 1 < argc) {
+                trace_file = argv[++i];
+            } else if (arg == "-b" && i + 1 < argc) {
+                batch_file = argv[++i];
+            } else if (arg == "-n" && i + 1 < argc) {
+                num_seeds = std::stoi(argv[++i]);
+            } else if (arg == "-W" && i + 1 < argc) {
+                num_workers = std::stoi(argv[++i]);
             } else if (arg == "-v") {
                 verbose = true;
             }
@@ -106,6 +263,40 @@ int main(int argc, char* argv[]) {
         Logger& logger = Logger::getInstance();
         logger.initialize("../data/results/hhoa_log.txt", verbose ? LogLevel::DEBUG : LogLevel::INFO, true);
         
+        // Configure HHOA parameters
+        HHOAParameters params;
+        params.population_size = population_size;
+        params.max_iterations = max_iterations;
+        params.adaptive_parameters = true;
+        params.operator_selection = operator_selection;
+        params.num_threads = num_threads;
+        params.evaluation_cache_size = cache_size;
+        params.initial_heuristic = initial_heuristic;
+        params.grazing_mode = grazing_mode;
+        params.destruction_size = destruction_size;
+        params.time_limit_ms = time_limit_ms;
+        params.max_evaluations = max_evaluations;
+        params.history_file = history_file;
+        params.history_interval = history_interval;
+        if (!checkpoint_file.empty()) {
+            params.checkpoint_file = checkpoint_file;
+            params.checkpoint_interval = checkpoint_interval;
+        }
+        params.record_trace = !trace_file.empty();
+        if (params.record_trace && !Profiler::isEnabled()) {
+            std::cerr << "Warning: built without HHOA_ENABLE_PROFILING, the trace will be empty" << std::endl;
+        }
+        
+        // Batch mode: every instance of the list with every seed of the range
+        if (!batch_file.empty()) {
+            BatchParameters batch_params;
+            batch_params.num_workers = num_workers;
+            batch_params.first_seed = seed != 0 ? seed : 1;
+            batch_params.num_seeds = num_seeds;
+            batch_params.time_factor = time_factor;
+            return runBatch(batch_file, params, batch_params, output_file);
+        }
+        
         // Set random seed
         Random& rng = Random::getInstance();
         if (seed != 0) {
@@ -140,9 +331,49 @@ int main(int argc, char* argv[]) {
             return 1;
         }
         
+        if (max_setup_time > 0) {
+            instance->generateRandomSetupTimes(1, max_setup_time);
+        }
+        if (!objective_name.empty()) {
+            ObjectiveType objective = ObjectiveType::MAKESPAN;
+            parseObjective(objective_name, objective);
+            if (objective == ObjectiveType::SDST_MAKESPAN && !instance->hasSetupTimes()) {
+                std::cerr << "Error: The sdst objective needs setup times (binary instance with setups or -U)"
+                          << std::endl;
+                return 1;
+            }
+            try {
+                instance->setObjective(objective);
+            } catch (const std::invalid_argument& e) {
+                std::cerr << "Error: " << e.what() << std::endl;
+                return 1;
+            }
+        }
+        
+        // Conversion only: loaded zero-copy by later runs
+        if (!binary_file.empty()) {
+            if (!instance->saveToFile(binary_file, InstanceFormat::BINARY)) {
+                return 1;
+            }
+            logger.flush();
+            std::cout << "Binary instance saved to: " << binary_file << std::endl;
+            return 0;
+        }
+        
+        if (time_factor > 0.0) {
+            params.time_limit_ms = HHOAParameters::scaledTimeLimitMs(instance->getNumJobs(),
+                                                                     instance->getNumMachines(), time_factor);
+        }
+        
+        // The logger writes asynchronously: flush it before each console section to keep the order
+        logger.flush();
+        
         // Print instance information
         std::cout << "Problem Instance: " << instance->getInstanceName() << std::endl;
         std::cout << "Jobs: " << instance->getNumJobs() << ", Machines: " << instance->getNumMachines() << std::endl;
+        if (instance->getObjective() != ObjectiveType::MAKESPAN) {
+            std::cout << "Objective: " << objectiveName(instance->getObjective()) << std::endl;
+        }
         std::cout << std::endl;
         
         if (verbose) {
@@ -150,12 +381,6 @@ int main(int argc, char* argv[]) {
             std::cout << std::endl;
         }
         
-        // Configure HHOA parameters
-        HHOAParameters params;
-        params.population_size = population_size;
-        params.max_iterations = max_iterations;
-        params.adaptive_parameters = true;
-        
         if (verbose) {
             params.print();
             std::cout << std::endl;
@@ -166,6 +391,29 @@ int main(int argc, char* argv[]) {
         std::cout << "Population: " << population_size << ", Iterations: " << max_iterations << std::endl;
         std::cout << std::endl;
         
+        // Island model: one herd per thread with periodic elite migration
+        if (num_islands > 1) {
+            IslandParameters island_params;
+            island_params.num_islands = num_islands;
+            IslandHHOA islands(instance, params, island_params);
+            
+            ScopedTimer optimization_timer("Optimization");
+            Solution best_solution = islands.optimize();
+            logger.flush();
+            
+            std::cout << std::endl;
+            std::cout << "=== OPTIMIZATION RESULTS ===" << std::endl;
+            islands.print();
+            std::cout << std::endl;
+            
+            std::cout << "Best Solution:" << std::endl;
+            best_solution.print();
+            std::cout << std::endl;
+            LOG_INFO("HHOA execution completed successfully");
+            logger.flush();
+            return 0;
+        }
+        
         HHOA algorithm(instance, params);
         
         // Set callback for progress reporting
@@ -175,16 +423,24 @@ int main(int argc, char* argv[]) {
         
         // Run optimization
         ScopedTimer optimization_timer("Optimization");
-        Solution best_solution = algorithm.optimize();
+        Solution best_solution = resume_file.empty() ? algorithm.optimize() : algorithm.resume(resume_file);
+        logger.flush();
         
         // Print results
         std::cout << std::endl;
         std::cout << "=== OPTIMIZATION RESULTS ===" << std::endl;
         std::cout << "Best Makespan: " << best_solution.getMakespan() << std::endl;
+        std::cout << "Lower Bound: " << algorithm.getStatistics().lower_bound << " (gap "
+                  << std::setprecision(3) << algorithm.getStatistics().getOptimalityGap() << std::setprecision(6) << "%"
+                  << (algorithm.getStatistics().optimal ? ", optimal" : "") << ")" << std::endl;
         std::cout << "Execution Time: " << algorithm.getStatistics().execution_time_ms << " ms" << std::endl;
         std::cout << "Iterations: " << algorithm.getStatistics().iterations_executed << std::endl;
         std::cout << "Total Improvements: " << algorithm.getStatistics().total_improvements << std::endl;
         std::cout << "Leader Changes: " << algorithm.getStatistics().leader_changes << std::endl;
+        if (cache_size > 0) {
+            const HHOAStatistics& stats = algorithm.getStatistics();
+            std::cout << "Cache Hits: " << stats.cache_hits << " / " << (stats.cache_hits + stats.cache_misses) << std::endl;
+        }
         std::cout << std::endl;
         
         // Print best solution
@@ -213,6 +469,10 @@ int main(int argc, char* argv[]) {
             }
         }
         
+        if (!trace_file.empty() && algorithm.saveTrace(trace_file)) {
+            std::cout << "Trace saved to: " << trace_file << std::endl;
+        }
+        
         // Save test instance if it was generated
         if (!use_file && num_jobs != 10) {
             std::string instance_filename = "data/instances/generated_" + 
@@ -224,10 +484,12 @@ int main(int argc, char* argv[]) {
         }
         
         LOG_INFO("HHOA execution completed successfully");
+        logger.flush();  // Before the optimization timer prints its summary
         
     } catch (const std::exception& e) {
         std::cerr << "Error: " << e.what() << std::endl;
         LOG_ERROR("Exception: " + std::string(e.what()));
+        Logger::getInstance().flush();
         return 1;
     }
     
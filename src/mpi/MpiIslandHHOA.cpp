@@ -0,0 +1,234 @@
+#include "MpiIslandHHOA.h"
+#include "../utils/Random.h"
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <exception>
+#include <stdexcept>
+
+void MpiParameters::print() const {
+    std::cout << "MPI Parameters:" << std::endl;
+    std::cout << "  Sync Interval: " << sync_interval_ms << " ms" << std::endl;
+    std::cout << "  Global Patience: " << global_patience << " rounds" << std::endl;
+}
+
+bool MpiParameters::isValid() const {
+    return sync_interval_ms > 0 && global_patience > 0;
+}
+
+MpiIslandHHOA::MpiIslandHHOA(MPI_Comm comm,
+                             std::shared_ptr<ProblemInstance> instance,
+                             const HHOAParameters& parameters,
+                             const IslandParameters& island_parameters,
+                             const MpiParameters& mpi_parameters)
+    : comm_(comm), rank_(0), num_ranks_(1), instance_(instance), mpi_parameters_(mpi_parameters),
+      best_makespan_(0), sync_rounds_(0), migrants_received_(0) {
+    if (!instance_ || !instance_->isValid()) {
+        throw std::invalid_argument("Invalid problem instance");
+    }
+    if (!mpi_parameters_.isValid()) {
+        throw std::invalid_argument("Invalid MPI parameters");
+    }
+
+    MPI_Comm_rank(comm_, &rank_);
+    MPI_Comm_size(comm_, &num_ranks_);
+
+    // Agree on one base seed, then give every rank its own stream of it
+    std::uint64_t seed = island_parameters.seed != 0 ? island_parameters.seed
+                                                     : Random::getInstance().nextSeed();
+    MPI_Bcast(&seed, 1, MPI_UINT64_T, 0, comm_);
+
+    IslandParameters rank_parameters = island_parameters;
+    rank_parameters.seed = Random(seed, rank_).nextSeed();
+    islands_ = std::make_unique<IslandHHOA>(instance_, parameters, rank_parameters);
+}
+
+Solution MpiIslandHHOA::optimize() {
+    LOG_INFO("Rank " + std::to_string(rank_) + " starting " +
+             std::to_string(islands_->getNumIslands()) + " islands");
+
+    sync_rounds_ = 0;
+    migrants_received_ = 0;
+
+    // Local islands run on a worker thread; only this thread calls MPI
+    std::atomic<bool> running{true};
+    std::exception_ptr error;
+    std::thread worker([this, &running, &error] {
+        try {
+            islands_->optimize();
+        } catch (...) {
+            error = std::current_exception();
+        }
+        running.store(false);
+    });
+
+    int global_best = INT_MAX;
+    int stale_rounds = 0;
+
+    while (true) {
+        // Wait for the next sync point, waking early once the local islands are done
+        auto deadline = std::chrono::steady_clock::now() +
+                        std::chrono::milliseconds(mpi_parameters_.sync_interval_ms);
+        while (running.load() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+
+        bool islands_running = running.load();
+        Migrant local = islands_->getBestMigrant();
+
+        int local_best = local.job_sequence.empty() ? INT_MAX : local.makespan;
+        int round_best = INT_MAX;
+        MPI_Allreduce(&local_best, &round_best, 1, MPI_INT, MPI_MIN, comm_);
+
+        int local_running = islands_running ? 1 : 0;
+        int any_running = 0;
+        MPI_Allreduce(&local_running, &any_running, 1, MPI_INT, MPI_MAX, comm_);
+
+        exchangeMigrants(local, islands_running);
+        ++sync_rounds_;
+
+        // Global patience: every rank sees the same reduced values and stops together
+        if (round_best < global_best) {
+            global_best = round_best;
+            stale_rounds = 0;
+        } else {
+            ++stale_rounds;
+        }
+
+        if (!any_running || stale_rounds >= mpi_parameters_.global_patience) {
+            islands_->requestStop();
+            break;
+        }
+    }
+
+    worker.join();
+    if (error) {
+        std::rethrow_exception(error);
+    }
+
+    Solution local_best = islands_->getBestSolution();
+    reduceBestSolution(Migrant{local_best.getJobSequence(), local_best.getMakespan()});
+
+    LOG_INFO("Rank " + std::to_string(rank_) + " finished after " + std::to_string(sync_rounds_) +
+             " sync rounds. Global best makespan: " + std::to_string(best_makespan_));
+
+    return Solution(best_sequence_, instance_);
+}
+
+std::shared_ptr<ProblemInstance> MpiIslandHHOA::broadcastInstance(MPI_Comm comm,
+                                                                  std::shared_ptr<ProblemInstance> instance,
+                                                                  int root) {
+    int rank = 0;
+    MPI_Comm_rank(comm, &rank);
+
+    // jobs, machines, name length, objective, has setups, known lower and upper bounds
+    int header[7] = {0, 0, 0, 0, 0, -1, -1};
+    std::string name;
+    if (rank == root) {
+        if (!instance || !instance->isValid()) {
+            throw std::invalid_argument("Invalid problem instance");
+        }
+        name = instance->getInstanceName();
+        header[0] = instance->getNumJobs();
+        header[1] = instance->getNumMachines();
+        header[2] = name.size();
+        header[3] = static_cast<int>(instance->getObjective());
+        header[4] = instance->hasSetupTimes() ? 1 : 0;
+        header[5] = instance->getKnownLowerBound();
+        header[6] = instance->getKnownUpperBound();
+    }
+    MPI_Bcast(header, 7, MPI_INT, root, comm);
+
+    name.resize(header[2]);
+    MPI_Bcast(&name[0], header[2], MPI_CHAR, root, comm);
+
+    int num_jobs = header[0];
+    int num_machines = header[1];
+    std::vector<int> times(num_jobs * num_machines);
+    if (rank == root) {
+        const int* job_major = instance->getJobMajorTimes();
+        std::copy(job_major, job_major + times.size(), times.begin());
+    }
+    MPI_Bcast(times.data(), times.size(), MPI_INT, root, comm);
+
+    // Setup rows [previous job (n: initial)][next job][machine], as stored by the instance
+    std::vector<int> setups;
+    if (header[4]) {
+        setups.resize(static_cast<size_t>(num_jobs + 1) * num_jobs * num_machines);
+        if (rank == root) {
+            std::copy_n(instance->getSetupTimes(0, 0), setups.size(), setups.begin());
+        }
+        MPI_Bcast(setups.data(), setups.size(), MPI_INT, root, comm);
+    }
+
+    if (rank == root) {
+        return instance;
+    }
+
+    auto received = std::make_shared<ProblemInstance>(num_jobs, num_machines, name);
+    for (int job = 0; job < num_jobs; ++job) {
+        for (int machine = 0; machine < num_machines; ++machine) {
+            received->setProcessingTime(job, machine, times[job * num_machines + machine]);
+        }
+    }
+    for (int previous = 0; previous <= num_jobs && !setups.empty(); ++previous) {
+        const int* row = setups.data() + static_cast<size_t>(previous) * num_jobs * num_machines;
+        for (int next = 0; next < num_jobs; ++next) {
+            for (int machine = 0; machine < num_machines; ++machine) {
+                // Row n holds the initial setups
+                received->setSetupTime(machine, previous < num_jobs ? previous : -1, next,
+                                       row[next * num_machines + machine]);
+            }
+        }
+    }
+    received->setKnownBounds(header[5], header[6]);
+    received->setObjective(static_cast<ObjectiveType>(header[3]));
+    return received;
+}
+
+void MpiIslandHHOA::exchangeMigrants(const Migrant& local, bool islands_running) {
+    if (num_ranks_ < 2) {
+        return;
+    }
+
+    // Message: [makespan (-1 if none), job_0, ..., job_{n-1}]
+    int num_jobs = instance_->getNumJobs();
+    std::vector<int> outgoing(num_jobs + 1, -1);
+    std::vector<int> incoming(num_jobs + 1, -1);
+    if (!local.job_sequence.empty()) {
+        outgoing[0] = local.makespan;
+        std::copy(local.job_sequence.begin(), local.job_sequence.end(), outgoing.begin() + 1);
+    }
+
+    int next = (rank_ + 1) % num_ranks_;
+    int previous = (rank_ + num_ranks_ - 1) % num_ranks_;
+    MPI_Sendrecv(outgoing.data(), num_jobs + 1, MPI_INT, next, 0,
+                 incoming.data(), num_jobs + 1, MPI_INT, previous, 0,
+                 comm_, MPI_STATUS_IGNORE);
+
+    if (incoming[0] < 0 || !islands_running) {
+        return;
+    }
+
+    // Spread arrivals over the local islands round by round
+    Migrant migrant{std::vector<int>(incoming.begin() + 1, incoming.end()), incoming[0]};
+    int island = sync_rounds_ % islands_->getNumIslands();
+    if (islands_->postExternalMigrants(island, {migrant})) {
+        ++migrants_received_;
+    }
+}
+
+void MpiIslandHHOA::reduceBestSolution(const Migrant& local) {
+    struct {
+        int makespan;
+        int rank;
+    } local_pair = {local.makespan, rank_}, best_pair = {0, 0};
+    MPI_Allreduce(&local_pair, &best_pair, 1, MPI_2INT, MPI_MINLOC, comm_);
+
+    best_makespan_ = best_pair.makespan;
+    best_sequence_ = local.job_sequence;
+    best_sequence_.resize(instance_->getNumJobs());
+    MPI_Bcast(best_sequence_.data(), best_sequence_.size(), MPI_INT, best_pair.rank, comm_);
+}
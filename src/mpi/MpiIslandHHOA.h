@@ -0,0 +1,117 @@
+#ifndef MPI_ISLAND_HHOA_H
+#define MPI_ISLAND_HHOA_H
+
+#include "../algorithm/IslandHHOA.h"
+#include <mpi.h>
+#include <vector>
+#include <memory>
+
+/**
+ * @brief Parameters of the distributed (multi-rank) island model
+ */
+struct MpiParameters {
+    int sync_interval_ms = 200;  // Period of the global best reduction and inter-rank migration
+    int global_patience = 50;    // Sync rounds without global improvement before all ranks stop
+
+    /**
+     * @brief Print parameters
+     */
+    void print() const;
+
+    /**
+     * @brief Validate parameters
+     * @return True if valid, false otherwise
+     */
+    bool isValid() const;
+};
+
+/**
+ * @brief Island-model HHOA distributed over MPI ranks
+ *
+ * Every rank runs a local IslandHHOA on a worker thread while its main
+ * thread communicates (MPI_THREAD_FUNNELED is sufficient). Every
+ * sync_interval_ms all ranks reduce the global best makespan and pass
+ * their best permutation to the next rank of a ring, where it enters the
+ * local islands through their external mailboxes. When the global best has
+ * not improved for global_patience rounds, or every rank has finished, all
+ * islands are asked to stop and shouldTerminate() ends their runs at the
+ * next generation.
+ */
+class MpiIslandHHOA {
+private:
+    MPI_Comm comm_;
+    int rank_;
+    int num_ranks_;
+    std::shared_ptr<ProblemInstance> instance_;
+    MpiParameters mpi_parameters_;
+    std::unique_ptr<IslandHHOA> islands_;
+    std::vector<int> best_sequence_;  // Global best after optimize()
+    int best_makespan_;               // Global best after optimize()
+    int sync_rounds_;                 // Sync rounds of the last run
+    int migrants_received_;           // Migrants delivered from the previous rank
+
+public:
+    /**
+     * @brief Constructor (collective over comm)
+     * @param comm Communicator of the participating ranks
+     * @param instance Problem instance, identical on every rank
+     * @param parameters Algorithm parameters of each island
+     * @param island_parameters Island model parameters of each rank
+     * @param mpi_parameters Distributed parameters
+     */
+    MpiIslandHHOA(MPI_Comm comm,
+                  std::shared_ptr<ProblemInstance> instance,
+                  const HHOAParameters& parameters = HHOAParameters{},
+                  const IslandParameters& island_parameters = IslandParameters{},
+                  const MpiParameters& mpi_parameters = MpiParameters{});
+
+    // Getters
+    int getRank() const { return rank_; }
+    int getNumRanks() const { return num_ranks_; }
+    int getSyncRounds() const { return sync_rounds_; }
+    int getMigrantsReceived() const { return migrants_received_; }
+    const IslandHHOA& getIslands() const { return *islands_; }
+
+    /**
+     * @brief Run all ranks until global termination (collective)
+     * @return Global best solution, identical on every rank
+     */
+    Solution optimize();
+
+    /**
+     * @brief Get the global best makespan of the last run
+     * @return Best makespan
+     */
+    int getBestMakespan() const { return best_makespan_; }
+
+    /**
+     * @brief Broadcast a problem instance from the root rank (collective)
+     *
+     * The objective, the setup times and the known bounds travel with the
+     * processing times, so every rank scores sequences the same way.
+     *
+     * @param comm Communicator
+     * @param instance Instance on the root rank (ignored elsewhere)
+     * @param root Rank holding the instance
+     * @return Instance on every rank
+     */
+    static std::shared_ptr<ProblemInstance> broadcastInstance(MPI_Comm comm,
+                                                              std::shared_ptr<ProblemInstance> instance,
+                                                              int root = 0);
+
+private:
+    /**
+     * @brief Send the local best to the next rank and deliver the one from the previous rank
+     * @param local Local best migrant (empty sequence if none yet)
+     * @param islands_running False once the local islands have finished
+     */
+    void exchangeMigrants(const Migrant& local, bool islands_running);
+
+    /**
+     * @brief Reduce and broadcast the global best permutation
+     * @param local Local best migrant
+     */
+    void reduceBestSolution(const Migrant& local);
+};
+
+#endif // MPI_ISLAND_HHOA_H
@@ -0,0 +1,165 @@
+#include "mpi/MpiIslandHHOA.h"
+#include "core/ProblemInstance.h"
+#include "utils/Logger.h"
+#include "utils/Timer.h"
+#include "utils/Random.h"
+#include <mpi.h>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <memory>
+
+void printUsage(const char* program_name) {
+    std::cout << "Usage: mpirun -n <ranks> " << program_name << " [options]" << std::endl;
+    std::cout << std::endl;
+    std::cout << "Options:" << std::endl;
+    std::cout << "  -f <file>        Load problem instance from file (read on rank 0)" << std::endl;
+    std::cout << "  -j <jobs>        Number of jobs (for random instance)" << std::endl;
+    std::cout << "  -m <machines>    Number of machines (for random instance)" << std::endl;
+    std::cout << "  -p <population>  Population size per island (default: 30)" << std::endl;
+    std::cout << "  -i <iterations>  Maximum iterations per island (default: 1000)" << std::endl;
+    std::cout << "  -s <seed>        Random seed (default: time-based)" << std::endl;
+    std::cout << "  -t <threads>     Threads for the herd phases of each island (default: 1)" << std::endl;
+    std::cout << "  -I <islands>     Islands per rank (default: 1)" << std::endl;
+    std::cout << "  -P <ms>          Global sync period in milliseconds (default: 200)" << std::endl;
+    std::cout << "  -g <rounds>      Sync rounds without global improvement before stopping (default: 50)" << std::endl;
+    std::cout << "  -o <output>      Output file for the best solution (written by rank 0)" << std::endl;
+    std::cout << "  -v              Verbose output" << std::endl;
+    std::cout << "  -h              Show this help" << std::endl;
+}
+
+int main(int argc, char* argv[]) {
+    int provided = 0;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_FUNNELED, &provided);
+
+    int rank = 0;
+    int num_ranks = 1;
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+    try {
+        std::string instance_file;
+        std::string output_file;
+        int num_jobs = 20;
+        int num_machines = 5;
+        unsigned int seed = 0;
+        bool verbose = false;
+        HHOAParameters params;
+        IslandParameters island_params;
+        island_params.num_islands = 1;
+        MpiParameters mpi_params;
+
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+
+            if (arg == "-h" || arg == "--help") {
+                if (rank == 0) {
+                    printUsage(argv[0]);
+                }
+                MPI_Finalize();
+                return 0;
+            } else if (arg == "-f" && i + 1 < argc) {
+                instance_file = argv[++i];
+            } else if (arg == "-j" && i + 1 < argc) {
+                num_jobs = std::stoi(argv[++i]);
+            } else if (arg == "-m" && i + 1 < argc) {
+                num_machines = std::stoi(argv[++i]);
+            } else if (arg == "-p" && i + 1 < argc) {
+                params.population_size = std::stoi(argv[++i]);
+            } else if (arg == "-i" && i + 1 < argc) {
+                params.max_iterations = std::stoi(argv[++i]);
+            } else if (arg == "-s" && i + 1 < argc) {
+                seed = std::stoul(argv[++i]);
+            } else if (arg == "-t" && i + 1 < argc) {
+                params.num_threads = std::stoi(argv[++i]);
+            } else if (arg == "-I" && i + 1 < argc) {
+                island_params.num_islands = std::stoi(argv[++i]);
+            } else if (arg == "-P" && i + 1 < argc) {
+                mpi_params.sync_interval_ms = std::stoi(argv[++i]);
+            } else if (arg == "-g" && i + 1 < argc) {
+                mpi_params.global_patience = std::stoi(argv[++i]);
+            } else if (arg == "-o" && i + 1 < argc) {
+                output_file = argv[++i];
+            } else if (arg == "-v") {
+                verbose = true;
+            }
+        }
+
+        // Only rank 0 writes to the console and the log file
+        Logger& logger = Logger::getInstance();
+        logger.initialize(rank == 0 ? "../data/results/hhoa_mpi_log.txt" : "",
+                          verbose ? LogLevel::DEBUG : LogLevel::INFO, rank == 0);
+
+        if (seed != 0) {
+            Random::getInstance().setSeed(seed);
+        }
+
+        // Rank 0 loads or generates the instance and broadcasts it
+        std::shared_ptr<ProblemInstance> instance;
+        if (rank == 0) {
+            instance = instance_file.empty()
+                ? ProblemInstance::generateRandom(num_jobs, num_machines, 1, 100)
+                : ProblemInstance::loadFromFile(instance_file);
+            if (!instance || !instance->isValid()) {
+                std::cerr << "Error: Invalid problem instance" << std::endl;
+                MPI_Abort(MPI_COMM_WORLD, 1);
+            }
+            std::cout << "Problem Instance: " << instance->getInstanceName() << std::endl;
+            std::cout << "Jobs: " << instance->getNumJobs() << ", Machines: " << instance->getNumMachines() << std::endl;
+            std::cout << "Ranks: " << num_ranks << ", Islands per rank: " << island_params.num_islands << std::endl;
+            std::cout << std::endl;
+            if (verbose) {
+                params.print();
+                island_params.print();
+                mpi_params.print();
+                std::cout << std::endl;
+            }
+        }
+        instance = MpiIslandHHOA::broadcastInstance(MPI_COMM_WORLD, instance);
+
+        MpiIslandHHOA solver(MPI_COMM_WORLD, instance, params, island_params, mpi_params);
+
+        Timer timer;
+        timer.start();
+        Solution best_solution = solver.optimize();
+        double elapsed_ms = timer.getElapsedMs();
+
+        if (rank == 0) {
+            std::cout << std::endl;
+            std::cout << "=== OPTIMIZATION RESULTS ===" << std::endl;
+            std::cout << "Best Makespan: " << best_solution.getMakespan() << std::endl;
+            std::cout << "Execution Time: " << elapsed_ms << " ms" << std::endl;
+            std::cout << "Sync Rounds: " << solver.getSyncRounds() << std::endl;
+            std::cout << std::endl;
+            std::cout << "Best Solution:" << std::endl;
+            best_solution.print();
+            std::cout << std::endl;
+
+            if (!output_file.empty()) {
+                std::ofstream file(output_file);
+                if (file.is_open()) {
+                    file << "HHOA MPI Results for " << instance->getInstanceName() << std::endl;
+                    file << "Ranks: " << num_ranks << std::endl;
+                    file << "Best Makespan: " << best_solution.getMakespan() << std::endl;
+                    file << "Execution Time: " << elapsed_ms << " ms" << std::endl;
+                    file << "Best Solution Sequence:" << std::endl;
+                    const auto& sequence = best_solution.getJobSequence();
+                    for (size_t i = 0; i < sequence.size(); ++i) {
+                        file << "J" << (sequence[i] + 1);
+                        if (i < sequence.size() - 1) file << " -> ";
+                    }
+                    file << std::endl;
+                    std::cout << "Results saved to: " << output_file << std::endl;
+                } else {
+                    std::cerr << "Warning: Failed to save results to " << output_file << std::endl;
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Rank " << rank << " error: " << e.what() << std::endl;
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    MPI_Finalize();
+    return 0;
+}
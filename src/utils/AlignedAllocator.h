@@ -0,0 +1,56 @@
+#ifndef ALIGNED_ALLOCATOR_H
+#define ALIGNED_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include <limits>
+
+/**
+ * @brief Standard-compatible allocator returning memory aligned to a fixed boundary
+ *
+ * Used for the flat matrices read by the makespan kernels so that rows start
+ * on a cache-line (and SIMD register) boundary.
+ */
+template<typename T, std::size_t Alignment = 64>
+class AlignedAllocator {
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+
+    /**
+     * @brief Allocate aligned storage for n objects
+     * @param n Number of objects
+     * @return Pointer to the allocated storage
+     */
+    T* allocate(std::size_t n) {
+        if (n > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+    }
+
+    /**
+     * @brief Release storage obtained from allocate()
+     * @param ptr Pointer to the storage
+     */
+    void deallocate(T* ptr, std::size_t) noexcept {
+        ::operator delete(ptr, std::align_val_t(Alignment));
+    }
+
+    template<typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+
+    template<typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+#endif // ALIGNED_ALLOCATOR_H
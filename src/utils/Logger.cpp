@@ -1,90 +1,102 @@
 #include "Logger.h"
-#include <chrono>
 #include <iomanip>
 #include <ctime>
 
-std::unique_ptr<Logger> Logger::instance_ = nullptr;
-
-Logger::Logger() : min_level_(LogLevel::INFO), console_output_(true), file_output_(false) {}
+Logger::Logger()
+    : min_level_(LogLevel::INFO), console_output_(true), file_output_(false), queue_(kQueueCapacity),
+      enqueued_(0), written_(0), dropped_(0), stopping_(false) {
+    writer_ = std::thread(&Logger::writerLoop, this);
+}
 
 Logger& Logger::getInstance() {
-    if (!instance_) {
-        instance_ = std::unique_ptr<Logger>(new Logger());
-    }
-    return *instance_;
+    // Constructed on first use, thread-safe; destroyed before std::cout
+    static Logger instance;
+    return instance;
 }
 
 Logger::~Logger() {
     close();
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    wake_.notify_one();
+    writer_.join();
 }
 
 bool Logger::initialize(const std::string& filename, LogLevel min_level, bool console_output) {
-    min_level_ = min_level;
-    console_output_ = console_output;
+    setMinLevel(min_level);
+    setConsoleOutput(console_output);
     
     if (!filename.empty()) {
-        log_file_.open(filename, std::ios::out | std::ios::app);
-        if (log_file_.is_open()) {
-            file_output_ = true;
+        bool opened;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            log_file_.open(filename, std::ios::out | std::ios::app);
+            opened = log_file_.is_open();
+        }
+        if (opened) {
+            setFileOutput(true);
             log(LogLevel::INFO, "Logger initialized with file: " + filename);
             return true;
         } else {
             std::cerr << "Failed to open log file: " << filename << std::endl;
-            file_output_ = false;
+            setFileOutput(false);
             return false;
         }
     }
     
-    file_output_ = false;
+    setFileOutput(false);
     log(LogLevel::INFO, "Logger initialized (console only)");
     return true;
 }
 
-void Logger::log(LogLevel level, const std::string& message) {
-    if (level < min_level_) {
+void Logger::log(LogLevel level, std::string message) {
+    if (!isEnabled(level)) {
         return;
     }
     
-    std::string timestamp = getCurrentTimestamp();
-    std::string level_str = levelToString(level);
-    std::string formatted_message = "[" + timestamp + "] [" + level_str + "] " + message;
-    
-    if (console_output_) {
-        if (level >= LogLevel::ERROR) {
-            std::cerr << formatted_message << std::endl;
-        } else {
-            std::cout << formatted_message << std::endl;
-        }
+    if (!queue_.tryPush(Record{level, std::chrono::system_clock::now(), std::move(message)})) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
     }
+    enqueued_.fetch_add(1, std::memory_order_release);
     
-    if (file_output_ && log_file_.is_open()) {
-        log_file_ << formatted_message << std::endl;
+    // Errors are written right away rather than at the next writer wake-up
+    if (level >= LogLevel::ERROR) {
+        wake_.notify_one();
     }
 }
 
-void Logger::debug(const std::string& message) {
-    log(LogLevel::DEBUG, message);
+void Logger::debug(std::string message) {
+    log(LogLevel::DEBUG, std::move(message));
 }
 
-void Logger::info(const std::string& message) {
-    log(LogLevel::INFO, message);
+void Logger::info(std::string message) {
+    log(LogLevel::INFO, std::move(message));
 }
 
-void Logger::warning(const std::string& message) {
-    log(LogLevel::WARNING, message);
+void Logger::warning(std::string message) {
+    log(LogLevel::WARNING, std::move(message));
 }
 
-void Logger::error(const std::string& message) {
-    log(LogLevel::ERROR, message);
+void Logger::error(std::string message) {
+    log(LogLevel::ERROR, std::move(message));
 }
 
 void Logger::flush() {
-    if (console_output_) {
-        std::cout.flush();
-        std::cerr.flush();
-    }
+    long long target = enqueued_.load(std::memory_order_acquire);
+    
+    std::unique_lock<std::mutex> lock(mutex_);
+    wake_.notify_one();
+    drained_.wait(lock, [this, target] {
+        return written_.load(std::memory_order_acquire) >= target;
+    });
     
-    if (file_output_ && log_file_.is_open()) {
+    std::cout.flush();
+    std::cerr.flush();
+    if (log_file_.is_open()) {
         log_file_.flush();
     }
 }
@@ -93,17 +105,74 @@ void Logger::close() {
     if (log_file_.is_open()) {
         log(LogLevel::INFO, "Closing log file");
         flush();
+        
+        std::lock_guard<std::mutex> lock(mutex_);
         log_file_.close();
-        file_output_ = false;
+        setFileOutput(false);
+    }
+}
+
+void Logger::writerLoop() {
+    Record record;
+    long long reported_drops = 0;
+    std::unique_lock<std::mutex> lock(mutex_);
+    
+    while (true) {
+        bool wrote = false;
+        while (queue_.tryPop(record)) {
+            write(record);
+            written_.fetch_add(1, std::memory_order_release);
+            wrote = true;
+        }
+        
+        long long drops = dropped_.load(std::memory_order_relaxed);
+        if (drops > reported_drops) {
+            write(Record{LogLevel::WARNING, std::chrono::system_clock::now(),
+                         "Log buffer full, dropped " + std::to_string(drops - reported_drops) + " messages"});
+            reported_drops = drops;
+        }
+        
+        // One flush per batch instead of one per message
+        if (wrote) {
+            std::cout.flush();
+            if (log_file_.is_open()) {
+                log_file_.flush();
+            }
+        }
+        drained_.notify_all();
+        
+        // Messages pushed before the shutdown request are all written above
+        if (stopping_) {
+            break;
+        }
+        wake_.wait_for(lock, kWriteInterval);
+    }
+}
+
+void Logger::write(const Record& record) {
+    // One insertion per line: lines never interleave with other threads' output
+    std::string formatted_message = "[" + formatTimestamp(record.time) + "] [" +
+                                    levelToString(record.level) + "] " + record.message + "\n";
+    
+    if (console_output_.load(std::memory_order_relaxed)) {
+        if (record.level >= LogLevel::ERROR) {
+            std::cerr << formatted_message;
+        } else {
+            std::cout << formatted_message;
+        }
+    }
+    
+    if (file_output_.load(std::memory_order_relaxed) && log_file_.is_open()) {
+        log_file_ << formatted_message;
     }
 }
 
-std::string Logger::getCurrentTimestamp() const {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
+std::string Logger::formatTimestamp(std::chrono::system_clock::time_point time) const {
+    auto time_t = std::chrono::system_clock::to_time_t(time);
     auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) % 1000;
+        time.time_since_epoch()) % 1000;
     
+    // Only the writer thread formats timestamps, so std::localtime is safe here
     std::ostringstream oss;
     oss << std::put_time(std::localtime(&time_t), "%Y-%m-%d %H:%M:%S");
     oss << '.' << std::setfill('0') << std::setw(3) << ms.count();
@@ -1,11 +1,17 @@
 #ifndef LOGGER_H
 #define LOGGER_H
 
+#include "MpmcQueue.h"
 #include <iostream>
 #include <fstream>
 #include <string>
 #include <memory>
 #include <sstream>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <condition_variable>
 
 /**
  * @brief Logging levels
@@ -18,15 +24,41 @@ enum class LogLevel {
 };
 
 /**
- * @brief Simple logging utility class
+ * @brief Asynchronous logging utility class
+ *
+ * log() only checks the level and pushes the message into a lock-free ring
+ * buffer; a background writer thread formats the timestamps and does all
+ * console and file I/O, so logging threads never wait for the output. When
+ * the buffer is full the message is dropped and counted. flush() waits until
+ * the writer has caught up.
  */
 class Logger {
 private:
-    static std::unique_ptr<Logger> instance_;
+    /**
+     * @brief Message waiting for the writer
+     */
+    struct Record {
+        LogLevel level = LogLevel::INFO;
+        std::chrono::system_clock::time_point time;   // Time of the log() call
+        std::string message;
+    };
+
+    static constexpr size_t kQueueCapacity = 8192;                        // Buffered messages
+    static constexpr std::chrono::milliseconds kWriteInterval{20};        // Idle writer wake-up period
+
     std::ofstream log_file_;
-    LogLevel min_level_;
-    bool console_output_;
-    bool file_output_;
+    std::atomic<LogLevel> min_level_;
+    std::atomic<bool> console_output_;
+    std::atomic<bool> file_output_;
+    MpmcQueue<Record> queue_;                 // Messages not yet written
+    std::atomic<long long> enqueued_;         // Messages pushed so far
+    std::atomic<long long> written_;          // Messages written so far
+    std::atomic<long long> dropped_;          // Messages lost to a full buffer
+    std::mutex mutex_;                        // Guards the log file and the writer's waits (never taken by log())
+    std::condition_variable wake_;            // Wakes the writer early (errors, flush, shutdown)
+    std::condition_variable drained_;         // Signals progress of written_
+    bool stopping_;                           // Writer shutdown requested (guarded by mutex_)
+    std::thread writer_;                      // Background writer
 
     /**
      * @brief Private constructor for singleton pattern
@@ -41,7 +73,7 @@ public:
     static Logger& getInstance();
 
     /**
-     * @brief Destructor
+     * @brief Destructor: writes the pending messages and stops the writer
      */
     ~Logger();
 
@@ -59,53 +91,72 @@ public:
      * @brief Set minimum logging level
      * @param level Minimum level
      */
-    void setMinLevel(LogLevel level) { min_level_ = level; }
+    void setMinLevel(LogLevel level) { min_level_.store(level, std::memory_order_relaxed); }
 
     /**
      * @brief Enable/disable console output
      * @param enable Enable console output
      */
-    void setConsoleOutput(bool enable) { console_output_ = enable; }
+    void setConsoleOutput(bool enable) { console_output_.store(enable, std::memory_order_relaxed); }
 
     /**
      * @brief Enable/disable file output
      * @param enable Enable file output
      */
-    void setFileOutput(bool enable) { file_output_ = enable; }
+    void setFileOutput(bool enable) { file_output_.store(enable, std::memory_order_relaxed); }
 
     /**
-     * @brief Log a message
+     * @brief Check whether a message of a level would be written
+     *
+     * The LOG_* macros call this before building their message.
+     *
+     * @param level Log level
+     * @return True if the level passes the filter and an output is enabled
+     */
+    bool isEnabled(LogLevel level) const {
+        return level >= min_level_.load(std::memory_order_relaxed) &&
+               (console_output_.load(std::memory_order_relaxed) || file_output_.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Get the number of messages dropped because the buffer was full
+     * @return Dropped messages
+     */
+    long long getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Queue a message for the writer
      * @param level Log level
      * @param message Message to log
      */
-    void log(LogLevel level, const std::string& message);
+    void log(LogLevel level, std::string message);
 
     /**
      * @brief Log debug message
      * @param message Message to log
      */
-    void debug(const std::string& message);
+    void debug(std::string message);
 
     /**
      * @brief Log info message
      * @param message Message to log
      */
-    void info(const std::string& message);
+    void info(std::string message);
 
     /**
      * @brief Log warning message
      * @param message Message to log
      */
-    void warning(const std::string& message);
+    void warning(std::string message);
 
     /**
      * @brief Log error message
      * @param message Message to log
      */
-    void error(const std::string& message);
+    void error(std::string message);
 
     /**
-     * @brief Flush log buffers
+     * @brief Wait until the messages queued so far are written, then flush the outputs
      */
     void flush();
 
@@ -116,10 +167,22 @@ public:
 
 private:
     /**
-     * @brief Get current timestamp string
+     * @brief Writer thread: drains the buffer until shutdown
+     */
+    void writerLoop();
+
+    /**
+     * @brief Write one message to the enabled outputs (writer thread, mutex_ held)
+     * @param record Message
+     */
+    void write(const Record& record);
+
+    /**
+     * @brief Format a timestamp
+     * @param time Time point
      * @return Formatted timestamp
      */
-    std::string getCurrentTimestamp() const;
+    std::string formatTimestamp(std::chrono::system_clock::time_point time) const;
 
     /**
      * @brief Convert log level to string
@@ -129,14 +192,22 @@ private:
     std::string levelToString(LogLevel level) const;
 };
 
-// Convenience macros
-#define LOG_DEBUG(msg) Logger::getInstance().debug(msg)
-#define LOG_INFO(msg) Logger::getInstance().info(msg)
-#define LOG_WARNING(msg) Logger::getInstance().warning(msg)
-#define LOG_ERROR(msg) Logger::getInstance().error(msg)
-
-// Stream-like logging macros
-#define LOG_STREAM(level) LogStream(level)
+// Convenience macros: the message is only built when its level is enabled
+#define LOG_AT_LEVEL(level, msg) \
+    do { \
+        Logger& hhoa_logger_ = Logger::getInstance(); \
+        if (hhoa_logger_.isEnabled(level)) { \
+            hhoa_logger_.log(level, msg); \
+        } \
+    } while (0)
+#define LOG_DEBUG(msg) LOG_AT_LEVEL(LogLevel::DEBUG, msg)
+#define LOG_INFO(msg) LOG_AT_LEVEL(LogLevel::INFO, msg)
+#define LOG_WARNING(msg) LOG_AT_LEVEL(LogLevel::WARNING, msg)
+#define LOG_ERROR(msg) LOG_AT_LEVEL(LogLevel::ERROR, msg)
+
+// Stream-like logging macros (the stream is not built for disabled levels)
+#define LOG_STREAM(level) \
+    if (!Logger::getInstance().isEnabled(level)) {} else LogStream(level)
 
 /**
  * @brief Stream-like logging helper class
@@ -0,0 +1,126 @@
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+/**
+ * @brief Bounded lock-free multi-producer / multi-consumer ring buffer
+ *
+ * Dmitry Vyukov's design: every cell carries a sequence number that tells
+ * producers and consumers whether it is free or full for their lap of the
+ * ring, so each operation is one compare-and-swap on the shared position.
+ * Pushing into a full queue fails instead of blocking.
+ */
+template<typename T>
+class MpmcQueue {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;   // pos: free for the push at pos; pos + 1: full for the pop at pos
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;               // capacity cells (a power of two)
+    size_t mask_;                                 // capacity - 1
+    alignas(64) std::atomic<size_t> push_pos_;    // Next position to push
+    alignas(64) std::atomic<size_t> pop_pos_;     // Next position to pop
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Maximum number of queued elements (rounded up to a power of two, at least 2)
+     */
+    explicit MpmcQueue(size_t capacity) : mask_(0), push_pos_(0), pop_pos_(0) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Queue capacity must be positive");
+        }
+
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        cells_.reset(new Cell[size]);
+        mask_ = size - 1;
+        for (size_t i = 0; i < size; ++i) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    /**
+     * @brief Get the capacity
+     * @return Maximum number of queued elements
+     */
+    size_t capacity() const { return mask_ + 1; }
+
+    /**
+     * @brief Push an element (any thread)
+     * @param value Element to push
+     * @return False if the queue is full
+     */
+    bool tryPush(T value) {
+        size_t pos = push_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (push_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = push_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        cell->value = std::move(value);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pop an element (any thread)
+     * @param value Output element
+     * @return False if the queue is empty
+     */
+    bool tryPop(T& value) {
+        size_t pos = pop_pos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            std::intptr_t diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (pop_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = pop_pos_.load(std::memory_order_relaxed);
+            }
+        }
+
+        value = std::move(cell->value);
+        cell->sequence.store(pos + mask_ + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Check whether the queue is empty (approximate while in use)
+     * @return True if no element is queued
+     */
+    bool empty() const {
+        return pop_pos_.load(std::memory_order_acquire) == push_pos_.load(std::memory_order_acquire);
+    }
+};
+
+#endif // MPMC_QUEUE_H
@@ -0,0 +1,37 @@
+#include "Profiler.h"
+#include <fstream>
+#include <iomanip>
+
+bool Profiler::saveChromeTrace(const std::string& filename, const std::vector<TraceEvent>& events,
+                               const std::string& process_name) {
+    std::ofstream file(filename);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    // Timestamps and durations are in microseconds
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [\n";
+    file << "  {\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 1, \"args\": {\"name\": \"";
+    for (char c : process_name) {
+        if (c == '"' || c == '\\') {
+            file << '\\';
+        }
+        file << c;
+    }
+    file << "\"}}";
+
+    for (const auto& event : events) {
+        file << ",\n  {\"name\": \"" << event.name << "\", \"cat\": \"phase\", \"ph\": \"X\""
+             << ", \"ts\": " << event.start_ns / 1000.0
+             << ", \"dur\": " << event.duration_ns / 1000.0
+             << ", \"pid\": 1, \"tid\": 1"
+             << ", \"args\": {\"iteration\": " << event.iteration
+             << ", \"evaluations\": " << event.evaluations
+             << ", \"attempts\": " << event.attempts
+             << ", \"accepted\": " << event.accepted << "}}";
+    }
+    file << "\n]}\n";
+
+    return static_cast<bool>(file);
+}
@@ -0,0 +1,101 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include "SearchBudget.h"
+#include <string>
+#include <vector>
+
+/**
+ * @brief Hot-path instrumentation switched on at compile time
+ *
+ * Built with HHOA_ENABLE_PROFILING (CMake option of the same name), the
+ * makespan kernels count their evaluations in a per-thread counter and HHOA
+ * times each phase of an iteration. Without it, HHOA_COUNT_EVALUATIONS only
+ * charges the thread's search budget (if any) and the phases run unmeasured.
+ */
+#ifdef HHOA_ENABLE_PROFILING
+#define HHOA_COUNT_EVALUATIONS(count) (Profiler::countEvaluations(count), SearchBudget::charge(count))
+#else
+#define HHOA_COUNT_EVALUATIONS(count) SearchBudget::charge(count)
+#endif
+
+/**
+ * @brief Cumulative cost of one algorithm phase
+ */
+struct PhaseProfile {
+    long long calls = 0;          // Executions of the phase
+    long long nanoseconds = 0;    // Total wall-clock time
+    long long evaluations = 0;    // Makespan evaluations (a Taillard sweep counts one per position)
+    long long attempts = 0;       // Candidates tried
+    long long accepted = 0;       // Candidates accepted
+
+    /**
+     * @brief Fraction of the tried candidates that were accepted
+     * @return Accept rate in [0, 1] (0 if nothing was tried)
+     */
+    double getAcceptRate() const { return attempts > 0 ? static_cast<double>(accepted) / attempts : 0.0; }
+};
+
+/**
+ * @brief One phase execution, as a Chrome-trace complete event
+ */
+struct TraceEvent {
+    const char* name;          // Phase name (static string)
+    int iteration;             // Iteration of the execution
+    long long start_ns;        // Start, relative to the start of the run
+    long long duration_ns;     // Wall-clock duration
+    long long evaluations;     // Makespan evaluations
+    long long attempts;        // Candidates tried
+    long long accepted;        // Candidates accepted
+};
+
+/**
+ * @brief Per-thread evaluation counter and trace export
+ */
+class Profiler {
+private:
+    static inline thread_local long long evaluations_ = 0;  // Evaluations run by this thread
+
+public:
+    /**
+     * @brief Whether the instrumentation is compiled in
+     * @return True when built with HHOA_ENABLE_PROFILING
+     */
+    static constexpr bool isEnabled() {
+#ifdef HHOA_ENABLE_PROFILING
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * @brief Add evaluations to the calling thread's counter (use HHOA_COUNT_EVALUATIONS)
+     * @param count Number of makespans computed
+     */
+    static void countEvaluations(long long count) { evaluations_ += count; }
+
+    /**
+     * @brief Evaluations run by the calling thread so far
+     *
+     * The counter is never reset; callers measure differences.
+     *
+     * @return Evaluation count
+     */
+    static long long getThreadEvaluations() { return evaluations_; }
+
+    /**
+     * @brief Write events in the Chrome trace event format
+     *
+     * The file opens in chrome://tracing and in the Perfetto UI.
+     *
+     * @param filename Output file
+     * @param events Events to write
+     * @param process_name Name shown for the trace's process
+     * @return True if successful
+     */
+    static bool saveChromeTrace(const std::string& filename, const std::vector<TraceEvent>& events,
+                                const std::string& process_name = "HHOA");
+};
+
+#endif // PROFILER_H
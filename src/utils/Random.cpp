@@ -3,21 +3,31 @@
 #include <stdexcept>
 
 Random Random::instance_;
+thread_local Random* Random::bound_ = nullptr;
 
 Random::Random() {
     // Initialize with current time as seed
     auto now = std::chrono::high_resolution_clock::now();
     auto duration = now.time_since_epoch();
     auto seed = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
-    generator_.seed(static_cast<unsigned int>(seed));
+    generator_.seed_state(static_cast<std::uint64_t>(seed));
 }
 
+Random::Random(std::uint64_t seed) : generator_(seed) {}
+
+Random::Random(std::uint64_t seed, std::uint64_t stream)
+    : generator_(seed ^ (stream * 0xd1342543de82ef95ULL + 0x2545f4914f6cdd1dULL)) {}
+
 Random& Random::getInstance() {
-    return instance_;
+    return bound_ ? *bound_ : instance_;
+}
+
+std::uint64_t Random::nextSeed() {
+    return generator_();
 }
 
 void Random::setSeed(unsigned int seed) {
-    generator_.seed(seed);
+    generator_.seed_state(seed);
 }
 
 int Random::randInt(int min, int max) {
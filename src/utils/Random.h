@@ -5,17 +5,104 @@
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
+#include <cstdint>
+
+/**
+ * @brief xoshiro256++ pseudo-random generator (Blackman & Vigna)
+ *
+ * 256 bits of state, cheap to seed and to copy, with a jump function that
+ * advances the state by 2^128 steps to create non-overlapping streams.
+ * Satisfies the UniformRandomBitGenerator requirements.
+ */
+class Xoshiro256pp {
+public:
+    using result_type = std::uint64_t;
+
+private:
+    std::uint64_t state_[4];
+
+    static std::uint64_t rotl(std::uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    explicit Xoshiro256pp(std::uint64_t seed = 0) { seed_state(seed); }
+
+    /**
+     * @brief Seed the state by expanding a 64-bit value with splitmix64
+     * @param seed Seed value
+     */
+    void seed_state(std::uint64_t seed) {
+        for (auto& word : state_) {
+            seed += 0x9e3779b97f4a7c15ULL;
+            std::uint64_t z = seed;
+            z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+            z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+            word = z ^ (z >> 31);
+        }
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return UINT64_MAX; }
+
+    result_type operator()() {
+        const std::uint64_t result = rotl(state_[0] + state_[3], 23) + state_[0];
+        const std::uint64_t t = state_[1] << 17;
+        state_[2] ^= state_[0];
+        state_[3] ^= state_[1];
+        state_[1] ^= state_[2];
+        state_[0] ^= state_[3];
+        state_[2] ^= t;
+        state_[3] = rotl(state_[3], 45);
+        return result;
+    }
+
+    /**
+     * @brief Advance the state by 2^128 steps
+     */
+    void jump() {
+        static const std::uint64_t kJump[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                              0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+        std::uint64_t s[4] = {0, 0, 0, 0};
+        for (std::uint64_t mask : kJump) {
+            for (int b = 0; b < 64; ++b) {
+                if (mask & (std::uint64_t(1) << b)) {
+                    for (int w = 0; w < 4; ++w) s[w] ^= state_[w];
+                }
+                (*this)();
+            }
+        }
+        for (int w = 0; w < 4; ++w) state_[w] = s[w];
+    }
+
+    /**
+     * @brief Access the raw state (for checkpointing)
+     * @return Pointer to the four state words
+     */
+    const std::uint64_t* state() const { return state_; }
+
+    /**
+     * @brief Restore a raw state (for checkpointing)
+     * @param state Four state words
+     */
+    void setState(const std::uint64_t* state) { std::copy(state, state + 4, state_); }
+};
 
 /**
  * @brief Singleton class for random number generation
  * 
  * This class provides various random number generation utilities
- * using the Mersenne Twister algorithm.
+ * using the xoshiro256++ generator.
+ *
+ * Besides the global instance, independent generators can be created per
+ * worker or per horse, either as counter-based streams (seed, stream id) or
+ * by jumping ahead. A thread redirects getInstance() to its own generator
+ * with Random::Binding, so parallel code keeps using the singleton API
+ * without sharing one generator across threads.
  */
 class Random {
 private:
-    std::mt19937 generator_;
+    Xoshiro256pp generator_;
     static Random instance_;
+    static thread_local Random* bound_;   // Generator bound to the current thread, if any
 
     /**
      * @brief Private constructor for singleton pattern
@@ -24,11 +111,62 @@ private:
 
 public:
     /**
-     * @brief Get the singleton instance
-     * @return Reference to the Random instance
+     * @brief Constructor for an independent, seeded generator
+     * @param seed Seed value
+     */
+    explicit Random(std::uint64_t seed);
+
+    /**
+     * @brief Constructor for stream number `stream` of a seed
+     *
+     * Streams of the same seed are statistically independent, and stream k
+     * does not depend on how many other streams exist or who draws from them.
+     *
+     * @param seed Seed value
+     * @param stream Stream identifier (e.g. horse or worker index)
+     */
+    Random(std::uint64_t seed, std::uint64_t stream);
+
+    /**
+     * @brief Get the generator of the current thread
+     * @return Bound generator if one is set, otherwise the global instance
      */
     static Random& getInstance();
 
+    /**
+     * @brief RAII binding of a generator to the current thread
+     *
+     * While alive, Random::getInstance() on this thread returns the bound
+     * generator. Bindings nest; the previous one is restored on destruction.
+     */
+    class Binding {
+    private:
+        Random* previous_;
+
+    public:
+        explicit Binding(Random& generator) : previous_(bound_) { bound_ = &generator; }
+        ~Binding() { bound_ = previous_; }
+        Binding(const Binding&) = delete;
+        Binding& operator=(const Binding&) = delete;
+    };
+
+    /**
+     * @brief Draw a seed for independent generators or streams
+     * @return Seed value
+     */
+    std::uint64_t nextSeed();
+
+    /**
+     * @brief Advance this generator by 2^128 draws
+     */
+    void jump() { generator_.jump(); }
+
+    /**
+     * @brief Access the underlying engine (for checkpointing)
+     * @return Reference to the engine
+     */
+    Xoshiro256pp& getEngine() { return generator_; }
+
     /**
      * @brief Set the random seed
      * @param seed Seed value for the random number generator
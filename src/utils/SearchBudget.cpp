@@ -0,0 +1,36 @@
+#include "SearchBudget.h"
+
+SearchBudget::SearchBudget()
+    : has_deadline_(false), max_evaluations_(0), evaluations_(0), exhausted_(false) {
+}
+
+void SearchBudget::start(double time_limit_ms, long long max_evaluations) {
+    has_deadline_ = time_limit_ms > 0.0;
+    deadline_ = Clock::now() + std::chrono::duration_cast<Clock::duration>(
+        std::chrono::duration<double, std::milli>(time_limit_ms > 0.0 ? time_limit_ms : 0.0));
+    max_evaluations_ = max_evaluations > 0 ? max_evaluations : 0;
+    evaluations_.store(0, std::memory_order_relaxed);
+    exhausted_.store(false, std::memory_order_relaxed);
+}
+
+bool SearchBudget::isExhausted() const {
+    if (exhausted_.load(std::memory_order_relaxed)) {
+        return true;
+    }
+
+    bool exhausted = (max_evaluations_ > 0 && evaluations_.load(std::memory_order_relaxed) >= max_evaluations_) ||
+                     (has_deadline_ && Clock::now() >= deadline_);
+    if (exhausted) {
+        exhausted_.store(true, std::memory_order_relaxed);
+    }
+    return exhausted;
+}
+
+void SearchBudget::publish() {
+    SearchBudget* budget = bound_;
+    if (budget && pending_ > 0) {
+        budget->evaluations_.fetch_add(pending_, std::memory_order_relaxed);
+        budget->isExhausted();
+    }
+    pending_ = 0;
+}
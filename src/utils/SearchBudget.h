@@ -0,0 +1,137 @@
+#ifndef SEARCH_BUDGET_H
+#define SEARCH_BUDGET_H
+
+#include <atomic>
+#include <chrono>
+
+/**
+ * @brief Wall-clock and evaluation budget of a run, shared by its threads
+ *
+ * A thread works against the budget bound to it with SearchBudget::Binding.
+ * Every makespan evaluation is charged through HHOA_COUNT_EVALUATIONS into a
+ * per-thread tally that is published, together with a clock check, every
+ * kCheckInterval evaluations. Once either limit is hit the budget latches
+ * exhausted, and the local searches poll isCurrentExhausted() (one relaxed
+ * load) to abandon their sweeps.
+ */
+class SearchBudget {
+public:
+    static constexpr long long kCheckInterval = 64;  // Evaluations between two publications
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    Clock::time_point deadline_;              // End of the wall-clock budget
+    bool has_deadline_;                       // Whether a time limit is set
+    long long max_evaluations_;               // Evaluation limit (0: unlimited)
+    std::atomic<long long> evaluations_;      // Published evaluations since start
+    mutable std::atomic<bool> exhausted_;     // Latched once a limit is hit
+
+    static inline thread_local SearchBudget* bound_ = nullptr;  // Budget of this thread
+    static inline thread_local long long pending_ = 0;          // Evaluations not published yet
+
+public:
+    /**
+     * @brief Constructor (unlimited until start is called)
+     */
+    SearchBudget();
+
+    SearchBudget(const SearchBudget&) = delete;
+    SearchBudget& operator=(const SearchBudget&) = delete;
+
+    /**
+     * @brief Start a new budget now
+     * @param time_limit_ms Wall-clock limit in milliseconds (0: unlimited)
+     * @param max_evaluations Makespan evaluation limit (0: unlimited)
+     */
+    void start(double time_limit_ms, long long max_evaluations);
+
+    /**
+     * @brief Whether any limit is set
+     * @return True if the budget can run out
+     */
+    bool isLimited() const { return has_deadline_ || max_evaluations_ > 0; }
+
+    /**
+     * @brief Check both limits now (reads the clock)
+     * @return True if the budget is exhausted
+     */
+    bool isExhausted() const;
+
+    /**
+     * @brief Exhaust the budget now (any thread), e.g. to cancel a run mid-phase
+     */
+    void cancel() { exhausted_.store(true, std::memory_order_relaxed); }
+
+    /**
+     * @brief Whether an earlier check found the budget exhausted (no clock read)
+     * @return True once a limit has been hit
+     */
+    bool wasExhausted() const { return exhausted_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Evaluations published so far
+     * @return Evaluation count (lags each thread by less than kCheckInterval)
+     */
+    long long getEvaluations() const { return evaluations_.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Charge evaluations to the calling thread's budget (use HHOA_COUNT_EVALUATIONS)
+     * @param count Number of makespans computed
+     */
+    static void charge(long long count) {
+        SearchBudget* budget = bound_;
+        if (budget) {
+            pending_ += count;
+            if (pending_ >= kCheckInterval) {
+                publish();
+            }
+        }
+    }
+
+    /**
+     * @brief Whether the calling thread's budget has run out (cheap; no clock read)
+     * @return True if a budget is bound and latched exhausted
+     */
+    static bool isCurrentExhausted() {
+        SearchBudget* budget = bound_;
+        return budget && budget->exhausted_.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Budget bound to the calling thread
+     * @return Bound budget (null if none)
+     */
+    static SearchBudget* current() { return bound_; }
+
+    /**
+     * @brief RAII binding of a budget to the current thread
+     *
+     * Bindings nest; the previous one is restored on destruction. A null
+     * budget unbinds for the binding's lifetime.
+     */
+    class Binding {
+    private:
+        SearchBudget* previous_;
+
+    public:
+        explicit Binding(SearchBudget* budget) : previous_(bound_) {
+            publish();
+            bound_ = budget;
+        }
+        ~Binding() {
+            publish();
+            bound_ = previous_;
+        }
+        Binding(const Binding&) = delete;
+        Binding& operator=(const Binding&) = delete;
+    };
+
+private:
+    /**
+     * @brief Move this thread's pending evaluations into its budget and check the limits
+     */
+    static void publish();
+};
+
+#endif // SEARCH_BUDGET_H
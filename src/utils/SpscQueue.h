@@ -0,0 +1,76 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <vector>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+
+/**
+ * @brief Bounded lock-free single-producer / single-consumer queue
+ *
+ * One thread may push and one (other) thread may pop concurrently without
+ * locks. Pushing into a full queue fails instead of blocking.
+ */
+template<typename T>
+class SpscQueue {
+private:
+    std::vector<T> slots_;                    // capacity + 1 slots, one always empty
+    alignas(64) std::atomic<size_t> head_;    // Next slot to pop (owned by the consumer)
+    alignas(64) std::atomic<size_t> tail_;    // Next slot to push (owned by the producer)
+
+public:
+    /**
+     * @brief Constructor
+     * @param capacity Maximum number of queued elements
+     */
+    explicit SpscQueue(size_t capacity) : slots_(capacity + 1), head_(0), tail_(0) {
+        if (capacity == 0) {
+            throw std::invalid_argument("Queue capacity must be positive");
+        }
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * @brief Push an element (producer thread only)
+     * @param value Element to push
+     * @return False if the queue is full
+     */
+    bool tryPush(T value) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t next = (tail + 1) % slots_.size();
+        if (next == head_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        slots_[tail] = std::move(value);
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Pop an element (consumer thread only)
+     * @param value Output element
+     * @return False if the queue is empty
+     */
+    bool tryPop(T& value) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) {
+            return false;
+        }
+        value = std::move(slots_[head]);
+        head_.store((head + 1) % slots_.size(), std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Check whether the queue is empty (approximate while in use)
+     * @return True if no element is queued
+     */
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+};
+
+#endif // SPSC_QUEUE_H
@@ -0,0 +1,109 @@
+#include "ThreadPool.h"
+#include <stdexcept>
+
+thread_local bool ThreadPool::in_parallel_region_ = false;
+
+ThreadPool::ThreadPool(int num_threads)
+    : task_(nullptr), task_count_(0), next_index_(0), busy_workers_(0),
+      generation_(0), stopping_(false) {
+    if (num_threads < 1) {
+        throw std::invalid_argument("Thread pool needs at least one thread");
+    }
+    
+    workers_.reserve(num_threads - 1);
+    for (int i = 1; i < num_threads; ++i) {
+        workers_.emplace_back(&ThreadPool::workerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    work_available_.notify_all();
+    
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int)>& task) {
+    if (count <= 0) {
+        return;
+    }
+    
+    // Nothing to share, or already inside a loop: run inline
+    if (workers_.empty() || count == 1 || in_parallel_region_) {
+        for (int i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = &task;
+        task_count_ = count;
+        next_index_.store(0);
+        busy_workers_ = workers_.size();
+        error_ = nullptr;
+        generation_++;
+    }
+    work_available_.notify_all();
+    
+    runTasks();
+    
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        work_done_.wait(lock, [this] { return busy_workers_ == 0; });
+        task_ = nullptr;
+        error = error_;
+    }
+    
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void ThreadPool::workerLoop() {
+    unsigned long seen_generation = 0;
+    
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            work_available_.wait(lock, [&] { return stopping_ || generation_ != seen_generation; });
+            if (stopping_) {
+                return;
+            }
+            seen_generation = generation_;
+        }
+        
+        runTasks();
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            busy_workers_--;
+        }
+        work_done_.notify_one();
+    }
+}
+
+void ThreadPool::runTasks() {
+    in_parallel_region_ = true;
+    
+    int index;
+    while ((index = next_index_.fetch_add(1)) < task_count_) {
+        try {
+            (*task_)(index);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (!error_) {
+                error_ = std::current_exception();
+            }
+        }
+    }
+    
+    in_parallel_region_ = false;
+}
@@ -0,0 +1,86 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+/**
+ * @brief Fixed-size pool of worker threads for data-parallel loops
+ *
+ * The calling thread takes part in every loop, so a pool of N threads starts
+ * N-1 workers. Loops issued from inside a running loop execute inline on the
+ * calling thread instead of deadlocking on the pool.
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable work_available_;
+    std::condition_variable work_done_;
+
+    const std::function<void(int)>* task_;   // Loop body of the current parallel loop
+    int task_count_;                          // Number of iterations of the current loop
+    std::atomic<int> next_index_;             // Next iteration to hand out
+    int busy_workers_;                        // Workers still running the current loop
+    unsigned long generation_;                // Incremented for every new loop
+    bool stopping_;                           // Set when the pool shuts down
+    std::exception_ptr error_;                // First exception thrown by a loop body
+
+    static thread_local bool in_parallel_region_;
+
+public:
+    /**
+     * @brief Constructor
+     * @param num_threads Total number of threads, including the caller (at least 1)
+     */
+    explicit ThreadPool(int num_threads);
+
+    /**
+     * @brief Destructor (joins all workers)
+     */
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Get the number of threads taking part in a loop
+     * @return Number of threads, including the caller
+     */
+    int getNumThreads() const { return static_cast<int>(workers_.size()) + 1; }
+
+    /**
+     * @brief Run task(i) for every i in [0, count) and wait for completion
+     *
+     * Iterations are handed out dynamically; the first exception thrown by
+     * a task is rethrown on the calling thread once all threads have stopped.
+     *
+     * @param count Number of iterations
+     * @param task Loop body
+     */
+    void parallelFor(int count, const std::function<void(int)>& task);
+
+    /**
+     * @brief Check whether the current thread is executing a parallel loop
+     * @return True inside a loop body
+     */
+    static bool inParallelRegion() { return in_parallel_region_; }
+
+private:
+    /**
+     * @brief Worker thread main loop
+     */
+    void workerLoop();
+
+    /**
+     * @brief Execute iterations of the current loop until none are left
+     */
+    void runTasks();
+};
+
+#endif // THREAD_POOL_H
@@ -39,6 +39,12 @@ long long Timer::getElapsedMicroseconds() const {
     return duration.count();
 }
 
+long long Timer::getElapsedNanoseconds() const {
+    auto end = is_running_ ? std::chrono::high_resolution_clock::now() : end_time_;
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_time_);
+    return duration.count();
+}
+
 void Timer::printElapsed() const {
     std::cout << name_ << ": " << getFormattedTime() << std::endl;
 }
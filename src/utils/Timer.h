@@ -54,6 +54,12 @@ public:
      */
     long long getElapsedMicroseconds() const;
 
+    /**
+     * @brief Get elapsed time in nanoseconds
+     * @return Elapsed time in nanoseconds
+     */
+    long long getElapsedNanoseconds() const;
+
     /**
      * @brief Check if timer is running
      * @return True if running, false otherwise
@@ -1,9 +1,34 @@
 #include "../src/core/ProblemInstance.h"
 #include "../src/core/Solution.h"
+#include "../src/core/InsertionEvaluator.h"
+#include "../src/core/MakespanEvaluator.h"
+#include "../src/core/EvaluationCache.h"
+#include "../src/core/MakespanKernels.h"
+#include "../src/core/Objective.h"
 #include "../src/algorithm/HHOA.h"
+#include "../src/algorithm/PopulationArena.h"
+#include "../src/algorithm/IslandHHOA.h"
+#include "../src/algorithm/BatchRunner.h"
+#include "../src/algorithm/Checkpoint.h"
+#include "../src/algorithm/SolverService.h"
 #include "../src/utils/Random.h"
+#include "../src/utils/ThreadPool.h"
+#include "../src/utils/Profiler.h"
+#include "../src/utils/Logger.h"
+#include "../src/utils/MpmcQueue.h"
+#include "../src/utils/SearchBudget.h"
 #include <iostream>
 #include <cassert>
+#include <cstdint>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <thread>
+#include <chrono>
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
 
 void testProblemInstance() {
     std::cout << "Testing ProblemInstance..." << std::endl;
@@ -20,9 +45,86 @@ void testProblemInstance() {
         for (int m = 0; m < 3; ++m) {
             int time = instance->getProcessingTime(j, m);
             assert(time >= 1 && time <= 10);
+            assert(instance->getJobTimes(j)[m] == time);
+            assert(instance->getMachineTimes(m)[j] == time);
         }
     }
     
+    // Flat storage is cache-line aligned
+    assert(reinterpret_cast<uintptr_t>(instance->getJobMajorTimes()) % 64 == 0);
+    
+    // Binary round trip: matrices mapped in place, name, bounds and checksum kept
+    std::filesystem::path directory = std::filesystem::temp_directory_path();
+    std::string text_file = (directory / "hhoa_instance_test.txt").string();
+    std::string binary_file = (directory / "hhoa_instance_test.bin").string();
+    instance->setKnownBounds(20, 35);
+    assert(instance->saveToFile(text_file));
+    assert(instance->saveToFile(binary_file, InstanceFormat::BINARY));
+    assert(!ProblemInstance::isBinaryFile(text_file));
+    assert(ProblemInstance::isBinaryFile(binary_file));
+    
+    auto mapped = ProblemInstance::loadFromFile(binary_file);
+    assert(mapped && mapped->isMapped() && mapped->isValid());
+    assert(mapped->getInstanceName() == instance->getInstanceName());
+    assert(mapped->getKnownLowerBound() == 20 && mapped->getKnownUpperBound() == 35);
+    assert(mapped->getChecksum() == instance->getChecksum());
+    assert(mapped->getProcessingTimes() == instance->getProcessingTimes());
+    assert(reinterpret_cast<uintptr_t>(mapped->getJobMajorTimes()) % 64 == 0);
+    assert(reinterpret_cast<uintptr_t>(mapped->getMachineMajorTimes()) % 64 == 0);
+    for (int m = 0; m < 3; ++m) {
+        assert(mapped->getMachineTimes(m)[4] == instance->getProcessingTime(4, m));
+    }
+    
+    // Copies share the mapping; modifications copy it into owned storage first
+    ProblemInstance copy(*mapped);
+    assert(copy.isMapped() && copy.getJobMajorTimes() == mapped->getJobMajorTimes());
+    copy.setProcessingTime(0, 0, 99);
+    assert(!copy.isMapped() && copy.getProcessingTime(0, 0) == 99 && copy.getMachineTimes(0)[0] == 99);
+    assert(mapped->getProcessingTime(0, 0) == instance->getProcessingTime(0, 0));
+    
+    auto text = ProblemInstance::loadFromFile(text_file);
+    assert(text && !text->isMapped() && text->getChecksum() == instance->getChecksum());
+    assert(ProblemInstance::convertToBinary(text_file, binary_file));
+    assert(ProblemInstance::loadFromFile(binary_file)->getProcessingTimes() == instance->getProcessingTimes());
+    
+    // A corrupted matrix fails the checksum
+    {
+        std::fstream corrupt(binary_file, std::ios::in | std::ios::out | std::ios::binary);
+        corrupt.seekp(-1, std::ios::end);
+        corrupt.put(0x7f);
+    }
+    assert(ProblemInstance::loadFromFile(binary_file) == nullptr);
+    
+    // Times and matrix sizes beyond the int range are rejected, not wrapped
+    for (const char* content : {"2 1\n5\n2147483648\n", "65536 65536\n", "3000000000 1\n"}) {
+        std::ofstream(text_file) << content;
+        assert(ProblemInstance::loadFromFile(text_file) == nullptr);
+    }
+    std::ofstream(text_file) << "2 1\n5\n2147483647\n";
+    assert(ProblemInstance::loadFromFile(text_file)->getProcessingTime(1, 0) == INT_MAX);
+    std::filesystem::remove(text_file);
+    std::filesystem::remove(binary_file);
+    
+    // Lower bounds: job 0 needs 11 + min(4, 1) for job 1 (machine-based: 1 + 9 + 1)
+    ProblemInstance bounded({{1, 8, 2}, {4, 1, 1}});
+    assert(bounded.getLowerBound() == 12);
+    bounded.setProcessingTime(1, 1, 20);
+    assert(bounded.getLowerBound() == 1 + 28 + 1);
+    bounded.setKnownBounds(40, -1);
+    assert(bounded.getLowerBound() == 40);
+    
+    // The bound never exceeds the optimum (all permutations of 6 jobs)
+    for (int trial = 0; trial < 5; ++trial) {
+        auto small = ProblemInstance::generateRandom(6, 4, 1, 30);
+        std::vector<int> permutation(6);
+        std::iota(permutation.begin(), permutation.end(), 0);
+        int optimum = std::numeric_limits<int>::max();
+        do {
+            optimum = std::min(optimum, Solution(permutation, small).getMakespan());
+        } while (std::next_permutation(permutation.begin(), permutation.end()));
+        assert(small->getLowerBound() > 0 && small->getLowerBound() <= optimum);
+    }
+    
     std::cout << "ProblemInstance tests passed!" << std::endl;
 }
 
@@ -44,9 +146,530 @@ void testSolution() {
     solution.swapJobs(0, 1);
     assert(solution.isValid());
     
+    // Incremental recomputation must match a fresh evaluation
+    solution.getMakespan();
+    solution.swapJobs(2, 3);
+    assert(solution.getMakespan() == Solution(solution.getJobSequence(), instance).getMakespan());
+    solution.setJobSequence({3, 2, 1, 0});
+    assert(solution.getMakespan() == Solution(solution.getJobSequence(), instance).getMakespan());
+    
+    // Flat completion-time matrix agrees with the rolling-row makespan
+    const auto& completion_times = solution.getCompletionTimes();
+    assert(completion_times.size() == 4u * 3u);
+    assert(completion_times.back() == solution.getMakespan());
+    Solution copy(solution);
+    copy.swapJobs(0, 3);
+    assert(copy.getMakespan() == Solution(copy.getJobSequence(), instance).getMakespan());
+    
+    // In-place moves keep the sequence a permutation and the cache consistent
+    solution.moveJob(0, 3);
+    assert((solution.getJobSequence() == std::vector<int>{2, 1, 0, 3}));
+    assert(solution.getMakespan() == Solution(solution.getJobSequence(), instance).getMakespan());
+    solution.moveJob(3, 1);
+    assert((solution.getJobSequence() == std::vector<int>{2, 3, 1, 0}));
+    for (int i = 0; i < 10; ++i) {
+        solution.applyRandomSwap();
+        solution.applyRandomInsertion();
+        assert(solution.isValid());
+        assert(solution.getMakespan() == Solution(solution.getJobSequence(), instance).getMakespan());
+    }
+    
+    // Incrementally updated fingerprints match a fresh computation
+    std::uint64_t hash = solution.getHash();
+    solution.swapJobs(0, 2);
+    solution.moveJob(3, 0);
+    solution.setJobAt(1, solution.getJobAt(1));
+    assert(solution.getHash() == Solution(solution.getJobSequence(), instance).getHash());
+    solution.moveJob(0, 3);
+    solution.swapJobs(0, 2);
+    assert(solution.getHash() == hash);
+    
+    // Delta-evaluated swaps and moves agree with applying them
+    auto larger = ProblemInstance::generateRandom(12, 5, 1, 100);
+    Solution probe(larger);
+    probe.initializeRandom();
+    for (int i = 0; i < 12; ++i) {
+        for (int j = 0; j < 12; ++j) {
+            Solution swapped(probe);
+            swapped.swapJobs(i, j);
+            assert(probe.evaluateSwap(i, j) == Solution(swapped.getJobSequence(), larger).getMakespan());
+            Solution shifted(probe);
+            shifted.moveJob(i, j);
+            int shifted_makespan = Solution(shifted.getJobSequence(), larger).getMakespan();
+            assert(probe.evaluateMove(i, j) == shifted_makespan);
+            // Abandoned evaluations still report a value at or above the bound
+            assert(probe.evaluateMove(i, j, shifted_makespan) >= shifted_makespan);
+            assert(probe.evaluateMove(i, j, shifted_makespan + 1) == shifted_makespan);
+        }
+        probe.moveJob(i, (i * 7) % 12);
+    }
+    int searched_makespan = probe.getMakespan();
+    probe.apply2Opt();
+    assert(probe.getMakespan() <= searched_makespan);
+    assert(probe.getMakespan() == Solution(probe.getJobSequence(), larger).getMakespan());
+    
+    // Moves carry the sequence and the cached makespan over
+    int moved_makespan = solution.getMakespan();
+    std::vector<int> moved_sequence = solution.getJobSequence();
+    Solution moved(std::move(solution));
+    assert(moved.getJobSequence() == moved_sequence);
+    assert(moved.getMakespan() == moved_makespan);
+    copy = std::move(moved);
+    assert(copy.getJobSequence() == moved_sequence);
+    assert(copy.getMakespan() == moved_makespan);
+    
     std::cout << "Solution tests passed!" << std::endl;
 }
 
+void testInsertionEvaluator() {
+    std::cout << "Testing InsertionEvaluator..." << std::endl;
+    
+    auto instance = ProblemInstance::generateRandom(12, 5, 1, 50);
+    Solution solution(instance);
+    solution.initializeRandom();
+    
+    InsertionEvaluator evaluator(instance);
+    std::vector<int> makespans;
+    const auto& sequence = solution.getJobSequence();
+    
+    // Accelerated makespans must match a full re-evaluation of every move
+    for (int i = 0; i < solution.getNumJobs(); ++i) {
+        evaluator.evaluateReinsertions(sequence, i, makespans);
+        assert(makespans.size() == sequence.size());
+        
+        for (int k = 0; k < static_cast<int>(makespans.size()); ++k) {
+            std::vector<int> moved = sequence;
+            int job = moved[i];
+            moved.erase(moved.begin() + i);
+            moved.insert(moved.begin() + k, job);
+            assert(makespans[k] == Solution(moved, instance).getMakespan());
+        }
+    }
+    
+    int before = solution.getMakespan();
+    solution.applyInsertionSearch();
+    assert(solution.isValid());
+    assert(solution.getMakespan() <= before);
+    assert(solution.getMakespan() == Solution(solution.getJobSequence(), instance).getMakespan());
+    
+    // Specialized kernels agree with the generic runtime-m ones
+    for (int num_machines : {5, 7, 10, 20}) {
+        auto sized = ProblemInstance::generateRandom(15, num_machines, 1, 100);
+        const MakespanKernels& kernels = MakespanKernels::select(num_machines);
+        assert(kernels.num_machines == ((num_machines == 7) ? 0 : num_machines));
+        
+        Solution random_solution(sized);
+        random_solution.initializeRandom();
+        const std::vector<int>& order = random_solution.getJobSequence();
+        int generic_makespan = MakespanKernels::generic().makespan(*sized, order.data(), order.size());
+        assert(kernels.makespan(*sized, order.data(), order.size()) == generic_makespan);
+        assert(random_solution.getMakespan() == generic_makespan);
+        
+        InsertionEvaluator sized_evaluator(sized);
+        std::vector<int> reinsertions;
+        sized_evaluator.evaluateReinsertions(order, 4, reinsertions);
+        Solution moved_solution(random_solution);
+        moved_solution.moveJob(4, 9);
+        assert(reinsertions[9] == moved_solution.getMakespan());
+    }
+    
+    // Accelerated NEH builds the same permutation as NEH with full evaluations
+    auto neh_instance = ProblemInstance::generateRandom(20, 6, 1, 99);
+    std::vector<int> order(neh_instance->getNumJobs());
+    std::iota(order.begin(), order.end(), 0);
+    std::vector<int> totals(order.size(), 0);
+    for (int job : order) {
+        for (int machine = 0; machine < neh_instance->getNumMachines(); ++machine) {
+            totals[job] += neh_instance->getProcessingTime(job, machine);
+        }
+    }
+    std::stable_sort(order.begin(), order.end(), [&totals](int a, int b) { return totals[a] > totals[b]; });
+    std::vector<int> naive;
+    for (int job : order) {
+        int best_position = 0;
+        int best_makespan = std::numeric_limits<int>::max();
+        for (int k = 0; k <= static_cast<int>(naive.size()); ++k) {
+            std::vector<int> trial = naive;
+            trial.insert(trial.begin() + k, job);
+            int makespan = MakespanKernels::generic().makespan(*neh_instance, trial.data(), trial.size());
+            if (makespan < best_makespan) {
+                best_makespan = makespan;
+                best_position = k;
+            }
+        }
+        naive.insert(naive.begin() + best_position, job);
+    }
+    
+    Solution neh(neh_instance);
+    neh.initializeNEH();
+    assert(neh.isValid());
+    assert(neh.getJobSequence() == naive);
+    assert(neh.getMakespan() == Solution(naive, neh_instance).getMakespan());
+    
+    Solution spt(neh_instance);
+    spt.initializeGreedy();
+    assert(neh.getMakespan() <= spt.getMakespan());
+    
+    for (double perturbation : {0.0, 0.2, 1.0}) {
+        Solution randomized(neh_instance);
+        randomized.initializeRandomizedNEH(perturbation);
+        assert(randomized.isValid());
+        assert(randomized.getMakespan() == Solution(randomized.getJobSequence(), neh_instance).getMakespan());
+    }
+    bool rejected = false;
+    try {
+        neh.initializeRandomizedNEH(1.5);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    assert(rejected);
+    
+    std::cout << "InsertionEvaluator tests passed!" << std::endl;
+}
+
+void testIteratedGreedy() {
+    std::cout << "Testing iterated-greedy grazing..." << std::endl;
+    
+    // Chunked sweeps give the same makespans and position as a single sweep
+    auto large = ProblemInstance::generateRandom(300, 10, 1, 99);
+    Solution random_order(large);
+    random_order.initializeRandom();
+    std::vector<int> partial(random_order.getJobSequence().begin() + 1, random_order.getJobSequence().end());
+    int job = random_order.getJobSequence()[0];
+    
+    InsertionEvaluator evaluator(large);
+    ThreadPool pool(4);
+    std::vector<int> single;
+    std::vector<int> chunked;
+    int single_best = evaluator.evaluateInsertions(partial, job, single);
+    int chunked_best = evaluator.evaluateInsertions(partial, job, chunked, &pool);
+    assert(single == chunked && single_best == chunked_best);
+    assert(single[single_best] == *std::min_element(single.begin(), single.end()));
+    
+    // A destruction-reconstruction step never worsens and keeps a permutation
+    auto instance = ProblemInstance::generateRandom(20, 5, 1, 99);
+    Solution solution(instance);
+    solution.initializeRandom();
+    for (int step = 0; step < 50; ++step) {
+        int before = solution.getMakespan();
+        bool improved = solution.applyIteratedGreedy(4);
+        assert(solution.isValid());
+        assert(solution.getMakespan() == Solution(solution.getJobSequence(), instance).getMakespan());
+        assert(improved ? solution.getMakespan() < before : solution.getMakespan() == before);
+    }
+    Solution tiny(ProblemInstance::generateRandom(1, 3, 1, 9));
+    assert(!tiny.applyIteratedGreedy(4));
+    
+    // The herd's results do not depend on how the sweeps are parallelized
+    HHOAParameters params;
+    params.population_size = 8;
+    params.max_iterations = 30;
+    params.grazing_mode = GrazingMode::ITERATED_GREEDY;
+    params.destruction_size = 3;
+    auto medium = ProblemInstance::generateRandom(150, 5, 1, 99);
+    std::vector<std::vector<int>> sequences;
+    for (int threads : {1, 3}) {
+        for (int chunk_jobs : {0, 1}) {
+            params.num_threads = threads;
+            params.parallel_reinsertion_jobs = chunk_jobs;
+            Random::getInstance().setSeed(31);
+            HHOA hhoa(medium, params);
+            sequences.push_back(hhoa.optimize().getJobSequence());
+        }
+    }
+    for (const auto& sequence : sequences) {
+        assert(sequence == sequences[0]);
+    }
+    
+    params.destruction_size = 0;
+    assert(!params.isValid());
+    Random::getInstance().setSeed(42);
+    
+    std::cout << "Iterated-greedy grazing tests passed!" << std::endl;
+}
+
+void testMakespanEvaluator() {
+    std::cout << "Testing MakespanEvaluator..." << std::endl;
+    
+    auto instance = ProblemInstance::generateRandom(15, 7, 1, 99);
+    MakespanEvaluator evaluator(instance);
+    
+    // Use a count that is not a multiple of the lane width
+    std::vector<std::vector<int>> sequences;
+    for (int i = 0; i < 2 * MakespanEvaluator::kLanes + 3; ++i) {
+        sequences.push_back(Random::getInstance().randPermutation(instance->getNumJobs()));
+    }
+    
+    std::vector<int> makespans;
+    evaluator.evaluate(sequences, makespans);
+    assert(makespans.size() == sequences.size());
+    for (size_t i = 0; i < sequences.size(); ++i) {
+        assert(makespans[i] == Solution(sequences[i], instance).getMakespan());
+    }
+    
+    std::vector<Solution> solutions;
+    for (const auto& sequence : sequences) {
+        solutions.emplace_back(sequence, instance);
+    }
+    evaluator.evaluate(solutions);
+    for (size_t i = 0; i < solutions.size(); ++i) {
+        assert(solutions[i].getMakespan() == makespans[i]);
+    }
+    
+    // Fingerprint cache: repeated permutations are answered without evaluation
+    EvaluationCache cache(64);
+    evaluator.setCache(&cache);
+    std::vector<Solution> repeated;
+    for (int i = 0; i < 4; ++i) {
+        repeated.emplace_back(sequences[0], instance);
+    }
+    evaluator.evaluate(repeated);
+    assert(cache.getMisses() == 4 && cache.getHits() == 0);
+    repeated.assign(3, Solution(sequences[0], instance));
+    evaluator.evaluate(repeated);
+    assert(cache.getHits() == 3);
+    for (const auto& solution : repeated) {
+        assert(solution.getMakespan() == makespans[0]);
+    }
+    
+    std::cout << "MakespanEvaluator tests passed!" << std::endl;
+}
+
+void testObjectives() {
+    std::cout << "Testing objectives..." << std::endl;
+    
+    auto instance = ProblemInstance::generateRandom(9, 4, 1, 20);
+    instance->generateRandomSetupTimes(1, 15);
+    int num_jobs = instance->getNumJobs();
+    int num_machines = instance->getNumMachines();
+    
+    // Reference schedules straight from the definitions
+    auto reference = [&](ObjectiveType objective, const std::vector<int>& sequence) {
+        std::vector<int> row(num_machines, 0);
+        int flowtime = 0;
+        int start = 0;
+        for (size_t pos = 0; pos < sequence.size(); ++pos) {
+            int job = sequence[pos];
+            int previous = pos > 0 ? sequence[pos - 1] : -1;
+            if (objective == ObjectiveType::NO_WAIT_MAKESPAN) {
+                // Smallest start that finds every machine free
+                for (bool conflict = true; conflict;) {
+                    conflict = false;
+                    int time = start;
+                    for (int machine = 0; machine < num_machines && !conflict; ++machine) {
+                        conflict = time < row[machine];
+                        time += instance->getProcessingTime(job, machine);
+                    }
+                    start += conflict;
+                }
+                int time = start;
+                for (int machine = 0; machine < num_machines; ++machine) {
+                    time += instance->getProcessingTime(job, machine);
+                    row[machine] = time;
+                }
+            } else {
+                int ready = 0;
+                for (int machine = 0; machine < num_machines; ++machine) {
+                    int setup = objective == ObjectiveType::SDST_MAKESPAN
+                                    ? instance->getSetupTime(machine, previous, job) : 0;
+                    ready = std::max(ready, row[machine] + setup) + instance->getProcessingTime(job, machine);
+                    row[machine] = ready;
+                }
+            }
+            flowtime += row[num_machines - 1];
+        }
+        return objective == ObjectiveType::TOTAL_FLOWTIME ? flowtime : row[num_machines - 1];
+    };
+    
+    bool threw = false;
+    try {
+        ProblemInstance(*ProblemInstance::generateRandom(4, 2)).setObjective(ObjectiveType::SDST_MAKESPAN);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    // A flowtime that could leave the int range is rejected up front
+    ProblemInstance heavy({{INT_MAX / 4, 1}, {INT_MAX / 4, 1}});
+    threw = false;
+    try {
+        heavy.setObjective(ObjectiveType::TOTAL_FLOWTIME);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && heavy.getObjective() == ObjectiveType::MAKESPAN);
+    ProblemInstance light({{INT_MAX / 8, 1}, {1, 1}});
+    light.setObjective(ObjectiveType::TOTAL_FLOWTIME);
+    light.setProcessingTime(1, 0, INT_MAX / 4);
+    threw = false;
+    try {
+        light.setProcessingTime(1, 0, INT_MAX / 2);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw && light.getProcessingTime(1, 0) == INT_MAX / 4);
+    
+    std::uint64_t makespan_checksum = instance->getChecksum();
+    InsertionEvaluator evaluator(instance);
+    MakespanEvaluator batch(instance);
+    for (ObjectiveType objective : {ObjectiveType::MAKESPAN, ObjectiveType::TOTAL_FLOWTIME,
+                                    ObjectiveType::SDST_MAKESPAN, ObjectiveType::NO_WAIT_MAKESPAN}) {
+        instance->setObjective(objective);
+        assert(objective == ObjectiveType::MAKESPAN || instance->getChecksum() != makespan_checksum);
+        ObjectiveType parsed;
+        assert(parseObjective(objectiveName(objective), parsed) && parsed == objective);
+        
+        std::vector<std::vector<int>> sequences;
+        for (int trial = 0; trial < 20; ++trial) {
+            std::vector<int> sequence = Random::getInstance().randPermutation(num_jobs);
+            sequences.push_back(sequence);
+            Solution solution(sequence, instance);
+            int value = solution.getMakespan();
+            assert(value == reference(objective, sequence));
+            assert(value == evaluateObjective(*instance, sequence.data(), num_jobs));
+            assert(value >= instance->getLowerBound());
+            if (objective != ObjectiveType::TOTAL_FLOWTIME) {
+                assert(solution.getCompletionTime(num_jobs - 1, num_machines - 1) == value);
+            }
+            
+            // Swaps and moves scored without applying them, resumed from the completion times
+            Solution modified(solution);
+            int pos1 = Random::getInstance().randInt(0, num_jobs - 1);
+            int pos2 = Random::getInstance().randInt(0, num_jobs - 1);
+            int swapped = solution.evaluateSwap(pos1, pos2);
+            int moved = solution.evaluateMove(pos1, pos2);
+            modified.swapJobs(pos1, pos2);
+            assert(swapped == reference(objective, modified.getJobSequence()));
+            modified = solution;
+            modified.moveJob(pos1, pos2);
+            assert(moved == reference(objective, modified.getJobSequence()));
+            assert(solution.evaluateMove(pos1, pos2, moved) >= moved);
+            
+            // Every insertion position of the objective's sweep
+            std::vector<int> partial(sequence.begin() + 1, sequence.end());
+            std::vector<int> values;
+            int best = evaluator.evaluateInsertions(partial, sequence[0], values);
+            for (size_t pos = 0; pos <= partial.size(); ++pos) {
+                std::vector<int> inserted = partial;
+                inserted.insert(inserted.begin() + pos, sequence[0]);
+                assert(values[pos] == reference(objective, inserted));
+            }
+            assert(best == std::min_element(values.begin(), values.end()) - values.begin());
+        }
+        
+        std::vector<int> values;
+        batch.evaluate(sequences, values);
+        for (size_t i = 0; i < sequences.size(); ++i) {
+            assert(values[i] == reference(objective, sequences[i]));
+        }
+        
+        // Local search and a short run stay consistent with the objective
+        Solution searched(instance);
+        searched.initializeNEH();
+        assert(searched.getMakespan() == reference(objective, searched.getJobSequence()));
+        searched.applyInsertionSearch();
+        searched.apply2Opt();
+        searched.applyIteratedGreedy(3);
+        assert(searched.getMakespan() == reference(objective, searched.getJobSequence()));
+        
+        HHOAParameters params;
+        params.population_size = 6;
+        params.max_iterations = 10;
+        HHOA hhoa(instance, params);
+        Solution best = hhoa.optimize();
+        assert(best.isValid() && best.getMakespan() == reference(objective, best.getJobSequence()));
+    }
+    
+    // No-wait delays follow processing time changes
+    instance->setObjective(ObjectiveType::NO_WAIT_MAKESPAN);
+    instance->setProcessingTime(3, 2, 40);
+    std::vector<int> order = Random::getInstance().randPermutation(num_jobs);
+    assert(Solution(order, instance).getMakespan() == reference(ObjectiveType::NO_WAIT_MAKESPAN, order));
+    
+    // Setup times and the objective survive a binary round trip, mapped in place
+    instance->setObjective(ObjectiveType::SDST_MAKESPAN);
+    std::string binary_file = (std::filesystem::temp_directory_path() / "hhoa_objective_test.bin").string();
+    assert(instance->saveToFile(binary_file, InstanceFormat::BINARY));
+    auto mapped = ProblemInstance::loadFromFile(binary_file);
+    assert(mapped && mapped->isMapped() && mapped->hasSetupTimes());
+    assert(mapped->getObjective() == ObjectiveType::SDST_MAKESPAN);
+    assert(mapped->hasSameData(*instance) && mapped->getChecksum() == instance->getChecksum());
+    assert(reinterpret_cast<uintptr_t>(mapped->getSetupTimes(0, 0)) % 64 == 0);
+    assert(Solution(order, mapped).getMakespan() == reference(ObjectiveType::SDST_MAKESPAN, order));
+    
+    // Edits copy the mapped setups first
+    ProblemInstance copy(*mapped);
+    copy.setSetupTime(1, 2, 3, 0);
+    assert(!copy.isMapped() && copy.getSetupTime(1, 2, 3) == 0 && !copy.hasSameData(*mapped));
+    assert(copy.getSetupTime(0, -1, 4) == mapped->getSetupTime(0, -1, 4));
+    std::filesystem::remove(binary_file);
+    
+    std::cout << "Objective tests passed!" << std::endl;
+}
+
+void testPopulationArena() {
+    std::cout << "Testing PopulationArena..." << std::endl;
+    
+    auto instance = ProblemInstance::generateRandom(6, 3, 1, 20);
+    std::vector<Horse> horses;
+    for (int i = 0; i < 5; ++i) {
+        horses.emplace_back(instance);
+    }
+    
+    PopulationArena arena;
+    arena.gatherScalars(horses);
+    arena.gatherSequences(horses);
+    assert(arena.getNumHorses() == 5);
+    assert(arena.getNumJobs() == 6);
+    
+    for (int i = 0; i < 5; ++i) {
+        assert(arena.getMakespan(i) == horses[i].getMakespan());
+        assert(std::equal(horses[i].getSolution().getJobSequence().begin(),
+                          horses[i].getSolution().getJobSequence().end(),
+                          arena.getCurrentSequence(i)));
+        assert(arena.hammingDistance(i, i) == 0);
+        assert(arena.hammingDistance(0, i) == horses[0].getSolution().distanceTo(horses[i].getSolution()));
+    }
+    
+    // Rankings are index lists ordered by fitness
+    std::vector<int> ranking = arena.rankByFitness();
+    for (size_t r = 1; r < ranking.size(); ++r) {
+        assert(arena.getFitness(ranking[r - 1]) >= arena.getFitness(ranking[r]));
+    }
+    const std::vector<int>& worst = arena.selectWorst(2);
+    assert(worst.size() == 2u);
+    for (int i = 0; i < 5; ++i) {
+        assert(arena.getBestFitness(worst[0]) <= arena.getBestFitness(i));
+    }
+    
+    // Incremental histogram: only changed horses are re-gathered, entropy matches a rebuild
+    assert(arena.gatherSequences(horses) == 0);
+    double entropy = arena.positionEntropy();
+    assert(entropy > 0.0 && entropy <= 1.0);
+    horses[2].setSolution(horses[0].getSolution().createSwapNeighbor());
+    assert(arena.gatherSequences(horses) == 1);
+    PopulationArena rebuilt;
+    rebuilt.gatherSequences(horses);
+    assert(std::abs(arena.positionEntropy() - rebuilt.positionEntropy()) < 1e-9);
+    for (int position = 0; position < 6; ++position) {
+        int total = 0;
+        for (int job = 0; job < 6; ++job) {
+            total += arena.getPositionCount(position, job);
+            assert(arena.getPositionCount(position, job) == rebuilt.getPositionCount(position, job));
+        }
+        assert(total == 5);
+    }
+    
+    // Identical horses have no diversity under either metric
+    std::vector<Horse> clones(4, horses[0]);
+    PopulationArena clone_arena;
+    clone_arena.gatherSequences(clones);
+    assert(clone_arena.positionEntropy() == 0.0);
+    assert(clone_arena.hammingDistance(1, 3) == 0);
+    
+    std::cout << "PopulationArena tests passed!" << std::endl;
+}
+
 void testHHOA() {
     std::cout << "Testing HHOA..." << std::endl;
     
@@ -62,10 +685,760 @@ void testHHOA() {
     assert(best.isValid());
     assert(best.getMakespan() > 0);
     
+    const HHOAStatistics& stats = algorithm.getStatistics();
+    assert(stats.lower_bound == instance->getLowerBound());
+    assert(stats.best_makespan == best.getMakespan() && stats.best_makespan >= stats.lower_bound);
+    assert(stats.optimal == (stats.best_makespan == stats.lower_bound));
+    assert(stats.getOptimalityGap() >= 0.0);
+    
+    // On one machine every sequence meets the bound: no iteration is needed
+    auto single = ProblemInstance::generateRandom(8, 1, 1, 20);
+    HHOA single_algorithm(single, params);
+    Solution single_best = single_algorithm.optimize();
+    assert(single_best.getMakespan() == single->getLowerBound());
+    assert(single_algorithm.getStatistics().optimal);
+    assert(single_algorithm.getStatistics().iterations_executed == 0);
+    assert(single_algorithm.getStatistics().getOptimalityGap() == 0.0);
+    
     std::cout << "Best makespan: " << best.getMakespan() << std::endl;
     std::cout << "HHOA tests passed!" << std::endl;
 }
 
+void testLogger() {
+    std::cout << "Testing Logger..." << std::endl;
+    
+    // Concurrent producers: every pushed value is popped exactly once
+    MpmcQueue<int> queue(1000);
+    assert(queue.capacity() == 1024);
+    std::vector<std::thread> producers;
+    for (int p = 0; p < 4; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < 256; ++i) {
+                while (!queue.tryPush(p * 256 + i)) {}
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    assert(!queue.tryPush(-1));
+    std::vector<char> seen(1024, 0);
+    int value = 0;
+    while (queue.tryPop(value)) {
+        assert(!seen[value]);
+        seen[value] = 1;
+    }
+    assert(std::count(seen.begin(), seen.end(), 1) == 1024);
+    assert(queue.empty());
+    
+    // Messages reach the file once flushed; disabled levels are filtered before formatting
+    Logger& logger = Logger::getInstance();
+    std::string log_file = (std::filesystem::temp_directory_path() / "hhoa_logger_test.txt").string();
+    std::filesystem::remove(log_file);
+    assert(logger.initialize(log_file, LogLevel::INFO, false));
+    assert(logger.isEnabled(LogLevel::WARNING));
+    assert(!logger.isEnabled(LogLevel::DEBUG));
+    
+    int formatted = 0;
+    auto message = [&formatted](const std::string& text) {
+        formatted++;
+        return text;
+    };
+    LOG_DEBUG(message("hidden message"));
+    LOG_WARNING(message("visible message"));
+    LOG_STREAM(LogLevel::DEBUG) << message("hidden stream");
+    LOG_STREAM(LogLevel::INFO) << "stream " << 42;
+    assert(formatted == 1);
+    logger.flush();
+    
+    std::ifstream in(log_file);
+    std::string content((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    assert(content.find("[WARN ] visible message") != std::string::npos);
+    assert(content.find("[INFO ] stream 42") != std::string::npos);
+    assert(content.find("hidden") == std::string::npos);
+    
+    logger.close();
+    logger.setConsoleOutput(true);
+    std::filesystem::remove(log_file);
+    
+    std::cout << "Logger tests passed!" << std::endl;
+}
+
+void testProfiling() {
+    std::cout << "Testing phase profiling..." << std::endl;
+    
+    if (!Profiler::isEnabled()) {
+        std::cout << "Profiling not compiled in, skipped" << std::endl;
+        return;
+    }
+    
+    auto instance = ProblemInstance::generateRandom(12, 5, 1, 50);
+    
+    HHOAParameters params;
+    params.population_size = 12;
+    params.max_iterations = 20;
+    params.record_trace = true;
+    params.stop_at_lower_bound = false;  // The NEH start is often optimal on an instance this small
+    
+    // Evaluations run on pool workers are attributed to the herd as well
+    std::vector<long long> evaluations;
+    for (int threads : {1, 3}) {
+        params.num_threads = threads;
+        Random::getInstance().setSeed(11);
+        HHOA algorithm(instance, params);
+        algorithm.optimize();
+        
+        const HHOAStatistics& stats = algorithm.getStatistics();
+        long long phase_calls = 0;
+        long long phase_evaluations = 0;
+        for (const PhaseProfile& phase : stats.phases) {
+            assert(phase.accepted <= phase.attempts);
+            assert(phase.nanoseconds >= 0);
+            phase_calls += phase.calls;
+            phase_evaluations += phase.evaluations;
+        }
+        
+        const PhaseProfile& grazing = stats.phases[static_cast<int>(HHOAPhase::GRAZING)];
+        assert(grazing.calls >= stats.iterations_executed);
+        assert(grazing.attempts == grazing.calls * params.population_size);
+        assert(grazing.evaluations > 0);
+        assert(stats.phases[static_cast<int>(HHOAPhase::AGING)].evaluations == 0);
+        assert(phase_evaluations > 0 && phase_evaluations < stats.evaluations);
+        assert(static_cast<long long>(algorithm.getTrace().size()) == phase_calls);
+        evaluations.push_back(stats.evaluations);
+        
+        if (threads == 1) {
+            std::string stats_file = (std::filesystem::temp_directory_path() / "hhoa_profile_stats.csv").string();
+            std::string trace_file = (std::filesystem::temp_directory_path() / "hhoa_profile_trace.json").string();
+            assert(stats.saveToFile(stats_file));
+            assert(algorithm.saveTrace(trace_file));
+            
+            std::ifstream stats_in(stats_file);
+            std::string content((std::istreambuf_iterator<char>(stats_in)), std::istreambuf_iterator<char>());
+            assert(content.find("Phase,Calls,TimeNs,Evaluations,Attempts,Accepted,AcceptRate") != std::string::npos);
+            assert(content.find("\nGrazing,") != std::string::npos);
+            
+            std::ifstream trace_in(trace_file);
+            std::string trace((std::istreambuf_iterator<char>(trace_in)), std::istreambuf_iterator<char>());
+            assert(trace.find("\"traceEvents\"") != std::string::npos);
+            assert(trace.find("\"name\": \"Mating\", \"cat\": \"phase\", \"ph\": \"X\"") != std::string::npos);
+            
+            std::filesystem::remove(stats_file);
+            std::filesystem::remove(trace_file);
+        }
+    }
+    assert(evaluations[0] == evaluations[1]);
+    
+    std::cout << "Evaluations per run: " << evaluations[0] << std::endl;
+    std::cout << "Phase profiling tests passed!" << std::endl;
+}
+
+void testSearchBudget() {
+    std::cout << "Testing search budgets..." << std::endl;
+    
+    // Charges are published in blocks and latch the budget
+    SearchBudget budget;
+    budget.start(0.0, 1000);
+    assert(budget.isLimited() && !budget.isExhausted());
+    {
+        SearchBudget::Binding binding(&budget);
+        assert(SearchBudget::current() == &budget);
+        for (int i = 0; i < 999; ++i) {
+            SearchBudget::charge(1);
+        }
+        assert(!SearchBudget::isCurrentExhausted());
+        SearchBudget::charge(1);
+    }
+    assert(SearchBudget::current() == nullptr);
+    assert(budget.getEvaluations() == 1000 && budget.isExhausted() && budget.wasExhausted());
+    
+    // A local search stops at an exhausted budget without touching the solution
+    auto instance = ProblemInstance::generateRandom(30, 5, 1, 50);
+    Solution solution(instance);
+    solution.initializeRandom();
+    std::vector<int> before = solution.getJobSequence();
+    {
+        SearchBudget::Binding binding(&budget);
+        assert(!solution.apply2Opt() && !solution.applyInsertionSearch());
+    }
+    assert(solution.getJobSequence() == before);
+    
+    HHOAParameters params;
+    params.population_size = 20;
+    params.max_iterations = 1000000;
+    params.termination_patience = 1000000;
+    params.stop_at_lower_bound = false;
+    
+    // Wall clock: the deadline holds even when a single iteration is long
+    auto large = ProblemInstance::generateRandom(200, 10, 1, 99);
+    params.time_limit_ms = 60.0;
+    params.random_ratio = 1.0;  // The constructive start is not interruptible (and slow in sanitizer builds)
+    auto start = std::chrono::steady_clock::now();
+    HHOA timed(large, params);
+    Solution timed_best = timed.optimize();
+    double elapsed_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    assert(timed_best.isValid());
+    assert(timed.getStatistics().budget_exhausted);
+    assert(elapsed_ms < params.time_limit_ms + 30.0);
+    
+    // Evaluations: overshoot bounded by one publication block and one sweep
+    params.time_limit_ms = 0.0;
+    params.random_ratio = 0.8;
+    params.max_evaluations = 20000;
+    HHOA counted(instance, params);
+    Solution counted_best = counted.optimize();
+    assert(counted_best.isValid());
+    assert(counted.getStatistics().budget_exhausted);
+    assert(counted.getStatistics().iterations_executed < params.max_iterations);
+    if (Profiler::isEnabled()) {
+        long long evaluations = counted.getStatistics().evaluations;
+        assert(evaluations >= params.max_evaluations);
+        assert(evaluations < params.max_evaluations + SearchBudget::kCheckInterval + 2 * instance->getNumJobs());
+    }
+    
+    std::cout << "Search budget tests passed!" << std::endl;
+}
+
+void testSolveAsync() {
+    std::cout << "Testing asynchronous solves..." << std::endl;
+    
+    auto instance = ProblemInstance::generateRandom(60, 8, 1, 99);
+    HHOAParameters params;
+    params.population_size = 12;
+    params.max_iterations = 1000000;
+    params.termination_patience = 1000000;
+    params.stop_at_lower_bound = false;
+    
+    // Stream improvements while the solve runs, then cancel it
+    HHOA algorithm(instance, params);
+    SolveHandle handle = algorithm.solveAsync(4);
+    while (!handle.currentBest()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    assert(!handle.isDone());
+    
+    auto cancelled_at = std::chrono::steady_clock::now();
+    handle.cancel();
+    Solution best = handle.getFuture().get();
+    double cancel_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - cancelled_at).count();
+    assert(cancel_ms < 50.0);
+    assert(handle.isDone() && best.isValid());
+    assert(handle.currentBest()->getMakespan() == best.getMakespan());
+    assert(!algorithm.getStatistics().budget_exhausted);
+    
+    // The queue keeps the newest improvements, in order
+    std::vector<SolveImprovement> improvements;
+    SolveImprovement improvement;
+    while (handle.pollImprovement(improvement)) {
+        improvements.push_back(improvement);
+    }
+    assert(!improvements.empty() && improvements.size() <= 4);
+    for (size_t i = 1; i < improvements.size(); ++i) {
+        assert(improvements[i].makespan < improvements[i - 1].makespan);
+        assert(improvements[i].iteration > improvements[i - 1].iteration);
+    }
+    assert(improvements.back().makespan == best.getMakespan());
+    assert(Solution(improvements.back().job_sequence, instance).getMakespan() == best.getMakespan());
+    assert(handle.getDroppedImprovements() + static_cast<long long>(improvements.size()) ==
+           algorithm.getStatistics().total_improvements + 1);
+    
+    // Concurrent solves in one process; a dropped handle cancels its solve
+    params.max_iterations = 30;
+    HHOA first(instance, params);
+    HHOA second(instance, params);
+    HHOAParameters long_params = params;
+    long_params.max_iterations = 1000000;
+    HHOA abandoned(instance, long_params);
+    SolveHandle first_handle = first.solveAsync();
+    SolveHandle second_handle = second.solveAsync();
+    {
+        SolveHandle abandoned_handle = abandoned.solveAsync();
+    }
+    assert(abandoned.isStopRequested());
+    assert(first_handle.getFuture().get().isValid());
+    assert(second_handle.getFuture().get().isValid());
+    
+    // The user's improvement callback survives a solve, and the handle stops listening once it ends
+    HHOA chained(instance, params);
+    int callback_calls = 0;
+    chained.setImprovementCallback([&callback_calls](int, const Solution&) { ++callback_calls; });
+    SolveHandle chained_handle = chained.solveAsync();
+    chained_handle.getFuture().get();
+    int solve_calls = callback_calls;
+    assert(solve_calls == chained.getStatistics().total_improvements + 1);
+    while (chained_handle.pollImprovement(improvement)) {
+    }
+    chained.optimize();
+    assert(callback_calls > solve_calls && !chained_handle.pollImprovement(improvement));
+    
+    // A cancelled solve does not stop the next one
+    abandoned.setParameters(params);
+    SolveHandle again = abandoned.solveAsync();
+    assert(again.getFuture().get().isValid());
+    assert(abandoned.getStatistics().iterations_executed > 0);
+    
+    std::cout << "Asynchronous solve tests passed!" << std::endl;
+}
+
+void testStatisticsHistory() {
+    std::cout << "Testing statistics history..." << std::endl;
+    
+    // The ring keeps the newest records, oldest first
+    IterationHistory ring(3);
+    for (int i = 0; i < 5; ++i) {
+        ring.push(IterationRecord{i, 100 - i, 0.5, -100.0 + i});
+    }
+    assert(ring.size() == 3 && ring[0].iteration == 2 && ring.back().iteration == 4);
+    assert(ring.toVector()[1].best_makespan == 97);
+    
+    auto instance = ProblemInstance::generateRandom(20, 5, 1, 99);
+    std::string path = (std::filesystem::temp_directory_path() / "hhoa_test_history.csv").string();
+    HHOAParameters params;
+    params.population_size = 8;
+    params.max_iterations = 40;
+    params.termination_patience = 1000;
+    params.stop_at_lower_bound = false;
+    params.history_interval = 5;
+    params.history_capacity = 4;
+    params.history_file = path;
+    
+    // Every 5th iteration: all of them streamed, the newest 4 kept in memory
+    HHOA sampled(instance, params);
+    sampled.optimize();
+    const IterationHistory& history = sampled.getStatistics().history;
+    assert(history.size() == 4 && history[0].iteration == 20 && history.back().iteration == 35);
+    
+    std::ifstream file(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(file, line);) {
+        lines.push_back(line);
+    }
+    assert(lines.size() == 9 && lines[0] == IterationHistory::csvHeader());
+    assert(lines[1].rfind("0,", 0) == 0 && lines[8].rfind("35,", 0) == 0);
+    std::string last_row;
+    IterationHistory::appendCsvRow(history.back(), last_row);
+    assert(lines[8] + "\n" == last_row);
+    std::filesystem::remove(path);
+    
+    // Improvements only: strictly better makespans, starting with the first iteration
+    params.history_interval = 0;
+    params.history_capacity = 0;
+    params.history_file.clear();
+    HHOA improving(instance, params);
+    improving.optimize();
+    const IterationHistory& improvements = improving.getStatistics().history;
+    assert(!improvements.empty() && improvements[0].iteration == 0);
+    for (size_t i = 1; i < improvements.size(); ++i) {
+        assert(improvements[i].best_makespan < improvements[i - 1].best_makespan);
+    }
+    assert(improvements.back().best_makespan == improving.getBestMakespan());
+    
+    std::cout << "Statistics history tests passed!" << std::endl;
+}
+
+void testOperatorSelection() {
+    std::cout << "Testing operator selection..." << std::endl;
+    
+    // Probability matching: the productive arm gets the rest of the budget
+    OperatorSelector selector(0.5, 0.05);
+    for (const OperatorCredit& credit : selector.getCredits()) {
+        assert(std::abs(credit.share - 0.2) < 1e-12);
+    }
+    for (int arm = 0; arm < OperatorSelector::kNumOperators; ++arm) {
+        assert(selector.select(arm));  // Unmeasured arms always run
+        selector.update(arm, arm == 0 ? 5 : 0, 10);
+    }
+    selector.beginIteration();
+    assert(std::abs(selector.getCredits()[0].credit - 0.5) < 1e-12);
+    assert(std::abs(selector.getCredits()[0].share - 0.8) < 1e-12);
+    assert(std::abs(selector.getCredits()[3].share - 0.05) < 1e-12);
+    selector.update(0, 0, 10);
+    assert(std::abs(selector.getCredits()[0].credit - 0.25) < 1e-12);
+    selector.update(0, 3, 0);  // Nothing tried: no information
+    assert(std::abs(selector.getCredits()[0].credit - 0.25) < 1e-12);
+    
+    bool threw = false;
+    try {
+        OperatorSelector invalid(0.5, 0.3);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    auto instance = ProblemInstance::generateRandom(25, 5, 1, 99);
+    HHOAParameters params;
+    params.population_size = 10;
+    params.max_iterations = 60;
+    params.termination_patience = 1000;
+    params.stop_at_lower_bound = false;
+    params.operator_selection = true;
+    
+    Random::getInstance().setSeed(77);
+    HHOA hhoa(instance, params);
+    Solution best = hhoa.optimize();
+    const HHOAStatistics& stats = hhoa.getStatistics();
+    long long skips = 0;
+    for (const OperatorCredit& credit : stats.operators) {
+        // Every iteration either ran or skipped each operator
+        assert(credit.runs + credit.skips == 60);
+        assert(credit.accepted <= credit.attempts);
+        skips += credit.skips;
+    }
+    assert(skips > 0);
+    
+    // Seeded runs reproduce, including from a checkpoint
+    std::string path = (std::filesystem::temp_directory_path() / "hhoa_test_selection.ckpt").string();
+    HHOAParameters checkpointed = params;
+    checkpointed.checkpoint_file = path;
+    checkpointed.checkpoint_interval = 25;
+    Random::getInstance().setSeed(77);
+    HHOA full(instance, checkpointed);
+    assert(full.optimize().getJobSequence() == best.getJobSequence());
+    
+    HHOA resumed(instance, params);
+    Solution resumed_best = resumed.resume(path);
+    assert(resumed_best.getJobSequence() == best.getJobSequence());
+    for (int arm = 0; arm < OperatorSelector::kNumOperators; ++arm) {
+        assert(resumed.getStatistics().operators[arm].runs == stats.operators[arm].runs);
+        assert(resumed.getStatistics().operators[arm].credit == stats.operators[arm].credit);
+    }
+    std::filesystem::remove(path);
+    
+    // Off by default: the fixed schedule records no credit
+    params.operator_selection = false;
+    HHOA fixed(instance, params);
+    fixed.optimize();
+    assert(fixed.getStatistics().operators[0].runs == 0);
+    
+    std::cout << "Operator selection tests passed!" << std::endl;
+}
+
+void testCheckpoint() {
+    std::cout << "Testing checkpoint and resume..." << std::endl;
+    
+    auto instance = ProblemInstance::generateRandom(30, 6, 1, 99);
+    std::string path = (std::filesystem::temp_directory_path() / "hhoa_test_checkpoint.ckpt").string();
+    HHOAParameters params;
+    params.population_size = 10;
+    params.max_iterations = 50;
+    params.termination_patience = 1000;
+    params.stop_at_lower_bound = false;
+    
+    // Uninterrupted run, checkpointed once at iteration 30
+    HHOAParameters checkpointed = params;
+    checkpointed.checkpoint_file = path;
+    checkpointed.checkpoint_interval = 30;
+    Random::getInstance().setSeed(123);
+    HHOA full(instance, checkpointed);
+    Solution full_best = full.optimize();
+    const HHOAStatistics& full_stats = full.getStatistics();
+    assert(full_stats.checkpoints_written == 1);
+    
+    auto checkpoint = HHOACheckpoint::load(path);
+    assert(checkpoint);
+    assert(checkpoint->next_iteration == 30 && checkpoint->end_iteration == 50);
+    assert(checkpoint->herd.horses.size() == 10 && checkpoint->statistics.history.size() == 30);
+    
+    // Resuming from another generator state continues the run exactly
+    Random::getInstance().setSeed(999);
+    HHOA resumed(instance, params);
+    Solution resumed_best = resumed.resume(path);
+    const HHOAStatistics& resumed_stats = resumed.getStatistics();
+    assert(resumed_best.getJobSequence() == full_best.getJobSequence());
+    assert(resumed_stats.history.toVector() == full_stats.history.toVector());
+    assert(resumed_stats.iterations_executed == full_stats.iterations_executed);
+    assert(resumed_stats.total_improvements == full_stats.total_improvements);
+    assert(resumed_stats.leader_changes == full_stats.leader_changes);
+    assert(resumed_stats.replacements == full_stats.replacements);
+    assert(resumed.getParameters().mutation_rate == full.getParameters().mutation_rate);
+    assert(resumed_stats.checkpoints_written == 0);
+    
+    // A stopped run leaves a checkpoint at the stop
+    Random::getInstance().setSeed(123);
+    checkpointed.checkpoint_interval = 1000;
+    HHOA stopped(instance, checkpointed);
+    stopped.setIterationCallback([&stopped](int iteration, const Solution&, const HHOAStatistics&) {
+        if (iteration == 5) {
+            stopped.requestStop();
+        }
+    });
+    stopped.optimize();
+    assert(stopped.getStatistics().checkpoints_written == 1);
+    assert(HHOACheckpoint::load(path)->next_iteration == 6);
+    
+    // Checkpoints of other instances and damaged files are rejected
+    auto other = ProblemInstance::generateRandom(30, 6, 1, 99);
+    HHOA mismatched(other, params);
+    bool rejected = false;
+    try {
+        mismatched.resume(path);
+    } catch (const std::invalid_argument&) {
+        rejected = true;
+    }
+    assert(rejected);
+    
+    {
+        std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+        file.seekp(-1, std::ios::end);
+        file.put('\x7f');
+    }
+    assert(!HHOACheckpoint::load(path));
+    rejected = false;
+    try {
+        resumed.resume(path);
+    } catch (const std::runtime_error&) {
+        rejected = true;
+    }
+    assert(rejected);
+    std::filesystem::remove(path);
+    
+    std::cout << "Checkpoint tests passed!" << std::endl;
+}
+
+void testParallelHerd() {
+    std::cout << "Testing parallel herd phases..." << std::endl;
+    
+    auto instance = ProblemInstance::generateRandom(12, 5, 1, 50);
+    
+    HHOAParameters params;
+    params.population_size = 12;
+    params.max_iterations = 30;
+    
+    // The same seed must give the same result for any thread count
+    std::vector<std::vector<int>> results;
+    for (int threads : {1, 3, 3}) {
+        params.num_threads = threads;
+        Random::getInstance().setSeed(7);
+        HHOA algorithm(instance, params);
+        Solution best = algorithm.optimize();
+        assert(best.isValid());
+        results.push_back(best.getJobSequence());
+    }
+    assert(results[0] == results[1]);
+    assert(results[1] == results[2]);
+    
+    std::cout << "Parallel herd tests passed!" << std::endl;
+}
+
+void testIslandHHOA() {
+    std::cout << "Testing IslandHHOA..." << std::endl;
+    
+    auto instance = ProblemInstance::generateRandom(10, 4, 1, 30);
+    
+    HHOAParameters params;
+    params.population_size = 8;
+    params.max_iterations = 40;
+    params.stop_at_lower_bound = false;  // Keep migrating after an optimum is found
+    
+    IslandParameters island_params;
+    island_params.num_islands = 3;
+    island_params.migration_interval = 5;
+    island_params.seed = 11;
+    
+    IslandHHOA islands(instance, params, island_params);
+    Solution best = islands.optimize();
+    
+    assert(best.isValid());
+    assert(islands.getNumIslands() == 3);
+    for (int island = 0; island < islands.getNumIslands(); ++island) {
+        assert(best.getMakespan() <= islands.getIsland(island).getBestMakespan());
+        assert(islands.getMigrantsSent(island) > 0);
+    }
+    
+    // Snapshot of the run's best and external delivery (used by the MPI driver)
+    Migrant snapshot = islands.getBestMigrant();
+    assert(snapshot.makespan == best.getMakespan());
+    assert(Solution(snapshot.job_sequence, instance).getMakespan() == snapshot.makespan);
+    assert(islands.postExternalMigrants(1, {snapshot}));
+    
+    // A pending stop request ends the next run at its first generation
+    HHOA stopped(instance, params);
+    stopped.requestStop();
+    stopped.optimize();
+    assert(stopped.getStatistics().iterations_executed == 0);
+    stopped.reset();
+    assert(!stopped.isStopRequested());
+    
+    std::cout << "IslandHHOA tests passed!" << std::endl;
+}
+
+void testBatchRunner() {
+    std::cout << "Testing BatchRunner..." << std::endl;
+    
+    // Instance list with a relative path and a repeated file
+    std::filesystem::path directory = std::filesystem::temp_directory_path() / "hhoa_batch_test";
+    std::filesystem::create_directories(directory);
+    auto instance = ProblemInstance::generateRandom(8, 3, 1, 30);
+    assert(instance->saveToFile((directory / "small.txt").string()));
+    {
+        std::ofstream list(directory / "list.txt");
+        list << "# instance upper_bound" << std::endl;
+        list << "small.txt 200" << std::endl;
+        list << std::endl;
+        list << "small.txt" << std::endl;
+    }
+    
+    HHOAParameters params;
+    params.population_size = 6;
+    params.max_iterations = 15;
+    
+    BatchParameters batch_params;
+    batch_params.num_workers = 2;
+    batch_params.first_seed = 5;
+    batch_params.num_seeds = 2;
+    
+    BatchRunner runner(params, batch_params);
+    assert(runner.loadInstanceList((directory / "list.txt").string()) == 2);
+    assert(runner.getInstances()[0].instance == runner.getInstances()[1].instance);
+    assert(runner.getInstances()[0].upper_bound == 200);
+    assert(runner.getInstances()[1].upper_bound == -1);
+    
+    int progress_calls = 0;
+    runner.setProgressCallback([&](const BatchRun&, int completed, int total) {
+        assert(total == 4 && completed == ++progress_calls);
+    });
+    const std::vector<BatchRun>& runs = runner.run();
+    assert(runs.size() == 4u && progress_calls == 4);
+    
+    // Rows are grouped by instance, and each one reproduces a standalone seeded run
+    for (int i = 0; i < 4; ++i) {
+        assert(runs[i].completed);
+        assert(runs[i].instance_index == i / 2);
+        assert(runs[i].seed == 5u + i % 2);
+        
+        Random::getInstance().setSeed(runs[i].seed);
+        HHOA single(runner.getInstances()[runs[i].instance_index].instance, params);
+        assert(single.optimize().getMakespan() == runs[i].makespan);
+    }
+    assert(std::abs(runs[0].rpd - BatchRunner::relativePercentDeviation(runs[0].makespan, 200)) < 1e-9);
+    assert(std::abs(BatchRunner::relativePercentDeviation(210, 200) - 5.0) < 1e-9);
+    
+    assert(runner.saveCsv((directory / "results.csv").string()));
+    assert(runner.saveJson((directory / "results.json").string()));
+    std::ifstream csv(directory / "results.csv");
+    std::string line;
+    int lines = 0;
+    while (std::getline(csv, line)) {
+        lines++;
+    }
+    assert(lines == 5);
+    
+    std::filesystem::remove_all(directory);
+    Random::getInstance().setSeed(42);
+    
+    std::cout << "BatchRunner tests passed!" << std::endl;
+}
+
+void testSolverService() {
+    std::cout << "Testing SolverService..." << std::endl;
+    
+    auto first = ProblemInstance::generateRandom(12, 4, 1, 40);
+    auto second = ProblemInstance::generateRandom(9, 5, 1, 40);
+    
+    HHOAParameters params;
+    params.population_size = 8;
+    params.max_iterations = 20;
+    
+    // Reference: a fresh optimizer per seeded run
+    auto standalone = [&](std::shared_ptr<ProblemInstance> instance, std::uint64_t seed) {
+        HHOA hhoa(instance, params);
+        Random rng(seed);
+        Random::Binding binding(rng);
+        return hhoa.optimize().getMakespan();
+    };
+    
+    {
+        SolverService service(params);
+        SolveBudget budget;
+        budget.seed = 11;
+        
+        SolveResult a = service.submit(first, budget).get();
+        assert(!a.instance_cached && !a.herd_reused && a.seed == 11u);
+        assert(a.makespan == standalone(first, 11));
+        assert(Solution(a.job_sequence, first).getMakespan() == a.makespan);
+        
+        // Another instance in between must not leak into the next run
+        budget.seed = 12;
+        SolveResult b = service.submit(second, budget).get();
+        assert(b.herd_reused && b.makespan == standalone(second, 12));
+        
+        // Equal content from a different object is a cache hit, and the run reproduces
+        budget.seed = 11;
+        SolveResult c = service.submit(std::make_shared<ProblemInstance>(*first), budget).get();
+        assert(c.instance_cached && c.herd_reused);
+        assert(c.makespan == a.makespan && c.job_sequence == a.job_sequence);
+        assert(c.statistics.iterations_executed == a.statistics.iterations_executed);
+        
+        // Per-request budget
+        budget.max_iterations = 3;
+        SolveResult d = service.submit(first->getProcessingTimes(), budget).get();
+        assert(d.instance_cached && d.statistics.iterations_executed <= 3);
+        
+        SolverServiceStatistics stats = service.getStatistics();
+        assert(stats.requests_completed == 4);
+        assert(stats.instance_cache_hits == 2 && stats.instance_cache_misses == 2);
+        assert(stats.herds_created == 1 && stats.herds_reused == 3);
+    }
+    
+    // Several workers, unseeded requests and a one-entry cache
+    {
+        SolverServiceParameters service_params;
+        service_params.num_workers = 3;
+        service_params.instance_cache_size = 1;
+        SolverService service(params, service_params);
+        
+        std::vector<std::future<SolveResult>> futures;
+        for (int i = 0; i < 8; ++i) {
+            futures.push_back(service.submit(i % 2 == 0 ? first : second));
+        }
+        for (int i = 0; i < 8; ++i) {
+            SolveResult result = futures[i].get();
+            auto instance = i % 2 == 0 ? first : second;
+            assert(result.seed != 0u);
+            assert(Solution(result.job_sequence, instance).getMakespan() == result.makespan);
+            assert(result.makespan >= instance->getLowerBound());
+        }
+        SolverServiceStatistics stats = service.getStatistics();
+        assert(stats.requests_completed == 8 && stats.instance_cache_misses == 8);
+        assert(stats.herds_created + stats.herds_reused == 8 && stats.herds_created <= 3);
+    }
+    
+    // Shutdown fails the queued requests instead of running them
+    std::vector<std::future<SolveResult>> pending;
+    {
+        HHOAParameters slow = params;
+        slow.max_iterations = 100000;
+        slow.termination_patience = 100000;
+        slow.stop_at_lower_bound = false;
+        SolverService service(slow);
+        for (int i = 0; i < 4; ++i) {
+            pending.push_back(service.submit(first));
+        }
+    }
+    int stopped = 0;
+    for (auto& future : pending) {
+        try {
+            future.get();
+        } catch (const std::runtime_error&) {
+            stopped++;
+        }
+    }
+    assert(stopped >= 3);
+    
+    SolverServiceParameters invalid;
+    invalid.num_workers = 0;
+    bool threw = false;
+    try {
+        SolverService service(params, invalid);
+    } catch (const std::invalid_argument&) {
+        threw = true;
+    }
+    assert(threw);
+    
+    std::cout << "SolverService tests passed!" << std::endl;
+}
+
 int main() {
     try {
         std::cout << "Running HHOA-FSSP Tests..." << std::endl;
@@ -76,7 +1449,23 @@ int main() {
         
         testProblemInstance();
         testSolution();
+        testInsertionEvaluator();
+        testIteratedGreedy();
+        testMakespanEvaluator();
+        testObjectives();
+        testPopulationArena();
         testHHOA();
+        testSearchBudget();
+        testSolveAsync();
+        testStatisticsHistory();
+        testOperatorSelection();
+        testCheckpoint();
+        testParallelHerd();
+        testProfiling();
+        testLogger();
+        testIslandHHOA();
+        testBatchRunner();
+        testSolverService();
         
         std::cout << std::endl;
         std::cout << "All tests passed successfully!" << std::endl;